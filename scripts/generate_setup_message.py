@@ -0,0 +1,96 @@
+"""Build the static part of the Gemini Live setup message.
+
+Reads the system prompt and tool declarations from prompts/, validates and
+JSON-escapes them, and writes src/setup_message.h with the result as
+flash-resident string constants. VisionAssistant streams these straight from
+flash on every (re)connect, so the prompt is never copied into a String and
+quotes or newlines in it can't break the JSON.
+
+Runs automatically before each PlatformIO build (extra_scripts) and can also be
+run by hand: python scripts/generate_setup_message.py
+"""
+
+import json
+import os
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env["PROJECT_DIR"]  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+PROMPTS_DIR = os.path.join(PROJECT_DIR, "prompts")
+OUTPUT_PATH = os.path.join(PROJECT_DIR, "src", "setup_message.h")
+LINE_WIDTH = 100
+
+
+def read(name):
+    with open(os.path.join(PROMPTS_DIR, name), encoding="utf-8") as f:
+        return f.read()
+
+
+def c_literal(text):
+    """Render text as a C string literal split over several lines."""
+    escaped = text.replace("\\", "\\\\").replace('"', '\\"')
+    lines = [escaped[i:i + LINE_WIDTH] for i in range(0, len(escaped), LINE_WIDTH)]
+    # Never split an escape sequence across two literals
+    fixed = []
+    carry = ""
+    for line in lines:
+        line = carry + line
+        carry = ""
+        trailing = len(line) - len(line.rstrip("\\"))
+        if trailing % 2 == 1:
+            carry = "\\"
+            line = line[:-1]
+        fixed.append(line)
+    if carry:
+        fixed.append(carry)
+    return "\n".join('    "%s"' % line for line in fixed)
+
+
+def build():
+    tools = json.loads(read("tools.json"))
+    system_prompt = read("system_prompt.txt")
+    native_audio_prompt = read("native_audio_prompt.txt")
+
+    compact = (",", ":")
+    tools_and_prompt = (
+        '"tools":[' + json.dumps(tools, separators=compact) + "],"
+        '"systemInstruction":{"parts":[{"text":' + json.dumps(system_prompt) + "}"
+    )
+    native_audio_part = ',{"text":' + json.dumps(native_audio_prompt) + "}"
+
+    # Sanity check: every combination must close into valid JSON
+    for extra in ("", native_audio_part):
+        json.loads("{" + tools_and_prompt + extra + "]}}")
+
+    header = """// Generated by scripts/generate_setup_message.py from prompts/ - do not edit by hand.
+#ifndef SETUP_MESSAGE_H
+#define SETUP_MESSAGE_H
+
+#include <Arduino.h>
+
+// "tools":[...],"systemInstruction":{"parts":[{"text":"<system prompt>"}
+// (the caller closes the parts array and the setup object)
+const char SETUP_TOOLS_AND_PROMPT[] =
+%s;
+
+// Extra systemInstruction part appended in native audio mode: ,{"text":"<native audio prompt>"}
+const char SETUP_NATIVE_AUDIO_PART[] =
+%s;
+
+#endif
+""" % (c_literal(tools_and_prompt), c_literal(native_audio_part))
+
+    existing = None
+    if os.path.exists(OUTPUT_PATH):
+        with open(OUTPUT_PATH, encoding="utf-8") as f:
+            existing = f.read()
+    if existing != header:
+        with open(OUTPUT_PATH, "w", encoding="utf-8", newline="\n") as f:
+            f.write(header)
+        print("Generated %s (%d bytes of setup JSON)" % (OUTPUT_PATH, len(tools_and_prompt) + len(native_audio_part)))
+
+
+build()
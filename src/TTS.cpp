@@ -1,9 +1,13 @@
 #include "TTS.h"
 #include "secrets.h"
+#include "deepgram_config.h"
+#include "http_connection_pool.h"
+#include "http_body_stream.h"
 
-const char* TTS::DEEPGRAM_URL = "https://api.deepgram.com/v1/speak?encoding=linear16&sample_rate=16000&model=aura-asteria-en";
-
-TTS::TTS() : i2sInitialized(false), softwareGain(1.0), audioBuffer(nullptr), defaultLanguage("en-US"), is_cancellation_requested(false) {
+TTS::TTS() : i2sInitialized(false), softwareGain(1.0), audioBuffer(nullptr), defaultLanguage("en-US"), is_cancellation_requested(false),
+             pcmStream(nullptr), pcmStreamStorage(nullptr), pcmStreamSampleRate(SAMPLE_RATE), pcmStreamEnded(true), pcmStreamPlaying(false) {
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    pcmStreamMux = unlocked;
 }
 
 TTS::~TTS() {
@@ -11,6 +15,12 @@ TTS::~TTS() {
     if (audioBuffer) {
         free(audioBuffer);
     }
+    if (pcmStream) {
+        vStreamBufferDelete(pcmStream);
+    }
+    if (pcmStreamStorage) {
+        free(pcmStreamStorage);
+    }
 }
 
 bool TTS::initialize(const String& apiKey) {
@@ -29,6 +39,17 @@ bool TTS::initialize(const String& apiKey) {
         Serial.printf("Allocated %d bytes for TTS audio buffer in PSRAM\n", BUFFER_SIZE);
     }
     
+    // Allocate the PCM stream used for streamed (native) audio playback
+    if (!pcmStream) {
+        pcmStreamStorage = (uint8_t*)ps_malloc(STREAM_BUFFER_SIZE + 1);
+        if (pcmStreamStorage) {
+            pcmStream = xStreamBufferCreateStatic(STREAM_BUFFER_SIZE, 1, pcmStreamStorage, &pcmStreamStruct);
+        }
+        if (!pcmStream) {
+            Serial.println("⚠️ Failed to allocate TTS PCM stream - streamed playback disabled");
+        }
+    }
+    
     // Optimize WiFi for maximum speed
     optimizeWiFiForSpeed();
     
@@ -139,9 +160,6 @@ bool TTS::streamDeepgramAPI(const String& text, const String& language) {
 
     HTTPClient http;
     
-    WiFiClientSecure client;
-    client.setInsecure();
-    
     // Check WiFi connection before configuring client
     if (WiFi.status() != WL_CONNECTED) {
         Serial.println("❌ WiFi not connected - cannot proceed with TTS request");
@@ -149,7 +167,7 @@ bool TTS::streamDeepgramAPI(const String& text, const String& language) {
     }
 
     // Build URL with language parameter - use local copies
-    String deepgramUrl = "https://api.deepgram.com/v1/speak?encoding=linear16&sample_rate=16000";
+    String deepgramUrl = String(DEEPGRAM_BASE_URL) + "/v1/speak?encoding=linear16&sample_rate=16000";
     
     // Add model based on language
     if (localLanguage == "es" || localLanguage == "spanish") {
@@ -167,26 +185,23 @@ bool TTS::streamDeepgramAPI(const String& text, const String& language) {
         deepgramUrl += "&model=aura-asteria-en";
     }
 
-    http.begin(client, deepgramUrl);
-    http.addHeader("Content-Type", "application/json");
-    String authHeader = "Token " + localApiKey;
-    http.addHeader("Authorization", authHeader);
-    http.addHeader("Accept-Encoding", "identity");  // Disable compression to reduce CPU load
-    http.setTimeout(60000);  // 1 minute timeout (max for uint16_t)
-    http.setReuse(false);  // Don't reuse connections to avoid potential issues
-
-    int httpCode = http.POST(jsonPayload);
+    // Keep-alive connection shared with the other Deepgram requests
+    HttpConnectionPool& pool = HttpConnectionPool::shared();
+    WiFiClient* client = nullptr;
+    int httpCode = postSpeakRequest(http, client, deepgramUrl, jsonPayload, localApiKey);
+    if (!client) {
+        Serial.println("❌ Failed to begin HTTP connection");
+        releaseSpeakerAccess();
+        return false;
+    }
     Serial.printf("Deepgram TTS HTTP Response Code: %d\n", httpCode);
 
     bool success = false;
+    bool reusable = false;
 
     if (httpCode == HTTP_CODE_OK) {
-        WiFiClient* stream = http.getStreamPtr();
-        if (!stream) {
-            Serial.println("❌ Failed to get stream pointer from HTTPClient");
-            http.end();
-            return false;
-        }
+        // Reads to the end of this response only, so the connection survives for the next one
+        HttpBodyStream body(http, client);
 
         Serial.println("✅ Starting to stream and play audio data...");
         
@@ -199,40 +214,34 @@ bool TTS::streamDeepgramAPI(const String& text, const String& language) {
         const unsigned long streamReadTimeout = 60000;  // 60 second timeout
 
         // Stream and play audio in real-time
-        while (http.connected() && (stream->available() || (millis() - lastDataTime < streamReadTimeout))) {
+        while (!body.isFinished() && millis() - lastDataTime < streamReadTimeout) {
             if (is_cancellation_requested) {
                 Serial.println("🚫 TTS streaming cancelled by request");
                 break;
             }
-            if (!http.connected()) {
-                Serial.println("❌ HTTP connection lost during stream");
-                break;
-            }
             
-            if (stream->available()) {
-                size_t bytesRead = stream->readBytes(audioBuffer, BUFFER_SIZE);
-                if (bytesRead > 0) {
-                    totalBytesReceived += bytesRead;
-                    
-                    // Write directly to I2S - the audio is already in the right format
-                    size_t bytesWritten;
-                    esp_err_t err = i2s_write(I2S_PORT, audioBuffer, bytesRead, &bytesWritten, portMAX_DELAY);
-                    if (err != ESP_OK) {
-                        Serial.printf("❌ I2S write error: %s\n", esp_err_to_name(err));
-                        break;
-                    }
-                    
-                    if (bytesWritten < bytesRead) {
-                        Serial.printf("⚠️ I2S underrun: tried to write %u, only wrote %u\n", bytesRead, bytesWritten);
-                    }
-                    
-                    bytesWrittenToI2S += bytesWritten;
-                    lastDataTime = millis();
-                    
-                    // Debug output every 8KB
-                    if ((totalBytesReceived / 8192) != ((totalBytesReceived - bytesRead) / 8192)) {
-                        Serial.printf("🔊 Streamed %u bytes so far...\n", totalBytesReceived);
-                    }
+            size_t bytesRead = body.readAvailable(audioBuffer, BUFFER_SIZE);
+            if (bytesRead > 0) {
+                totalBytesReceived += bytesRead;
+                
+                // Write directly to I2S - the audio is already in the right format
+                size_t bytesWritten;
+                esp_err_t err = i2s_write(I2S_PORT, audioBuffer, bytesRead, &bytesWritten, portMAX_DELAY);
+                if (err != ESP_OK) {
+                    Serial.printf("❌ I2S write error: %s\n", esp_err_to_name(err));
+                    break;
+                }
+                
+                if (bytesWritten < bytesRead) {
+                    Serial.printf("⚠️ I2S underrun: tried to write %u, only wrote %u\n", bytesRead, bytesWritten);
+                }
+                
+                bytesWrittenToI2S += bytesWritten;
+                lastDataTime = millis();
+                
+                // Debug output every 8KB
+                if ((totalBytesReceived / 8192) != ((totalBytesReceived - bytesRead) / 8192)) {
+                    Serial.printf("🔊 Streamed %u bytes so far...\n", totalBytesReceived);
                 }
             } else {
                 yield();
@@ -240,6 +249,7 @@ bool TTS::streamDeepgramAPI(const String& text, const String& language) {
             }
         }
 
+        reusable = body.isComplete();
         Serial.printf("✅ Finished streaming. Received: %u bytes, Sent to I2S: %u bytes\n", 
                      totalBytesReceived, bytesWrittenToI2S);
         
@@ -273,6 +283,7 @@ bool TTS::streamDeepgramAPI(const String& text, const String& language) {
     } else {
         Serial.printf("❌ Deepgram TTS request failed. HTTP Code: %d\n", httpCode);
         String errorPayload = http.getString();
+        reusable = httpCode > 0;
         if (errorPayload.length() > 0) {
             Serial.println("Error payload:");
             Serial.println(errorPayload);
@@ -280,10 +291,40 @@ bool TTS::streamDeepgramAPI(const String& text, const String& language) {
     }
     
     http.end();
+    pool.release(client, reusable);
     releaseSpeakerAccess();
     return success;
 }
 
+int TTS::postSpeakRequest(HTTPClient& http, WiFiClient*& client, const String& url, const String& payload,
+                          const String& apiKey) {
+    HttpConnectionPool& pool = HttpConnectionPool::shared();
+    bool reused = false;
+    client = pool.acquire(url, HttpConnectionPool::CONNECT_TIMEOUT, &reused);
+    while (true) {
+        if (!client || !http.begin(*client, url)) {
+            pool.release(client, false);
+            client = nullptr;
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+        http.addHeader("Content-Type", "application/json");
+        http.addHeader("Authorization", "Token " + apiKey);
+        http.addHeader("Accept-Encoding", "identity");  // Disable compression to reduce CPU load
+        http.setTimeout(60000);  // 1 minute timeout (max for uint16_t)
+        http.setReuse(true);
+        HttpBodyStream::prepare(http);
+
+        int httpCode = http.POST(payload);
+        if (!pool.shouldRetryFresh(reused, httpCode)) {
+            return httpCode;
+        }
+        http.end();
+        pool.release(client, false);
+        client = pool.acquireFresh(url);
+        reused = false;
+    }
+}
+
 bool TTS::ensureInitialized() {
     if (i2sInitialized) {
         return true;
@@ -371,9 +412,6 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
     
     HTTPClient http;
     
-    WiFiClientSecure client;
-    client.setInsecure();
-    
     // Check WiFi connection before configuring client
     if (WiFi.status() != WL_CONNECTED) {
         Serial.println("❌ WiFi not connected - cannot proceed with TTS request");
@@ -381,7 +419,7 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
     }
     
     // Build URL with language parameter - use local copies
-    String deepgramUrl = "https://api.deepgram.com/v1/speak?encoding=linear16&sample_rate=16000";
+    String deepgramUrl = String(DEEPGRAM_BASE_URL) + "/v1/speak?encoding=linear16&sample_rate=16000";
     
     // Add model based on language
     if (localLanguage == "es" || localLanguage == "spanish") {
@@ -401,33 +439,23 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
 
     Serial.printf("🔧 Memory before HTTP begin: %u bytes\n", ESP.getFreeHeap());
     
-    if (!http.begin(client, deepgramUrl)) {
+    // Keep-alive connection shared with the other Deepgram requests
+    HttpConnectionPool& pool = HttpConnectionPool::shared();
+    WiFiClient* client = nullptr;
+    int httpCode = postSpeakRequest(http, client, deepgramUrl, jsonPayload, localApiKey);
+    if (!client) {
         Serial.println("❌ Failed to begin HTTP connection");
         return false;
     }
     
-    Serial.printf("🔧 Memory after HTTP begin: %u bytes\n", ESP.getFreeHeap());
-    
-    http.addHeader("Content-Type", "application/json");
-    String authHeader = "Token " + localApiKey;
-    http.addHeader("Authorization", authHeader);
-    http.addHeader("Accept-Encoding", "identity");  // Disable compression to reduce CPU load
-    http.addHeader("Connection", "close");  // Close connection after request to free resources
-    http.setTimeout(60000);  // 1 minute timeout (max for uint16_t)
-    http.setReuse(false);  // Don't reuse connections to avoid potential issues
-
-    int httpCode = http.POST(jsonPayload);
+    Serial.printf("🔧 Memory after HTTP request: %u bytes\n", ESP.getFreeHeap());
     Serial.printf("Deepgram TTS HTTP Response Code: %d\n", httpCode);
 
     bool success = false;
+    bool reusable = false;
     
     if (httpCode == HTTP_CODE_OK) {
-        WiFiClient* stream = http.getStreamPtr();
-        if (!stream) {
-            Serial.println("❌ Failed to get stream pointer");
-            http.end();
-            return false;
-        }
+        HttpBodyStream body(http, client);
 
         // Get content length if available
         int contentLength = http.getSize();
@@ -448,6 +476,7 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
         if (*audioData == nullptr) {
             Serial.println("❌ Failed to allocate memory for audio data");
             http.end();
+            pool.release(client, false);
             return false;
         }
 
@@ -462,8 +491,8 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
         Serial.println("📥 Starting download...");
 
         // Read all data from stream
-        while (http.connected() && (stream->available() || (millis() - lastDataTime < timeout))) {
-            if (stream->available()) {
+        while (!body.isFinished() && millis() - lastDataTime < timeout) {
+            if (body.available()) {
                 // Resize buffer if needed (with larger increments)
                 if (totalRead + readChunkSize > bufferSize) {
                     bufferSize += 8192;  // Increase by 8KB at a time
@@ -480,12 +509,13 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
                         free(*audioData);
                         *audioData = nullptr;
                         http.end();
+                        pool.release(client, false);
                         return false;
                     }
                     *audioData = newBuffer;
                 }
 
-                size_t bytesRead = stream->readBytes(*audioData + totalRead, 
+                size_t bytesRead = body.readAvailable(*audioData + totalRead, 
                     (readChunkSize < (bufferSize - totalRead)) ? readChunkSize : (bufferSize - totalRead));
                 if (bytesRead > 0) {
                     totalRead += bytesRead;
@@ -558,9 +588,11 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
 
         *dataSize = totalRead;
         success = (totalRead > 0);
+        reusable = body.isComplete();
     } else {
         Serial.printf("❌ HTTP request failed with code: %d\n", httpCode);
         String response = http.getString();
+        reusable = httpCode > 0;
         if (response.length() > 0) {
             Serial.println("Error response:");
             Serial.println(response);
@@ -568,6 +600,7 @@ bool TTS::callDeepgramAPI(const String& text, const String& language, uint8_t**
     }
     
     http.end();
+    pool.release(client, reusable);
     
     Serial.printf("🔧 Memory after cleanup: %u bytes\n", ESP.getFreeHeap());
     
@@ -710,6 +743,128 @@ bool TTS::playAudioData(const uint8_t* audioData, size_t dataSize) {
     return totalWritten == dataSize;
 }
 
+bool TTS::beginStream(uint32_t sampleRate) {
+    if (!pcmStream) {
+        return false;
+    }
+    
+    bool needsPlayer;
+    portENTER_CRITICAL(&pcmStreamMux);
+    pcmStreamEnded = false;
+    needsPlayer = !pcmStreamPlaying;
+    if (needsPlayer) {
+        // Nobody is draining the stream - start from a clean buffer
+        xStreamBufferReset(pcmStream);
+        pcmStreamSampleRate = sampleRate;
+        pcmStreamPlaying = true;
+    }
+    portEXIT_CRITICAL(&pcmStreamMux);
+    
+    return needsPlayer;
+}
+
+size_t TTS::writeStream(const uint8_t* data, size_t length) {
+    if (!pcmStream || !data || length == 0 || !pcmStreamPlaying) {
+        return 0;
+    }
+    
+    // Never block the producer (it runs inside the WebSocket loop)
+    size_t written = xStreamBufferSend(pcmStream, data, length, 0);
+    if (written < length) {
+        Serial.printf("⚠️ TTS stream overflow: dropped %u of %u bytes\n", length - written, length);
+    }
+    return written;
+}
+
+void TTS::endStream() {
+    pcmStreamEnded = true;
+}
+
+bool TTS::playStream() {
+    if (!pcmStream || !audioBuffer) {
+        pcmStreamPlaying = false;
+        return false;
+    }
+    
+    is_cancellation_requested = false;
+    
+    // Request I2S access for speaker, forcefully if necessary
+    if (!requestSpeakerAccess()) {
+        Serial.println("TTS Stream: Forcing I2S release for speaker...");
+        I2SManager::forceReleaseI2SAccess();
+        if (!requestSpeakerAccess()) {
+            Serial.println("❌ Cannot play stream: Failed to get speaker access even after force release");
+            pcmStreamPlaying = false;
+            return false;
+        }
+    }
+    
+    // The speaker is configured for 16 kHz - switch to the stream's rate for this playback
+    if (pcmStreamSampleRate != SAMPLE_RATE) {
+        i2s_set_sample_rates(I2S_PORT, pcmStreamSampleRate);
+    }
+    i2s_zero_dma_buffer(I2S_PORT);
+    
+    Serial.printf("▶️ Playing PCM stream at %u Hz\n", pcmStreamSampleRate);
+    unsigned long startTime = millis();
+    unsigned long lastDataTime = millis();
+    size_t totalWritten = 0;
+    
+    while (true) {
+        if (is_cancellation_requested) {
+            Serial.println("🚫 Stream playback cancelled by request");
+            break;
+        }
+        
+        // Read in whole 16-bit samples
+        size_t bytesRead = xStreamBufferReceive(pcmStream, audioBuffer, BUFFER_SIZE & ~(size_t)1, pdMS_TO_TICKS(50));
+        if (bytesRead > 0) {
+            if (softwareGain != 1.0) {
+                applySoftwareGain(audioBuffer, bytesRead);
+            }
+            size_t bytesWritten;
+            esp_err_t err = i2s_write(I2S_PORT, audioBuffer, bytesRead, &bytesWritten, portMAX_DELAY);
+            if (err != ESP_OK) {
+                Serial.printf("❌ I2S write error: %s\n", esp_err_to_name(err));
+                break;
+            }
+            totalWritten += bytesWritten;
+            lastDataTime = millis();
+            continue;
+        }
+        
+        // Buffer is empty - stop once the producer has finished the turn
+        bool finished = false;
+        portENTER_CRITICAL(&pcmStreamMux);
+        if (pcmStreamEnded && xStreamBufferIsEmpty(pcmStream)) {
+            pcmStreamPlaying = false;
+            finished = true;
+        }
+        portEXIT_CRITICAL(&pcmStreamMux);
+        if (finished) {
+            break;
+        }
+        
+        if (millis() - lastDataTime > STREAM_IDLE_TIMEOUT) {
+            Serial.println("⚠️ PCM stream stalled - stopping playback");
+            break;
+        }
+    }
+    pcmStreamPlaying = false;
+    
+    if (totalWritten > 0) {
+        // Let the DMA buffers (8 x 1024 samples) play out before shutting the speaker down
+        delay((8 * 1024 * 1000) / pcmStreamSampleRate);
+        i2s_zero_dma_buffer(I2S_PORT);
+        delay(50);  // Small delay to ensure clean stop
+    }
+    
+    Serial.printf("✅ Stream playback done: %u bytes in %lu ms\n", totalWritten, millis() - startTime);
+    releaseSpeakerAccess();
+    
+    return totalWritten > 0 && !is_cancellation_requested;
+}
+
 void TTS::stopPlayback() {
     cancel();
 }
@@ -7,6 +7,7 @@
 #include <WiFi.h>
 #include <esp_wifi.h>
 #include "driver/i2s.h"
+#include "freertos/stream_buffer.h"
 #include "i2s_manager.h"
 
 class TTS {
@@ -21,9 +22,6 @@ private:
     static const int BITS_PER_SAMPLE = 16;
     static const i2s_port_t I2S_PORT = I2S_NUM_1;
     
-    // API configuration (matching working example)
-    static const char* DEEPGRAM_URL;
-    
     bool i2sInitialized;
     String deepgramApiKey;
     String defaultLanguage;
@@ -36,6 +34,17 @@ private:
     uint8_t* audioBuffer;
     volatile bool is_cancellation_requested;
     
+    // PCM stream fed by a producer on another core (Gemini native audio) and drained by playStream()
+    static const size_t STREAM_BUFFER_SIZE = 65536;  // ~1.3 s of 24 kHz audio
+    static const unsigned long STREAM_IDLE_TIMEOUT = 5000;  // Give up if the producer stalls this long
+    StreamBufferHandle_t pcmStream;
+    StaticStreamBuffer_t pcmStreamStruct;
+    uint8_t* pcmStreamStorage;
+    uint32_t pcmStreamSampleRate;
+    volatile bool pcmStreamEnded;
+    volatile bool pcmStreamPlaying;
+    portMUX_TYPE pcmStreamMux;
+    
 public:
     TTS();
     ~TTS();
@@ -58,6 +67,13 @@ public:
     void stopPlayback();
     void cancel();
     
+    // Streaming playback (producer side is non-blocking, consumer side runs on the audio task)
+    // beginStream() returns true when a new playStream() call is needed to drain the stream.
+    bool beginStream(uint32_t sampleRate);
+    size_t writeStream(const uint8_t* data, size_t length);
+    void endStream();
+    bool playStream();
+    
 // Tone generation
     void playTone(int frequency, int duration);
     // I2S resource management
@@ -79,6 +95,10 @@ private:
     bool callDeepgramAPI(const String& text, const String& language, uint8_t** audioData, size_t* dataSize);
     bool streamDeepgramAPI(const String& text);  // Streaming method for raw PCM
     bool streamDeepgramAPI(const String& text, const String& language);  // Streaming method with language
+    // POST a speak request on a pooled connection, retrying once on a new connection if a kept-alive
+    // one was stale. client is nullptr if no connection could be opened; otherwise release it after http.end()
+    int postSpeakRequest(HTTPClient& http, WiFiClient*& client, const String& url, const String& payload,
+                         const String& apiKey);
     void cleanupAudioData(uint8_t* audioData);
     void applySoftwareGain(uint8_t* audioData, size_t dataSize);  // Apply software gain to audio data
     
@@ -0,0 +1,186 @@
+#include "adpcm_wav_stream.h"
+
+static const int16_t STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t INDEX_TABLE[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static void putLE16(uint8_t* p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static void putLE32(uint8_t* p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = value >> 24;
+}
+
+AdpcmWavStream::AdpcmWavStream(const PcmSegment* segments, int segmentCount, uint32_t sampleRate)
+    : segments(segments), segmentCount(segmentCount), segmentIndex(0), segmentOffset(0), sampleCount(0),
+      stepIndex(0), blockPos(BLOCK_ALIGN), headerPos(0), encodeMicros(0), firstReadAt(0), lastReadAt(0) {
+    size_t pcmBytes = 0;
+    for (int i = 0; i < segmentCount; i++) {
+        pcmBytes += segments[i].size;
+    }
+    sampleCount = pcmBytes / 2;
+    blockCount = (sampleCount + SAMPLES_PER_BLOCK - 1) / SAMPLES_PER_BLOCK;
+    totalSize = HEADER_SIZE + (size_t)blockCount * BLOCK_ALIGN;
+    remaining = totalSize;
+    buildHeader(sampleRate);
+}
+
+void AdpcmWavStream::buildHeader(uint32_t sampleRate) {
+    uint32_t dataSize = blockCount * BLOCK_ALIGN;
+    uint8_t* p = header;
+    memcpy(p, "RIFF", 4);
+    putLE32(p + 4, HEADER_SIZE - 8 + dataSize);
+    memcpy(p + 8, "WAVE", 4);
+    p += 12;
+
+    memcpy(p, "fmt ", 4);
+    putLE32(p + 4, 20);
+    putLE16(p + 8, 0x0011);                                             // WAVE_FORMAT_IMA_ADPCM
+    putLE16(p + 10, 1);                                                 // Mono
+    putLE32(p + 12, sampleRate);
+    putLE32(p + 16, (uint32_t)((uint64_t)sampleRate * BLOCK_ALIGN / SAMPLES_PER_BLOCK));
+    putLE16(p + 20, BLOCK_ALIGN);
+    putLE16(p + 22, 4);                                                 // Bits per sample
+    putLE16(p + 24, 2);                                                 // Extra format bytes
+    putLE16(p + 26, SAMPLES_PER_BLOCK);
+    p += 28;
+
+    memcpy(p, "fact", 4);
+    putLE32(p + 4, 4);
+    putLE32(p + 8, sampleCount);                                        // Real length (last block is padded)
+    p += 12;
+
+    memcpy(p, "data", 4);
+    putLE32(p + 4, dataSize);
+}
+
+int16_t AdpcmWavStream::nextSample() {
+    while (segmentIndex < segmentCount && segmentOffset + 2 > segments[segmentIndex].size) {
+        segmentIndex++;
+        segmentOffset = 0;
+    }
+    if (segmentIndex >= segmentCount) {
+        return 0;  // Pad the last block with silence
+    }
+    int16_t sample;
+    memcpy(&sample, segments[segmentIndex].data + segmentOffset, 2);
+    segmentOffset += 2;
+    return sample;
+}
+
+void AdpcmWavStream::encodeBlock() {
+    unsigned long start = micros();
+
+    // Block header: first sample verbatim plus the step index the nibbles start from
+    int predictor = nextSample();
+    putLE16(block, (uint16_t)predictor);
+    block[2] = (uint8_t)stepIndex;
+    block[3] = 0;
+
+    for (int i = 4; i < BLOCK_ALIGN; i++) {
+        uint8_t packed = 0;
+        for (int nibble = 0; nibble < 2; nibble++) {
+            int diff = nextSample() - predictor;
+            int step = STEP_TABLE[stepIndex];
+            int code = 0;
+            if (diff < 0) {
+                code = 8;
+                diff = -diff;
+            }
+
+            int delta = step >> 3;
+            if (diff >= step) { code |= 4; diff -= step; delta += step; }
+            step >>= 1;
+            if (diff >= step) { code |= 2; diff -= step; delta += step; }
+            step >>= 1;
+            if (diff >= step) { code |= 1; delta += step; }
+
+            predictor += (code & 8) ? -delta : delta;
+            if (predictor > 32767) predictor = 32767;
+            if (predictor < -32768) predictor = -32768;
+
+            stepIndex += INDEX_TABLE[code];
+            if (stepIndex < 0) stepIndex = 0;
+            if (stepIndex > 88) stepIndex = 88;
+
+            packed |= code << (nibble * 4);  // Low nibble holds the earlier sample
+        }
+        block[i] = packed;
+    }
+
+    blockPos = 0;
+    encodeMicros += micros() - start;
+}
+
+int AdpcmWavStream::available() {
+    return remaining > INT32_MAX ? INT32_MAX : (int)remaining;
+}
+
+int AdpcmWavStream::peek() {
+    if (remaining == 0) {
+        return -1;
+    }
+    if (headerPos < HEADER_SIZE) {
+        return header[headerPos];
+    }
+    if (blockPos == BLOCK_ALIGN) {
+        encodeBlock();
+    }
+    return block[blockPos];
+}
+
+int AdpcmWavStream::read() {
+    uint8_t c;
+    return readBytes((char*)&c, 1) == 1 ? c : -1;
+}
+
+size_t AdpcmWavStream::readBytes(char* buffer, size_t length) {
+    if (firstReadAt == 0) {
+        firstReadAt = millis();
+    }
+
+    size_t copied = 0;
+    while (copied < length && remaining > 0) {
+        const uint8_t* source;
+        size_t chunk;
+        if (headerPos < HEADER_SIZE) {
+            source = header + headerPos;
+            chunk = HEADER_SIZE - headerPos;
+        } else {
+            if (blockPos == BLOCK_ALIGN) {
+                encodeBlock();
+            }
+            source = block + blockPos;
+            chunk = BLOCK_ALIGN - blockPos;
+        }
+        if (chunk > length - copied) {
+            chunk = length - copied;
+        }
+        memcpy(buffer + copied, source, chunk);
+        copied += chunk;
+        remaining -= chunk;
+        if (headerPos < HEADER_SIZE) {
+            headerPos += chunk;
+        } else {
+            blockPos += chunk;
+        }
+    }
+
+    lastReadAt = millis();
+    return copied;
+}
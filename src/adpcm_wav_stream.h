@@ -0,0 +1,57 @@
+#ifndef ADPCM_WAV_STREAM_H
+#define ADPCM_WAV_STREAM_H
+
+#include <Arduino.h>
+#include "pcm_segment.h"
+
+// Encodes 16-bit mono PCM to an IMA-ADPCM WAV file (format tag 0x0011) while it is read, so
+// HTTPClient::sendRequest() can upload ~4x less data without an encoded copy in memory.
+// The WAV size is known up front (fixed-size blocks), so Content-Length still works.
+class AdpcmWavStream : public Stream {
+private:
+    static const int BLOCK_ALIGN = 256;                                 // Bytes per ADPCM block
+    static const int SAMPLES_PER_BLOCK = (BLOCK_ALIGN - 4) * 2 + 1;     // 505: header sample + 2 per byte
+    static const int HEADER_SIZE = 60;                                  // RIFF + fmt(20) + fact + data headers
+
+    const PcmSegment* segments;
+    int segmentCount;
+    int segmentIndex;           // Next PCM sample to encode
+    size_t segmentOffset;
+    uint32_t sampleCount;
+    uint32_t blockCount;
+
+    int stepIndex;              // Encoder state carried across blocks
+    uint8_t block[BLOCK_ALIGN];
+    int blockPos;               // Read position in block (BLOCK_ALIGN = needs refill)
+    uint8_t header[HEADER_SIZE];
+    int headerPos;
+
+    size_t remaining;
+    size_t totalSize;
+    uint32_t encodeMicros;
+    unsigned long firstReadAt;
+    unsigned long lastReadAt;
+
+    void buildHeader(uint32_t sampleRate);
+    int16_t nextSample();
+    void encodeBlock();
+
+public:
+    AdpcmWavStream(const PcmSegment* segments, int segmentCount, uint32_t sampleRate);
+
+    size_t size() const { return totalSize; }
+    uint32_t getEncodeMicros() const { return encodeMicros; }
+    // Time between the first and last byte being read (the upload's transfer time)
+    unsigned long getTransferMs() const { return lastReadAt - firstReadAt; }
+
+    // Stream
+    int available() override;
+    int read() override;
+    int peek() override;
+    using Stream::readBytes;
+    size_t readBytes(char* buffer, size_t length) override;
+    size_t write(uint8_t) override { return 0; }
+    void flush() override {}
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef AUDIO_CONFIG_H
+#define AUDIO_CONFIG_H
+
+#include <Arduino.h>
+
+// Capture DSP chain (applied to every microphone block before the wake word ring, VAD and
+// command buffer). Levels are in 16-bit sample units.
+
+// High-pass corner: removes handling rumble and wind below the voice band
+const uint32_t AUDIO_HIGHPASS_HZ = 80;
+
+// Automatic gain control: brings block peaks towards the target within the gain range. Setting
+// both limits to the same value gives a fixed gain (the capture path used a fixed 2x before).
+const int32_t AUDIO_AGC_TARGET_PEAK = 12000;   // About -8.7 dBFS
+const int32_t AUDIO_AGC_MIN_GAIN = 1;
+const int32_t AUDIO_AGC_MAX_GAIN = 8;
+const int32_t AUDIO_AGC_INITIAL_GAIN = 2;
+
+// Noise gate: attenuates blocks quieter than the threshold RMS. Off by default - the VAD and
+// Deepgram both do better with the real background than with gated silence.
+const bool AUDIO_NOISE_GATE_ENABLED = false;
+const int32_t AUDIO_NOISE_GATE_RMS = 100;
+
+// Wake word search audio is decimated (16 kHz -> 8 kHz): keyword search needs the telephone band
+// only, so the ring and each upload are half the size. Commands keep the full rate.
+const int AUDIO_WAKE_SEARCH_DECIMATION = 2;
+const int AUDIO_WAKE_SEARCH_FILTER_TAPS = 48;       // ~0.05 dB ripple to 3.4 kHz, aliases < -47 dB
+const uint32_t AUDIO_WAKE_SEARCH_PASSBAND_HZ = 3400;
+
+// Local pre-filter in front of the cloud wake word search: windows without a "halo"-like
+// two-syllable word (score 0-100) aren't uploaded. In shadow mode every window is still searched
+// and the report counts the wakes the filter would have missed - use it to tune the threshold.
+// Ships in shadow mode: the threshold hasn't been checked against recorded wake words yet.
+const bool AUDIO_WAKE_PREFILTER_ENABLED = true;
+const bool AUDIO_WAKE_PREFILTER_SHADOW = true;
+const int AUDIO_WAKE_PREFILTER_THRESHOLD = 65;      // Needs the syllable timing and voicing
+
+#endif
@@ -0,0 +1,307 @@
+#include "audio_dsp.h"
+#include <math.h>
+
+void DcBlocker::process(int32_t* samples, int count) {
+    int32_t dc = dcQ8;
+    for (int i = 0; i < count; i++) {
+        int32_t x = samples[i];
+        dc += ((x << 8) - dc) >> TRACK_SHIFT;
+        samples[i] = x - (dc >> 8);
+    }
+    dcQ8 = dc;
+}
+
+HighPassBiquad::HighPassBiquad(uint32_t cutoffHz, uint32_t sampleRate)
+    : x1(0), x2(0), y1(0), y2(0), error(0) {
+    // RBJ cookbook high-pass, Q = 1/sqrt(2)
+    double w0 = 2.0 * M_PI * cutoffHz / sampleRate;
+    double alpha = sin(w0) / (2.0 * M_SQRT1_2);
+    double c = cos(w0);
+    double a0 = 1.0 + alpha;
+    double scale = (double)(1L << COEFF_SHIFT) / a0;
+    b0 = (int32_t)lround((1.0 + c) / 2.0 * scale);
+    b1 = (int32_t)lround(-(1.0 + c) * scale);
+    b2 = b0;
+    a1 = (int32_t)lround(-2.0 * c * scale);
+    a2 = (int32_t)lround((1.0 - alpha) * scale);
+}
+
+void HighPassBiquad::process(int32_t* samples, int count) {
+    int32_t xm1 = x1, xm2 = x2, ym1 = y1, ym2 = y2;
+    int64_t err = error;
+    for (int i = 0; i < count; i++) {
+        int32_t x = samples[i];
+        int64_t acc = (int64_t)b0 * x + (int64_t)b1 * xm1 + (int64_t)b2 * xm2
+                    - (int64_t)a1 * ym1 - (int64_t)a2 * ym2 + err;
+        int32_t y = (int32_t)(acc >> COEFF_SHIFT);
+        err = acc - ((int64_t)y << COEFF_SHIFT);
+        xm2 = xm1;
+        xm1 = x;
+        ym2 = ym1;
+        ym1 = y;
+        samples[i] = y;
+    }
+    x1 = xm1;
+    x2 = xm2;
+    y1 = ym1;
+    y2 = ym2;
+    error = err;
+}
+
+AutomaticGainControl::AutomaticGainControl(int32_t targetPeak, int32_t minGain, int32_t maxGain, int32_t initialGain)
+    : targetPeak(targetPeak), minGainQ16(minGain << 16), maxGainQ16(maxGain << 16), gainQ16(initialGain << 16) {
+    if (gainQ16 < minGainQ16) {
+        gainQ16 = minGainQ16;
+    } else if (gainQ16 > maxGainQ16) {
+        gainQ16 = maxGainQ16;
+    }
+}
+
+void AutomaticGainControl::process(int32_t* samples, int count) {
+    if (count <= 0) {
+        return;
+    }
+
+    int32_t peak = 0;
+    for (int i = 0; i < count; i++) {
+        int32_t magnitude = samples[i] < 0 ? -samples[i] : samples[i];
+        if (magnitude > peak) {
+            peak = magnitude;
+        }
+    }
+
+    int32_t target = gainQ16;
+    int rampLength = count;
+    if (peak > 0) {
+        int32_t limit = (int32_t)min(((int64_t)targetPeak << 16) / peak, (int64_t)maxGainQ16);
+        if (gainQ16 > limit) {
+            target = limit;                                     // Attack: this block would overshoot
+            rampLength = min(count, ATTACK_RAMP_SAMPLES);
+        } else if (peak >= MIN_SIGNAL_PEAK) {
+            target = (int32_t)min(gainQ16 + (((int64_t)gainQ16 * count) >> RELEASE_SHIFT), (int64_t)limit);
+        }
+    }
+    if (target < minGainQ16) {
+        target = minGainQ16;
+    } else if (target > maxGainQ16) {
+        target = maxGainQ16;
+    }
+
+    int32_t gain = gainQ16;
+    int32_t step = (target - gain) / rampLength;
+    for (int i = 0; i < rampLength; i++) {
+        gain += step;
+        samples[i] = (int32_t)(((int64_t)samples[i] * gain) >> 16);
+    }
+    for (int i = rampLength; i < count; i++) {
+        samples[i] = (int32_t)(((int64_t)samples[i] * target) >> 16);
+    }
+    gainQ16 = target;
+}
+
+NoiseGate::NoiseGate(int32_t thresholdRms)
+    : thresholdSquare((uint32_t)(thresholdRms * thresholdRms)), quietSamples(0), gainQ16(65536) {
+}
+
+void NoiseGate::process(int32_t* samples, int count) {
+    if (count <= 0) {
+        return;
+    }
+
+    uint64_t sumSquares = 0;
+    for (int i = 0; i < count; i++) {
+        sumSquares += (int64_t)samples[i] * samples[i];
+    }
+
+    int32_t target = gainQ16;
+    if (sumSquares / count >= thresholdSquare) {
+        quietSamples = 0;
+        target = 65536;
+    } else if (quietSamples >= HOLD_SAMPLES) {
+        target = CLOSED_GAIN_Q16;
+    } else {
+        quietSamples += count;
+    }
+    if (target == 65536 && gainQ16 == 65536) {
+        return;  // Open - nothing to do
+    }
+
+    int32_t gain = gainQ16;
+    int32_t step = (target - gain) / count;
+    for (int i = 0; i < count; i++) {
+        gain += step;
+        samples[i] = (int32_t)(((int64_t)samples[i] * gain) >> 16);
+    }
+    gainQ16 = target;
+}
+
+AudioDspChain::AudioDspChain(uint32_t sampleRate)
+    : stageCount(0), sampleRate(sampleRate), blocks(0), samples(0), lastReportAt(0) {
+    for (int i = 0; i < MAX_STAGES; i++) {
+        stages[i] = nullptr;
+        stageCycles[i] = 0;
+    }
+}
+
+bool AudioDspChain::addStage(AudioStage* stage) {
+    if (!stage || stageCount >= MAX_STAGES) {
+        return false;
+    }
+    stages[stageCount++] = stage;
+    return true;
+}
+
+void AudioDspChain::process(int32_t* block, int count) {
+    for (int i = 0; i < stageCount; i++) {
+        uint32_t start = ESP.getCycleCount();
+        stages[i]->process(block, count);
+        stageCycles[i] += ESP.getCycleCount() - start;
+    }
+    blocks++;
+    samples += count;
+}
+
+void AudioDspChain::report(unsigned long now) {
+    if (lastReportAt == 0) {
+        lastReportAt = now;
+        return;
+    }
+    if (now - lastReportAt < REPORT_INTERVAL || blocks == 0) {
+        return;
+    }
+    lastReportAt = now;
+
+    // Cycles available for the audio that was processed
+    double budget = (double)samples / sampleRate * ESP.getCpuFreqMHz() * 1000000.0;
+    uint64_t total = 0;
+    Serial.printf("🎛️ Capture DSP (%u blocks):", blocks);
+    for (int i = 0; i < stageCount; i++) {
+        Serial.printf(" %s %lu cycles/block (%.2f%%)", stages[i]->name(), (unsigned long)(stageCycles[i] / blocks),
+                      stageCycles[i] * 100.0 / budget);
+        total += stageCycles[i];
+        stageCycles[i] = 0;
+    }
+    Serial.printf(", total %.2f%% CPU\n", total * 100.0 / budget);
+    blocks = 0;
+    samples = 0;
+}
+
+// Zeroth-order modified Bessel function, for the Kaiser window
+static double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 25; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+PolyphaseDecimator::PolyphaseDecimator(uint32_t inputRate, int factor, int taps)
+    : factor(factor < 1 ? 1 : factor), inputRate(inputRate), phase(0), cycles(0), inputSamples(0), lastReportAt(0) {
+    int length = (taps + this->factor - 1) / this->factor * this->factor;
+    if (length > MAX_TAPS) {
+        length = MAX_TAPS / this->factor * this->factor;
+    }
+    phaseTaps = length / this->factor;
+
+    // Cut-off at the new Nyquist frequency, normalised to a DC gain of exactly 1
+    double cutoff = 0.5 / this->factor;
+    double centre = (length - 1) / 2.0;
+    double prototype[MAX_TAPS];
+    double sum = 0;
+    for (int n = 0; n < length; n++) {
+        double t = n - centre;
+        double sinc = t == 0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * t) / (M_PI * t);
+        double r = 2.0 * n / (length - 1) - 1.0;
+        prototype[n] = sinc * besselI0(KAISER_BETA * sqrt(1.0 - r * r)) / besselI0(KAISER_BETA);
+        sum += prototype[n];
+    }
+    int32_t total = 0;
+    for (int n = 0; n < length; n++) {
+        int j = this->factor - 1 - n % this->factor;
+        int k = n / this->factor;
+        coeffs[j * phaseTaps + k] = (int16_t)lround(prototype[n] / sum * (1 << COEFF_SHIFT));
+        total += coeffs[j * phaseTaps + k];
+    }
+    // Rounding leftovers go to the centre tap
+    int middle = length / 2;
+    coeffs[(this->factor - 1 - middle % this->factor) * phaseTaps + middle / this->factor] += (1 << COEFF_SHIFT) - total;
+
+    for (int i = 0; i < MAX_TAPS; i++) {
+        delay[i] = 0;
+    }
+}
+
+int PolyphaseDecimator::process(const int32_t* input, int count, int16_t* output) {
+    uint32_t startCycles = ESP.getCycleCount();
+    int produced = 0;
+    for (int i = 0; i < count; i++) {
+        int32_t sample = input[i];
+        if (sample > 32767) {
+            sample = 32767;
+        } else if (sample < -32768) {
+            sample = -32768;
+        }
+
+        int16_t* line = delay + phase * phaseTaps;
+        memmove(line + 1, line, (phaseTaps - 1) * sizeof(int16_t));
+        line[0] = (int16_t)sample;
+        if (++phase < factor) {
+            continue;
+        }
+        phase = 0;
+
+        // Sum of |h| stays well under 2 in Q15, so 16-bit products fit a 32-bit accumulator
+        int32_t acc = 1 << (COEFF_SHIFT - 1);
+        for (int t = 0; t < factor * phaseTaps; t++) {
+            acc += (int32_t)coeffs[t] * delay[t];
+        }
+        acc >>= COEFF_SHIFT;
+        output[produced++] = acc > 32767 ? 32767 : (acc < -32768 ? -32768 : acc);
+    }
+    cycles += ESP.getCycleCount() - startCycles;
+    inputSamples += count;
+    return produced;
+}
+
+void PolyphaseDecimator::logResponse(uint32_t passbandHz) {
+    int length = factor * phaseTaps;
+    uint32_t outputRate = getOutputRate();
+    double ripple = 0;
+    double alias = -200;
+    for (uint32_t hz = 0; hz <= inputRate / 2; hz += 50) {
+        double re = 0, im = 0;
+        for (int n = 0; n < length; n++) {
+            int j = factor - 1 - n % factor;
+            double h = coeffs[j * phaseTaps + n / factor] / (double)(1 << COEFF_SHIFT);
+            re += h * cos(2.0 * M_PI * hz * n / inputRate);
+            im -= h * sin(2.0 * M_PI * hz * n / inputRate);
+        }
+        double db = 10.0 * log10(re * re + im * im + 1e-20);
+        if (hz <= passbandHz) {
+            ripple = max(ripple, fabs(db));
+        } else if (hz >= outputRate - passbandHz) {
+            alias = max(alias, db);  // Folds back into the passband
+        }
+    }
+    Serial.printf("🎛️ Decimator %u -> %u Hz, %d taps: passband +/-%.2f dB to %u Hz, aliases below %.1f dB\n",
+                  inputRate, outputRate, length, ripple, passbandHz, alias);
+}
+
+void PolyphaseDecimator::report(unsigned long now) {
+    if (lastReportAt == 0) {
+        lastReportAt = now;
+        return;
+    }
+    if (now - lastReportAt < REPORT_INTERVAL || inputSamples == 0) {
+        return;
+    }
+    lastReportAt = now;
+
+    double budget = (double)inputSamples / inputRate * ESP.getCpuFreqMHz() * 1000000.0;
+    Serial.printf("🎛️ Decimator: %.1f cycles/input sample (%.2f%% CPU)\n", (double)cycles / inputSamples,
+                  cycles * 100.0 / budget);
+    cycles = 0;
+    inputSamples = 0;
+}
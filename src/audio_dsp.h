@@ -0,0 +1,144 @@
+#ifndef AUDIO_DSP_H
+#define AUDIO_DSP_H
+
+#include <Arduino.h>
+
+// One step of the capture DSP chain. Stages work in place on a block of samples in 16-bit units,
+// held in 32-bit words so intermediate values have headroom; the caller clips at the end.
+class AudioStage {
+public:
+    virtual ~AudioStage() {}
+    virtual const char* name() const = 0;
+    virtual void process(int32_t* samples, int count) = 0;
+};
+
+// Removes the microphone's DC offset by subtracting a slowly tracked mean (~2.5 Hz corner)
+class DcBlocker : public AudioStage {
+private:
+    static const int TRACK_SHIFT = 10;  // Time constant of 1024 samples
+    int32_t dcQ8;                       // Offset estimate, 8 fractional bits
+
+public:
+    DcBlocker() : dcQ8(0) {}
+    const char* name() const override { return "dc"; }
+    void process(int32_t* samples, int count) override;
+};
+
+// Second-order Butterworth high-pass in direct form I with Q28 coefficients. The output rounding
+// error is fed back into the next sample, so the poles near z = 1 don't amplify it.
+class HighPassBiquad : public AudioStage {
+private:
+    static const int COEFF_SHIFT = 28;
+    int32_t b0, b1, b2, a1, a2;
+    int32_t x1, x2, y1, y2;
+    int64_t error;
+
+public:
+    HighPassBiquad(uint32_t cutoffHz, uint32_t sampleRate);
+    const char* name() const override { return "hpf"; }
+    void process(int32_t* samples, int count) override;
+};
+
+// Block peak AGC: gain drops at once when a block would exceed the target, and rises slowly
+// (~4 dB/s, whatever the block size) while there is signal. Quiet blocks hold the gain so
+// background hiss isn't boosted. Gain changes are ramped across the block to avoid steps.
+class AutomaticGainControl : public AudioStage {
+private:
+    static const int32_t MIN_SIGNAL_PEAK = 500;  // Quieter blocks hold the gain
+    static const int RELEASE_SHIFT = 14;         // Gain grows by count/16384 per block (1/64 per 256 samples)
+    static const int ATTACK_RAMP_SAMPLES = 32;   // Gain drops within 2 ms
+
+    int32_t targetPeak;
+    int32_t minGainQ16;
+    int32_t maxGainQ16;
+    int32_t gainQ16;
+
+public:
+    AutomaticGainControl(int32_t targetPeak, int32_t minGain, int32_t maxGain, int32_t initialGain);
+    const char* name() const override { return "agc"; }
+    void process(int32_t* samples, int count) override;
+    float getGain() const { return gainQ16 / 65536.0f; }
+};
+
+// Attenuates blocks whose RMS stays under the threshold, opening at once and closing after a
+// short hold, with the gain ramped across each block
+class NoiseGate : public AudioStage {
+private:
+    static const int32_t CLOSED_GAIN_Q16 = 6554;  // -20 dB
+    static const int HOLD_SAMPLES = 4000;         // 250 ms at 16 kHz, counted across blocks of any size
+
+    uint32_t thresholdSquare;
+    int quietSamples;
+    int32_t gainQ16;
+
+public:
+    NoiseGate(int32_t thresholdRms);
+    const char* name() const override { return "gate"; }
+    void process(int32_t* samples, int count) override;
+};
+
+// Lowers the sample rate by an integer factor with a Kaiser-windowed sinc low-pass (Q15) split
+// into one sub-filter per input phase, so the filter only runs once per output sample. Input is
+// a capture block in 16-bit units (clipped here), output is 16-bit PCM at the lower rate.
+class PolyphaseDecimator {
+public:
+    static const int MAX_TAPS = 64;
+
+private:
+    static const int COEFF_SHIFT = 15;
+    static constexpr float KAISER_BETA = 6.0f;      // ~60 dB stop band
+    static const unsigned long REPORT_INTERVAL = 300000;
+
+    int factor;
+    int phaseTaps;                  // Taps per sub-filter
+    uint32_t inputRate;
+    int16_t coeffs[MAX_TAPS];       // [phase][k] - phase j gets h[k * factor + factor - 1 - j]
+    int16_t delay[MAX_TAPS];        // [phase][k] - k = 0 is the newest input of that phase
+    int phase;                      // Input phase of the next sample
+
+    uint64_t cycles;
+    uint64_t inputSamples;
+    unsigned long lastReportAt;
+
+public:
+    // taps is rounded up to a multiple of factor
+    PolyphaseDecimator(uint32_t inputRate, int factor, int taps);
+
+    uint32_t getOutputRate() const { return inputRate / factor; }
+
+    // Returns the number of output samples written (at most count / factor + 1)
+    int process(const int32_t* input, int count, int16_t* output);
+
+    // Logs the passband ripple and how far aliases of the band above the new Nyquist are pushed
+    // down, from the quantised coefficients
+    void logResponse(uint32_t passbandHz);
+
+    // Logs cycles per input sample and CPU share every few minutes, then starts over
+    void report(unsigned long now);
+};
+
+// Runs the stages in order on each block and counts CPU cycles per stage
+class AudioDspChain {
+private:
+    static const int MAX_STAGES = 6;
+    static const unsigned long REPORT_INTERVAL = 300000;
+
+    AudioStage* stages[MAX_STAGES];
+    uint64_t stageCycles[MAX_STAGES];
+    int stageCount;
+    uint32_t sampleRate;
+    uint32_t blocks;
+    uint64_t samples;
+    unsigned long lastReportAt;
+
+public:
+    AudioDspChain(uint32_t sampleRate);
+
+    bool addStage(AudioStage* stage);
+    void process(int32_t* samples, int count);
+
+    // Logs cycles per block and CPU share of each stage every few minutes, then starts over
+    void report(unsigned long now);
+};
+
+#endif
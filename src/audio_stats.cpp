@@ -0,0 +1,63 @@
+#include "audio_stats.h"
+
+AudioStatsRing::AudioStatsRing(uint32_t capacityBlocks)
+    : blocks(nullptr), capacity(capacityBlocks), blockCount(0), sampleCount(0), fill(0), lastSample(0) {
+    memset(&current, 0, sizeof(current));
+}
+
+bool AudioStatsRing::begin() {
+    if (blocks) {
+        return true;
+    }
+    size_t size = capacity * sizeof(BlockStats);
+    blocks = (BlockStats*)(psramFound() ? ps_malloc(size) : malloc(size));
+    if (!blocks) {
+        Serial.println("❌ Failed to allocate audio statistics ring");
+        return false;
+    }
+    return true;
+}
+
+void AudioStatsRing::commitBlock() {
+    if (blocks) {
+        blocks[blockCount % capacity] = current;
+    }
+    blockCount++;
+    memset(&current, 0, sizeof(current));
+    fill = 0;
+}
+
+AudioWindowStats AudioStatsRing::query(uint32_t from, uint32_t to) const {
+    AudioWindowStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if ((int32_t)(to - from) <= 0) {
+        return stats;
+    }
+
+    // Count blocks back from the one being filled (0), so sample counter wrap-around is harmless
+    uint32_t currentStart = sampleCount - fill;
+    int32_t first = (int32_t)(currentStart - from);
+    int32_t last = (int32_t)(currentStart - (to - 1));
+    first = first <= 0 ? 0 : (first + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES;
+    last = last <= 0 ? 0 : (last + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES;
+    uint32_t available = blocks ? min(blockCount, capacity) : 0;
+    if ((uint32_t)first > available) {
+        first = available;
+    }
+
+    for (int32_t back = first; back >= last; back--) {
+        const BlockStats& block = back == 0 ? current : blocks[(blockCount - back) % capacity];
+        uint32_t count = back == 0 ? fill : BLOCK_SAMPLES;
+        if (count == 0) {
+            continue;
+        }
+        stats.samples += count;
+        stats.sumSquares += block.sumSquares;
+        stats.peak = max(stats.peak, (int32_t)block.peak);
+        stats.quietSamples += block.quietSamples;
+        stats.clippedSamples += block.clippedSamples;
+        stats.zeroCrossings += block.zeroCrossings;
+        stats.fingerprint = stats.fingerprint * 31 + (uint32_t)(block.sumSquares ^ (block.sumSquares >> 32));
+    }
+    return stats;
+}
@@ -0,0 +1,78 @@
+#ifndef AUDIO_STATS_H
+#define AUDIO_STATS_H
+
+#include <Arduino.h>
+
+// Level statistics over a range of captured samples
+struct AudioWindowStats {
+    uint32_t samples;
+    int32_t peak;               // Largest magnitude
+    uint64_t sumSquares;
+    uint32_t quietSamples;      // |x| < AudioStatsRing::QUIET_LEVEL
+    uint32_t clippedSamples;    // |x| > AudioStatsRing::CLIP_LEVEL
+    uint32_t zeroCrossings;
+    uint32_t fingerprint;       // Tells recordings apart in the logs
+
+    float rms() const { return samples ? sqrtf((float)sumSquares / samples) : 0.0f; }
+    float quietPercent() const { return samples ? quietSamples * 100.0f / samples : 0.0f; }
+    float clippedPercent() const { return samples ? clippedSamples * 100.0f / samples : 0.0f; }
+};
+
+// Per-block statistics of the microphone stream, computed once while samples are captured so
+// nobody has to rescan PCM for levels. Blocks are aligned on absolute sample positions (fed
+// alongside the VAD, so positions match wakeVad.getSampleCount()), and window queries are
+// answered at block resolution from the ring. Written and queried by the audio task only.
+class AudioStatsRing {
+public:
+    static const int BLOCK_SAMPLES = 256;       // 16 ms
+    static const int32_t QUIET_LEVEL = 100;
+    static const int32_t CLIP_LEVEL = 30000;
+
+private:
+    struct BlockStats {
+        uint64_t sumSquares;
+        int16_t peak;
+        uint16_t quietSamples;
+        uint16_t clippedSamples;
+        uint16_t zeroCrossings;
+    };
+
+    BlockStats* blocks;         // PSRAM when available
+    uint32_t capacity;          // Blocks kept
+    uint32_t blockCount;        // Blocks completed so far
+    uint32_t sampleCount;
+    BlockStats current;         // Block being filled
+    int fill;
+    int16_t lastSample;
+
+    void commitBlock();
+
+public:
+    explicit AudioStatsRing(uint32_t capacityBlocks);
+
+    bool begin();
+
+    inline void addSample(int16_t sample) {
+        int32_t magnitude = sample < 0 ? -(int32_t)sample : sample;
+        current.sumSquares += (uint32_t)(magnitude * magnitude);
+        if (magnitude > current.peak) {
+            current.peak = magnitude > 32767 ? 32767 : magnitude;
+        }
+        current.quietSamples += magnitude < QUIET_LEVEL;
+        current.clippedSamples += magnitude > CLIP_LEVEL;
+        current.zeroCrossings += (sample ^ lastSample) < 0;
+        lastSample = sample;
+        sampleCount++;
+        if (++fill == BLOCK_SAMPLES) {
+            commitBlock();
+        }
+    }
+
+    uint32_t getSampleCount() const { return sampleCount; }
+
+    // Statistics of the blocks overlapping [from, to) - including the one still being filled -
+    // limited to what the ring still holds
+    AudioWindowStats query(uint32_t from, uint32_t to) const;
+};
+
+#endif
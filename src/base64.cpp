@@ -50,3 +50,34 @@ size_t base64_encode_to_buffer(const uint8_t *data, size_t len, char *buffer, si
     buffer[encoded_len] = '\0';
     return encoded_len;
 }
+
+static int8_t b64_value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+size_t base64_decode_to_buffer(const char *data, size_t len, uint8_t *buffer, size_t bufferSize) {
+    size_t out_idx = 0;
+    uint32_t val = 0;
+    int bits = 0;
+    for (size_t i = 0; i < len; ++i) {
+        int8_t v = b64_value(data[i]);
+        if (v < 0) {
+            continue; // Skip padding and any non-alphabet characters
+        }
+        val = (val << 6) | (uint32_t)v;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            if (out_idx >= bufferSize) {
+                return 0; // Not enough space
+            }
+            buffer[out_idx++] = (uint8_t)((val >> bits) & 0xFF);
+        }
+    }
+    return out_idx;
+}
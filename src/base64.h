@@ -5,5 +5,6 @@
 
 String base64_encode(const uint8_t *data, size_t len);
 size_t base64_encode_to_buffer(const uint8_t *data, size_t len, char *buffer, size_t bufferSize);
+size_t base64_decode_to_buffer(const char *data, size_t len, uint8_t *buffer, size_t bufferSize);
 
 #endif
@@ -1,168 +1,186 @@
 #include "deepgram_client.h"
 #include "secrets.h"
+#include "deepgram_config.h"
+#include "http_connection_pool.h"
+#include "http_body_stream.h"
+#include "segment_stream.h"
+#include "adpcm_wav_stream.h"
 
 #include "esp_heap_caps.h"
 
-DeepgramClient::DeepgramClient(const char* api_key) : api_key(api_key), defaultLanguage("en-US"), stt_doc(nullptr), response_buffer(nullptr) {
-    // Constructor now only initializes variables, allocation is handled in begin()
+DeepgramClient::DeepgramClient(const char* api_key) : api_key(api_key), defaultLanguage("en-US"), sttAllocator(STT_DOC_BUDGET),
+                                                       stt_doc(&sttAllocator), lastConfidence(0.0f), uplinkKbps(0) {
+    // Constructor now only initializes variables, filters are built in begin()
 }
 
-DeepgramClient::~DeepgramClient() {
-    // Free memory
-    if (stt_doc) {
-        delete stt_doc;
+bool DeepgramClient::begin() {
+    // Only these fields are kept from a response (full responses carry per-word timings,
+    // paragraphs and metadata that grow with the audio length)
+    JsonObject alternative = transcriptFilter["results"]["channels"][0]["alternatives"][0].to<JsonObject>();
+    alternative["transcript"] = true;
+    alternative["confidence"] = true;
+
+    JsonObject search = searchFilter["results"]["channels"][0]["search"][0].to<JsonObject>();
+    search["query"] = true;
+    JsonObject hit = search["hits"][0].to<JsonObject>();
+    hit["confidence"] = true;
+    hit["start"] = true;
+    hit["end"] = true;
+    hit["snippet"] = true;
+
+    if (transcriptFilter.overflowed() || searchFilter.overflowed()) {
+        Serial.println("FATAL: Failed to allocate Deepgram response filters!");
+        return false;
     }
-    if (response_buffer) {
-        free(response_buffer);
+    return true;
+}
+
+void DeepgramClient::logAudioQuality(const AudioWindowStats* stats) {
+    if (!stats || stats->samples == 0) {
+        return;
     }
+    Serial.printf("Audio quality: %.1f%% silent, %.1f%% clipped, peak %ld, RMS %.0f, %lu zero crossings/s, %lu samples\n",
+                  stats->quietPercent(), stats->clippedPercent(), (long)stats->peak, stats->rms(),
+                  (unsigned long)((uint64_t)stats->zeroCrossings * 16000 / stats->samples), (unsigned long)stats->samples);
 }
 
-bool DeepgramClient::begin() {
-    // Allocate memory in PSRAM
-    stt_doc = new DynamicJsonDocument(STT_DOC_SIZE);
-    response_buffer = (char*)ps_malloc(RESPONSE_BUFFER_SIZE);
+UploadCodec DeepgramClient::chooseUploadCodec(size_t pcmBytes) const {
+    if (DEEPGRAM_UPLOAD_CODEC != UploadCodec::AUTO) {
+        return DEEPGRAM_UPLOAD_CODEC;
+    }
+    if (uplinkKbps == 0) {
+        return UploadCodec::PCM;
+    }
+    // Expected time on the wire for the PCM body (kbps = bits per ms)
+    uint64_t pcmMs = (uint64_t)pcmBytes * 8 / uplinkKbps;
+    return pcmMs > DEEPGRAM_ADPCM_ABOVE_UPLOAD_MS ? UploadCodec::IMA_ADPCM : UploadCodec::PCM;
+}
 
-    if (!stt_doc || !response_buffer) {
-        Serial.println("FATAL: Failed to allocate memory for DeepgramClient in PSRAM!");
-        return false;
+void DeepgramClient::recordUpload(size_t bytes, unsigned long transferMs) {
+    if (transferMs < 20) {
+        return;  // Fit in the socket buffers - says nothing about the link
     }
-    return true;
+    uint32_t kbps = (uint32_t)((uint64_t)bytes * 8 / transferMs);
+    uplinkKbps = uplinkKbps ? (uplinkKbps * 3 + kbps) / 4 : kbps;
 }
 
-uint8_t* DeepgramClient::createWAVData(const uint8_t* pcm_data, size_t pcm_size, size_t* wav_size) {
-    // Calculate WAV file size
-    size_t wav_data_size = sizeof(WAVHeader) + pcm_size;
-    *wav_size = wav_data_size;
-    
-    // Allocate memory for WAV data
-    uint8_t* wav_data = (uint8_t*)ps_malloc(wav_data_size);
-    if (!wav_data) {
-        Serial.println("Failed to allocate memory for WAV data");
-        return nullptr;
+int DeepgramClient::postAudio(HTTPClient& http, const PcmSegment* segments, int segmentCount, size_t pcm_size,
+                              uint32_t sampleRate) {
+    http.addHeader("Content-Type", "audio/wav");
+    
+    if (chooseUploadCodec(pcm_size) == UploadCodec::IMA_ADPCM) {
+        // Encoded block by block while HTTPClient pulls the body
+        AdpcmWavStream body(segments, segmentCount, sampleRate);
+        int httpCode = http.sendRequest("POST", &body, body.size());
+        recordUpload(body.size(), body.getTransferMs());
+        Serial.printf("🗜️ IMA-ADPCM upload: %u -> %u bytes (%.0f%%), encode %u us, %lu ms on the wire, uplink ~%u kbps\n",
+                      sizeof(WAVHeader) + pcm_size, body.size(), body.size() * 100.0f / (sizeof(WAVHeader) + pcm_size),
+                      body.getEncodeMicros(), body.getTransferMs(), uplinkKbps);
+        return httpCode;
     }
     
     // Create WAV header
     WAVHeader header;
-    header.chunk_size = wav_data_size - 8;
+    header.chunk_size = sizeof(WAVHeader) + pcm_size - 8;
     header.data_size = pcm_size;
-    header.sample_rate = 16000;
-    header.byte_rate = 16000 * 2;
+    header.sample_rate = sampleRate;
+    header.byte_rate = sampleRate * 2;
     header.block_align = 2;
     
-    // Copy header and PCM data
-    memcpy(wav_data, &header, sizeof(WAVHeader));
-    memcpy(wav_data + sizeof(WAVHeader), pcm_data, pcm_size);
-    
-    // Basic audio quality check - look for silence or clipping
-    int16_t* samples = (int16_t*)pcm_data;
-    int sample_count = pcm_size / 2;
-    int silent_samples = 0;
-    int clipped_samples = 0;
-    
-    for (int i = 0; i < sample_count; i++) {
-        int16_t sample = samples[i];
-        if (abs(sample) < 100) { // Very quiet
-            silent_samples++;
-        }
-        if (abs(sample) > 30000) { // Near clipping
-            clipped_samples++;
-        }
+    // Header and PCM go out back to back from their own buffers - no WAV copy in PSRAM
+    SegmentStream body;
+    body.add(&header, sizeof(WAVHeader));
+    for (int i = 0; i < segmentCount; i++) {
+        body.add(segments[i].data, segments[i].size);
     }
-    
-    float silence_percent = (float)silent_samples / sample_count * 100.0f;
-    float clipping_percent = (float)clipped_samples / sample_count * 100.0f;
-    
-    Serial.printf("Audio quality: %.1f%% silent, %.1f%% clipped, %d samples\n", 
-                  silence_percent, clipping_percent, sample_count);
-    
-    return wav_data;
+    int httpCode = http.sendRequest("POST", &body, body.size());
+    recordUpload(body.size(), body.getTransferMs());
+    Serial.printf("📤 PCM upload: %u bytes, %lu ms on the wire, uplink ~%u kbps\n",
+                  body.size(), body.getTransferMs(), uplinkKbps);
+    return httpCode;
 }
 
-String DeepgramClient::extractTranscript(const String& response) {
-    if (response.isEmpty() || !stt_doc) {
-        return "";
-    }
-    
-    // Use a larger document size to handle the deeply nested Deepgram response
-    stt_doc->clear();
-    
-    // Increase capacity for the complex Deepgram response structure
-    DeserializationError error = deserializeJson(*stt_doc, response);
-    
-    if (error) {
-        Serial.printf("  %s\n", error.c_str());
-        
-        // Try manual extraction as fallback
-        int transcriptStart = response.indexOf("\"transcript\":\"");
-        if (transcriptStart != -1) {
-            transcriptStart += 14; // Length of "\"transcript\":\""
-            int transcriptEnd = response.indexOf("\"", transcriptStart);
-            if (transcriptEnd != -1) {
-                String transcript = response.substring(transcriptStart, transcriptEnd);
-                Serial.println("Manual extraction successful: " + transcript);
-                return transcript;
-            }
+int DeepgramClient::postAudioRequest(HTTPClient& http, WiFiClient*& client, const String& url,
+                                     const PcmSegment* segments, int segmentCount, size_t pcm_size, uint32_t sampleRate) {
+    HttpConnectionPool& pool = HttpConnectionPool::shared();
+    bool reused = false;
+    client = pool.acquire(url, HttpConnectionPool::CONNECT_TIMEOUT, &reused);
+    http.setReuse(true);
+    while (true) {
+        if (!client) {
+            return HTTPC_ERROR_CONNECTION_REFUSED;
         }
-        
-        Serial.println("Failed to extract transcript manually");
-        return "";
-    }
-    
-    // Extract transcript from Deepgram response format
-    if (stt_doc->containsKey("results") && (*stt_doc)["results"].containsKey("channels") &&
-        (*stt_doc)["results"]["channels"].size() > 0) {
-        JsonArray alternatives = (*stt_doc)["results"]["channels"][0]["alternatives"];
-        if (alternatives.size() > 0) {
-            String transcript = alternatives[0]["transcript"].as<String>();
-            return transcript;
+        if (!http.begin(*client, url)) {
+            pool.release(client, false);
+            client = nullptr;
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+        http.addHeader("Authorization", "Token " + String(DEEPGRAM_API_KEY));
+        HttpBodyStream::prepare(http);
+
+        // Set timeout for large audio files
+        http.setTimeout(10000); // 10 seconds
+
+        int httpCode = postAudio(http, segments, segmentCount, pcm_size, sampleRate);
+        if (!pool.shouldRetryFresh(reused, httpCode)) {
+            return httpCode;
         }
+        http.end();
+        pool.release(client, false);
+        client = pool.acquireFresh(url);
+        reused = false;
     }
-    
-    // If extraction failed, return empty string
-    Serial.println("Could not extract transcript from response");
-    return "";
 }
 
-bool DeepgramClient::extractSearchResults(const String& response, const String& searchTerm, float minConfidence) {
-    if (response.isEmpty() || !stt_doc) {
-        return false;
-    }
-    
-    stt_doc->clear();
-    DeserializationError error = deserializeJson(*stt_doc, response);
-    
+bool DeepgramClient::parseResponse(Stream& body, const JsonDocument& filter) {
+    stt_doc.clear();
+    DeserializationError error = deserializeJson(stt_doc, body, DeserializationOption::Filter(filter));
     if (error) {
-        Serial.printf("JSON parsing error for search results: %s\n", error.c_str());
+        Serial.printf("❌ Deepgram response parse error: %s (document %u/%u bytes)\n",
+                      error.c_str(), sttAllocator.getUsed(), STT_DOC_BUDGET);
         return false;
     }
-    
+    return true;
+}
+
+String DeepgramClient::extractTranscript() {
+    // Extract transcript from Deepgram response format
+    JsonObject alternative = stt_doc["results"]["channels"][0]["alternatives"][0];
+    if (alternative.isNull()) {
+        Serial.println("Could not extract transcript from response");
+        return "";
+    }
+
+    lastConfidence = alternative["confidence"] | 0.0f;
+    String transcript = alternative["transcript"].as<String>();
+    Serial.printf("Transcript confidence: %.3f\n", lastConfidence);
+    return transcript;
+}
+
+bool DeepgramClient::extractSearchResults(const String& searchTerm, float minConfidence) {
     // Extract search results from Deepgram response format
-    if (stt_doc->containsKey("results") && (*stt_doc)["results"].containsKey("channels") &&
-        (*stt_doc)["results"]["channels"].size() > 0) {
-        
-        JsonArray searches = (*stt_doc)["results"]["channels"][0]["search"];
+    JsonArray searches = stt_doc["results"]["channels"][0]["search"];
+    
+    for (JsonObject search : searches) {
+        String query = search["query"].as<String>();
         
-        for (JsonObject search : searches) {
-            String query = search["query"].as<String>();
+        // Check if this search matches our search term (case insensitive)
+        if (query.equalsIgnoreCase(searchTerm)) {
+            JsonArray hits = search["hits"];
             
-            // Check if this search matches our search term (case insensitive)
-            if (query.equalsIgnoreCase(searchTerm)) {
-                JsonArray hits = search["hits"];
+            for (JsonObject hit : hits) {
+                float confidence = hit["confidence"].as<float>();
+                float start = hit["start"].as<float>();
+                float end = hit["end"].as<float>();
+                String snippet = hit["snippet"].as<String>();
                 
-                for (JsonObject hit : hits) {
-                    float confidence = hit["confidence"].as<float>();
-                    float start = hit["start"].as<float>();
-                    float end = hit["end"].as<float>();
-                    String snippet = hit["snippet"].as<String>();
-                    
-                    Serial.printf("🔍 Search hit for '%s': confidence=%.3f, time=%.1f-%.1fs, snippet='%s'\n", 
-                                 query.c_str(), confidence, start, end, snippet.c_str());
-                    
-                    if (confidence >= minConfidence) {
-                        Serial.printf("✅ Wake word '%s' detected with confidence %.3f (threshold: %.3f)\n", 
-                                     query.c_str(), confidence, minConfidence);
-                        return true;
-                    }
+                Serial.printf("🔍 Search hit for '%s': confidence=%.3f, time=%.1f-%.1fs, snippet='%s'\n", 
+                             query.c_str(), confidence, start, end, snippet.c_str());
+                
+                if (confidence >= minConfidence) {
+                    Serial.printf("✅ Wake word '%s' detected with confidence %.3f (threshold: %.3f)\n", 
+                                 query.c_str(), confidence, minConfidence);
+                    return true;
                 }
             }
         }
@@ -171,15 +189,28 @@ bool DeepgramClient::extractSearchResults(const String& response, const String&
     return false;
 }
 
-String DeepgramClient::transcribe(const uint8_t* audio_data, size_t data_size) {
-    return transcribe(audio_data, data_size, defaultLanguage);
+String DeepgramClient::transcribe(const uint8_t* audio_data, size_t data_size, const AudioWindowStats* stats) {
+    return transcribe(audio_data, data_size, defaultLanguage, stats);
+}
+
+String DeepgramClient::transcribe(const uint8_t* audio_data, size_t data_size, const String& language,
+                                  const AudioWindowStats* stats) {
+    PcmSegment segment = {audio_data, data_size};
+    return transcribe(&segment, 1, language, stats);
 }
 
-String DeepgramClient::transcribe(const uint8_t* audio_data, size_t data_size, const String& language) {
+String DeepgramClient::transcribe(const PcmSegment* segments, int segmentCount, const String& language,
+                                  const AudioWindowStats* stats) {
     String response = "";
     
     // Validate input data
-    if (!audio_data || data_size == 0) {
+    size_t data_size = 0;
+    if (segments && segmentCount > 0 && segmentCount <= MAX_PCM_SEGMENTS && segments[0].data) {
+        for (int i = 0; i < segmentCount; i++) {
+            data_size += segments[i].size;
+        }
+    }
+    if (data_size == 0) {
         Serial.println("Invalid audio data provided to transcribe");
         return response;
     }
@@ -189,63 +220,42 @@ String DeepgramClient::transcribe(const uint8_t* audio_data, size_t data_size, c
         return response;
     }
 
-    // Convert raw PCM to WAV format
-    size_t wav_size;
-    uint8_t* wav_data = createWAVData(audio_data, data_size, &wav_size);
-    if (!wav_data) {
-        Serial.println("Failed to create WAV data");
-        return response;
-    }
-    
-    // Calculate a simple checksum to track unique audio samples
-    uint32_t audio_checksum = 0;
-    for (size_t i = 0; i < min(data_size, (size_t)1000); i += 4) {
-        audio_checksum ^= *(uint32_t*)(audio_data + i);
-    }
+    logAudioQuality(stats);
     
-    Serial.printf("Sending %d bytes of WAV data to Deepgram (PCM: %d bytes, checksum: %08X, language: %s)\n", 
-                  wav_size, data_size, audio_checksum, language.c_str());
+    // The capture fingerprint tells recordings apart in the logs
+    Serial.printf("Sending %d bytes of WAV data to Deepgram (PCM: %d bytes in %d segments, fingerprint: %08X, language: %s)\n", 
+                  sizeof(WAVHeader) + data_size, data_size, segmentCount, stats ? stats->fingerprint : 0, language.c_str());
     
     // Build URL with language parameter
-    String deepgramUrl = "https://api.deepgram.com/v1/listen?model=nova-2&smart_format=true";
+    String deepgramUrl = String(DEEPGRAM_BASE_URL) + "/v1/listen?model=nova-2&smart_format=true";
     if (!language.isEmpty() && language != "en-US") {
         deepgramUrl += "&language=" + language;
     }
     
     HTTPClient http;
-    WiFiClientSecure client;
-    client.setInsecure();
-    if (http.begin(client, deepgramUrl)) {
-        http.addHeader("Authorization", "Token " + String(DEEPGRAM_API_KEY));
-        http.addHeader("Content-Type", "audio/wav");
-        
-        // Set timeout for large audio files
-        http.setTimeout(10000); // 10 seconds
-
-        int httpCode = http.POST(wav_data, wav_size);
-
+    WiFiClient* client = nullptr;
+    bool reusable = false;
+    int httpCode = postAudioRequest(http, client, deepgramUrl, segments, segmentCount, data_size);
+    if (client) {
         if (httpCode > 0) {
             if (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_CREATED) {
-                int len = http.getSize();
-                WiFiClient* stream = http.getStreamPtr();
-                if (response_buffer) {
-                    int read = stream->readBytes(response_buffer, min(len, (int)RESPONSE_BUFFER_SIZE - 1));
-                    response_buffer[read] = '\0';
+                // Parse straight from the socket - no response buffer, no size limit
+                HttpBodyStream body(http, client);
+                if (parseResponse(body, transcriptFilter)) {
                     Serial.println("✅ Deepgram transcription successful");
-                } else {
-                    Serial.println("❌ Response buffer not allocated!");
-                }
-                
-                // Extract transcript from JSON response
-                String transcript = extractTranscript(response_buffer);
-                if (!transcript.isEmpty()) {
-                    response = transcript;
-                } else {
-                    Serial.println("No transcript found in response");
+                    String transcript = extractTranscript();
+                    if (!transcript.isEmpty()) {
+                        response = transcript;
+                    } else {
+                        Serial.println("No transcript found in response");
+                    }
                 }
+                body.discardRemaining();
+                reusable = body.isComplete();
             } else {
                 Serial.printf("❌ HTTP Error Code: %d\n", httpCode);
                 String error_response = http.getString();
+                reusable = true;
                 Serial.println("Error Response: " + error_response);
                 Serial.printf("[HTTP] POST... failed, error: %s\n", http.errorToString(httpCode).c_str());
             }
@@ -256,10 +266,8 @@ String DeepgramClient::transcribe(const uint8_t* audio_data, size_t data_size, c
     } else {
         Serial.printf("❌ [HTTP] Unable to connect to Deepgram\n");
     }
+    HttpConnectionPool::shared().release(client, reusable);
     
-    // Free the WAV data
-    free(wav_data);
-
     return response;
 }
 
@@ -268,9 +276,22 @@ void DeepgramClient::setDefaultLanguage(const String& language) {
     Serial.printf("DeepgramClient default language set to: %s\n", language.c_str());
 }
 
-bool DeepgramClient::searchForWakeWords(const uint8_t* audio_data, size_t data_size, const char* wakeWords[], int wakeWordCount, float minConfidence) {
+bool DeepgramClient::searchForWakeWords(const uint8_t* audio_data, size_t data_size, const char* wakeWords[], int wakeWordCount, float minConfidence,
+                                        const AudioWindowStats* stats, uint32_t sampleRate) {
+    PcmSegment segment = {audio_data, data_size};
+    return searchForWakeWords(&segment, 1, wakeWords, wakeWordCount, minConfidence, stats, sampleRate);
+}
+
+bool DeepgramClient::searchForWakeWords(const PcmSegment* segments, int segmentCount, const char* wakeWords[], int wakeWordCount, float minConfidence,
+                                        const AudioWindowStats* stats, uint32_t sampleRate) {
     // Validate input data
-    if (!audio_data || data_size == 0 || !wakeWords || wakeWordCount == 0) {
+    size_t data_size = 0;
+    if (segments && segmentCount > 0 && segmentCount <= MAX_PCM_SEGMENTS && segments[0].data) {
+        for (int i = 0; i < segmentCount; i++) {
+            data_size += segments[i].size;
+        }
+    }
+    if (data_size == 0 || !wakeWords || wakeWordCount == 0) {
         Serial.println("Invalid parameters for wake word search");
         return false;
     }
@@ -280,16 +301,10 @@ bool DeepgramClient::searchForWakeWords(const uint8_t* audio_data, size_t data_s
         return false;
     }
 
-    // Convert raw PCM to WAV format
-    size_t wav_size;
-    uint8_t* wav_data = createWAVData(audio_data, data_size, &wav_size);
-    if (!wav_data) {
-        Serial.println("Failed to create WAV data for wake word search");
-        return false;
-    }
+    logAudioQuality(stats);
     
     // Build URL with search parameters for wake words
-    String deepgramUrl = "https://api.deepgram.com/v1/listen?model=nova-2";
+    String deepgramUrl = String(DEEPGRAM_BASE_URL) + "/v1/listen?model=nova-2";
     
     // Add search parameters for each wake word
     for (int i = 0; i < wakeWordCount; i++) {
@@ -310,36 +325,27 @@ bool DeepgramClient::searchForWakeWords(const uint8_t* audio_data, size_t data_s
     bool wakeWordFound = false;
     
     HTTPClient http;
-    WiFiClientSecure client;
-    client.setInsecure();
-    if (http.begin(client, deepgramUrl)) {
-        http.addHeader("Authorization", "Token " + String(DEEPGRAM_API_KEY));
-        http.addHeader("Content-Type", "audio/wav");
-        
-        // Set timeout for audio processing
-        http.setTimeout(10000); // 10 seconds
-
-        int httpCode = http.POST(wav_data, wav_size);
-
+    WiFiClient* client = nullptr;
+    bool reusable = false;
+    int httpCode = postAudioRequest(http, client, deepgramUrl, segments, segmentCount, data_size, sampleRate);
+    if (client) {
         if (httpCode > 0) {
             if (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_CREATED) {
-                int len = http.getSize();
-                WiFiClient* stream = http.getStreamPtr();
-                if (response_buffer) {
-                    int read = stream->readBytes(response_buffer, min(len, (int)RESPONSE_BUFFER_SIZE - 1));
-                    response_buffer[read] = '\0';
+                // Parse straight from the socket - no response buffer, no size limit
+                HttpBodyStream body(http, client);
+                if (parseResponse(body, searchFilter)) {
                     Serial.println("✅ Deepgram search request successful");
-                } else {
-                    Serial.println("❌ Response buffer not allocated!");
-                }
-                
-                // Check each wake word for matches
-                for (int i = 0; i < wakeWordCount && !wakeWordFound; i++) {
-                    if (extractSearchResults(response_buffer, String(wakeWords[i]), minConfidence)) {
-                        wakeWordFound = true;
-                        break;
+                    
+                    // Check each wake word for matches
+                    for (int i = 0; i < wakeWordCount && !wakeWordFound; i++) {
+                        if (extractSearchResults(String(wakeWords[i]), minConfidence)) {
+                            wakeWordFound = true;
+                            break;
+                        }
                     }
                 }
+                body.discardRemaining();
+                reusable = body.isComplete();
                 
                 if (!wakeWordFound) {
                     Serial.println("🔍 No wake words found above confidence threshold");
@@ -347,6 +353,7 @@ bool DeepgramClient::searchForWakeWords(const uint8_t* audio_data, size_t data_s
             } else {
                 Serial.printf("❌ HTTP Error Code: %d\n", httpCode);
                 String error_response = http.getString();
+                reusable = true;
                 Serial.println("Error Response: " + error_response);
             }
         } else {
@@ -356,9 +363,7 @@ bool DeepgramClient::searchForWakeWords(const uint8_t* audio_data, size_t data_s
     } else {
         Serial.printf("❌ [HTTP] Unable to connect to Deepgram for wake word search\n");
     }
+    HttpConnectionPool::shared().release(client, reusable);
     
-    // Free the WAV data
-    free(wav_data);
-
     return wakeWordFound;
 }
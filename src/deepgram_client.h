@@ -3,6 +3,10 @@
 
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include "pcm_segment.h"
+#include "audio_stats.h"
+#include "deepgram_config.h"
+#include "psram_allocator.h"
 
 struct WAVHeader {
     char riff[4] = {'R', 'I', 'F', 'F'};
@@ -24,31 +28,61 @@ class DeepgramClient {
 private:
     const char* api_key;
     String defaultLanguage;
-    DynamicJsonDocument* stt_doc;
-    char* response_buffer;
+    BoundedSpiRamAllocator sttAllocator;
+    JsonDocument stt_doc;               // Filtered response - bounded by STT_DOC_BUDGET
+    JsonDocument transcriptFilter;
+    JsonDocument searchFilter;
+    float lastConfidence;
+    uint32_t uplinkKbps;        // Smoothed upload throughput, 0 until the first upload
 
-    static const size_t STT_DOC_SIZE = 2048;
-    static const size_t RESPONSE_BUFFER_SIZE = 2048;
+    static const size_t STT_DOC_BUDGET = 16384;
+    static const int MAX_PCM_SEGMENTS = 3;
     
-    // Helper function to create WAV data from raw PCM
-    uint8_t* createWAVData(const uint8_t* pcm_data, size_t pcm_size, size_t* wav_size);
+    // Log silence/clipping statistics for the audio about to be uploaded (measured at capture)
+    void logAudioQuality(const AudioWindowStats* stats);
     
-    // Helper function to extract transcript from Deepgram response
-    String extractTranscript(const String& response);
+    // Pick PCM or ADPCM for an upload of pcmBytes from DEEPGRAM_UPLOAD_CODEC and the measured uplink
+    UploadCodec chooseUploadCodec(size_t pcmBytes) const;
+    void recordUpload(size_t bytes, unsigned long transferMs);
     
-    // Helper function to extract search results from Deepgram response
+    // POST the segments as a WAV file straight from their buffers (encoding on the fly for ADPCM)
+    int postAudio(HTTPClient& http, const PcmSegment* segments, int segmentCount, size_t pcm_size,
+                  uint32_t sampleRate = 16000);
+    
+    // Open a pooled connection and POST the audio, retrying once on a new connection if a kept-alive
+    // one turned out to be stale. client is the connection in use (nullptr if none could be opened);
+    // release it to the pool after http.end().
+    int postAudioRequest(HTTPClient& http, WiFiClient*& client, const String& url, const PcmSegment* segments,
+                         int segmentCount, size_t pcm_size, uint32_t sampleRate = 16000);
+    
+    // Parse the response body straight from the socket, keeping only the fields in the filter
+    bool parseResponse(Stream& body, const JsonDocument& filter);
+    
+    // Helper function to extract transcript from the parsed response
+    String extractTranscript();
+    
+    // Helper function to extract search results from the parsed response
     // TODO INCREASE CONFIDENCE
-    bool extractSearchResults(const String& response, const String& searchTerm, float minConfidence = 0.80f);
+    bool extractSearchResults(const String& searchTerm, float minConfidence = 0.80f);
 
 public:
     DeepgramClient(const char* api_key);
-    ~DeepgramClient();
     bool begin();
-    String transcribe(const uint8_t* audio_data, size_t data_size);
-    String transcribe(const uint8_t* audio_data, size_t data_size, const String& language);
     
-    // Search for specific terms/phrases in audio (for wake word detection)
-    bool searchForWakeWords(const uint8_t* audio_data, size_t data_size, const char* wakeWords[], int wakeWordCount, float minConfidence = 0.5);
+    // stats: capture statistics of the audio, for the quality log (optional)
+    String transcribe(const uint8_t* audio_data, size_t data_size, const AudioWindowStats* stats = nullptr);
+    String transcribe(const uint8_t* audio_data, size_t data_size, const String& language, const AudioWindowStats* stats = nullptr);
+    String transcribe(const PcmSegment* segments, int segmentCount, const String& language, const AudioWindowStats* stats = nullptr);
+    
+    // Search for specific terms/phrases in audio (for wake word detection); sampleRate is the rate
+    // of the PCM passed in
+    bool searchForWakeWords(const uint8_t* audio_data, size_t data_size, const char* wakeWords[], int wakeWordCount, float minConfidence = 0.5,
+                            const AudioWindowStats* stats = nullptr, uint32_t sampleRate = 16000);
+    bool searchForWakeWords(const PcmSegment* segments, int segmentCount, const char* wakeWords[], int wakeWordCount, float minConfidence = 0.5,
+                            const AudioWindowStats* stats = nullptr, uint32_t sampleRate = 16000);
+    
+    // Confidence Deepgram reported for the last transcript
+    float getLastConfidence() const { return lastConfidence; }
     
     // Set default language for transcription
     void setDefaultLanguage(const String& language);
@@ -0,0 +1,24 @@
+#ifndef DEEPGRAM_CONFIG_H
+#define DEEPGRAM_CONFIG_H
+
+#include <Arduino.h>
+
+// Base URL for the Deepgram STT (/v1/listen) and TTS (/v1/speak) endpoints. Point it at a local
+// stand-in server (e.g. tools/deepgram_mock at "http://192.168.1.50:8080") to run the audio paths
+// without the real service; plain http:// base URLs skip TLS.
+const char* const DEEPGRAM_BASE_URL = "https://api.deepgram.com";
+
+// Audio encoding for STT and wake word uploads. IMA-ADPCM is ~4x smaller than 16-bit PCM (about
+// 26-30 dB SNR on 16 kHz speech, 18 dB on the 8 kHz wake word ring - tools/bench/adpcm_codec_bench),
+// but its effect on Deepgram's accuracy hasn't been measured, so PCM is the default and ADPCM is
+// opt-in. AUTO sends ADPCM only when the PCM body would take longer than the budget at the measured
+// uplink (a 480 KB command needs ~3.8 Mbps to stay under 1 s).
+enum class UploadCodec {
+    PCM,
+    IMA_ADPCM,
+    AUTO
+};
+const UploadCodec DEEPGRAM_UPLOAD_CODEC = UploadCodec::PCM;
+const unsigned long DEEPGRAM_ADPCM_ABOVE_UPLOAD_MS = 1000;
+
+#endif
@@ -4,10 +4,27 @@
 #include <Arduino.h>
 #include "secrets.h"
 
+// Gemini Live endpoint. To run against a local stand-in server instead (tools/gemini_standin),
+// point host/port at it and turn SSL off (the path is sent as-is, so the stand-in can ignore the key parameter).
 const char* const WS_HOST = "generativelanguage.googleapis.com";
 const int   WS_PORT = 443;
+const bool  WS_USE_SSL = true;
 const String WS_PATH = "/ws/google.ai.generativelanguage.v1beta.GenerativeService.BidiGenerateContent?key=" + String(GEMINI_API_KEY);
 
+// Native audio mode: Gemini speaks its replies directly (PCM streamed over the WebSocket)
+// instead of returning text that has to be synthesized by Deepgram TTS.
+const bool GEMINI_NATIVE_AUDIO = false;
+const int  GEMINI_AUDIO_SAMPLE_RATE = 24000; // Live API audio output is 16-bit PCM at 24 kHz
+
+// Audio command mode: recorded voice commands are streamed to Gemini as 16 kHz PCM realtimeInput
+// instead of being transcribed by Deepgram first. Wake word detection still uses Deepgram.
+const bool GEMINI_AUDIO_COMMANDS = false;
+
+// Server-side context compression: once the session context reaches the trigger size the oldest
+// turns are dropped down to the target, so long-running sessions don't grow without bound.
+const long GEMINI_CONTEXT_TRIGGER_TOKENS = 25600;
+const long GEMINI_CONTEXT_TARGET_TOKENS = 12800;
+
 // const char* const SYSTEM_PROMPT = "You are a vision assistant that analyzes camera frames. Be very brief in your responses, describing what you see in just a few words.";
 
 // "VOICE COMMANDS (after Hey Centra):
@@ -20,91 +37,7 @@ const String WS_PATH = "/ws/google.ai.generativelanguage.v1beta.GenerativeServic
 
 // TODO configure examples
 
-const char* const SYSTEM_PROMPT = R"(You are an embedded assistant for a wearable device that helps blind or visually impaired users. You receive camera frames and user voice commands. You MUST respond only with a call to the 'systemAction' function.
-
-BEHAVIORAL RULES:
-- ALWAYS be concise, calm, and relevant.
-- You MUST only respond with a valid 'systemAction' function call. Never output natural language.
-- Use the 'shouldSpeak' parameter to control when the device speaks to the user.
-- Speak only when it improves safety, provides helpful context, or is a direct response to a user's command.
-- For silent actions, set 'shouldSpeak' to 'false' and provide a 'logEntry'.
-- If you already responded to a direct request/command or spoke a message, do NOT speak the same message again in response to the same thing.
-
-DANGER DETECTION (intent=obstacle_alert):
-- If a cyclist is approaching: Call 'systemAction' with intent='obstacle_alert', shouldSpeak=true, message='Warning. Someone is biking toward you.'
-- If approaching stairs/drop: Call 'systemAction' with intent='obstacle_alert', shouldSpeak=true, message='Caution. Stairs ahead.'
-- If a head-level obstacle is ahead: Call 'systemAction' with intent='obstacle_alert', shouldSpeak=true, message='Watch out. Head-level obstacle.'
-
-CONTEXT-AWARE ASSISTANCE (intent=contextual_assistance):
-- At a crosswalk with active traffic: Call 'systemAction' with intent='contextual_assistance', shouldSpeak=true, message='You are at a crosswalk. Wait, traffic is active.'
-- When it is safe to cross: Call 'systemAction' with intent='contextual_assistance', shouldSpeak=true, message='It is safe to cross now.'
-
-USER VOICE COMMANDS/QUERIES (intent=voice_query):
-- **CRITICAL**: ALWAYS respond to user voice commands by calling 'systemAction' with 'shouldSpeak' set to 'true'.
-- Examples:
-  * 'What do you see?' -> Call 'systemAction' with intent='voice_query', shouldSpeak=true, message='I see [description of current view].'
-  * 'Remember my keys are on the table' -> Call 'systemAction' with intent='memory_store', shouldSpeak=true, message='I will remember your keys are on the table.', logEntry='User stored memory: keys on table.'
-  * 'Where did I put my wallet?' -> Call 'systemAction' with intent='voice_query', shouldSpeak=true, message='You put your wallet [location if known, or I do not have that information stored].'
-  * 'Where is the nearest park?' -> Call 'getDirections' with destination='nearest park'.
-
-FALLS & EMERGENCIES (intent=emergency_protocol):
-- Fall detected: Call 'systemAction' with intent='emergency_protocol', shouldSpeak=true, message='Fall detected. Are you okay? Contacting your companion.'
-- Medical emergency: Call 'systemAction' with intent='emergency_protocol', shouldSpeak=true, message='Medical emergency detected. Getting help.'
-- User calls for help: Call 'systemAction' with intent='emergency_protocol', shouldSpeak=true, message='Emergency alert sent. Help is on the way.'
-- User unresponsive after fall: Call 'systemAction' with intent='emergency_protocol', shouldSpeak=true, message='User unresponsive. Contacting your companion.'
-- Panic situation: Call 'systemAction' with intent='emergency_protocol', shouldSpeak=true, message='Panic alert activated. Notifying your companion.'
--> Always use emergency_protocol intent for serious situations requiring immediate assistance. The system will automatically determine alert type and send notifications.
-
-HAND GESTURES (intent=hand_gesture):
-- When a hand gesture is detected (e.g., thumbs up): Call 'systemAction' with intent='hand_gesture', shouldSpeak=true, message='I see a thumbs up.'
-
-PASSIVE LOGGING (DO NOT SPEAK):
-- For minor events or location updates that don't require user notification: Call 'systemAction' with intent='log', shouldSpeak=false, logEntry='[Description of event].'
-)";
-
-const char* const TOOLS_JSON = R"({
-  "function_declarations": [
-    {
-      "name": "systemAction",
-      "description": "The single tool for all system operations, including speaking, logging, and handling intents. Use this for all responses.",
-      "parameters": {
-        "type": "object",
-        "properties": {
-          "intent": {
-            "type": "string",
-            "description": "The main intent or action. Examples: obstacle_alert, voice_query, memory_store, emergency_protocol, contextual_assistance, hand_gesture, log."
-          },
-          "shouldSpeak": {
-            "type": "boolean",
-            "description": "Set to true to speak the 'message' to the user. Set to false for silent actions."
-          },
-          "message": {
-            "type": "string",
-            "description": "The message to speak if shouldSpeak is true. Also used for logging."
-          },
-          "logEntry": {
-            "type": "string",
-            "description": "A detailed log message for internal history or debugging."
-          }
-        },
-        "required": ["intent", "shouldSpeak"]
-      }
-    },
-    {
-      "name": "getDirections",
-      "description": "Get directions to a destination.",
-      "parameters": {
-        "type": "object",
-        "properties": {
-          "destination": {
-            "type": "string",
-            "description": "The destination to get directions to."
-          }
-        },
-        "required": ["destination"]
-      }
-    }
-  ]
-})";
+// The system prompt and tool declarations live in prompts/ and are compiled into a
+// flash-resident setup message by scripts/generate_setup_message.py (see setup_message.h).
 
 #endif
@@ -0,0 +1,77 @@
+#include "gemini_socket.h"
+
+GeminiSocket::GeminiSocket() : fragmentLength(0), fragmentIsFirst(true), fragmentOk(true), messageLength(0), sentStats() {
+}
+
+void GeminiSocket::beginText() {
+    fragmentLength = 0;
+    fragmentIsFirst = true;
+    fragmentOk = isConnected();
+    messageLength = 0;
+}
+
+bool GeminiSocket::writeText(const char* data, size_t length) {
+    while (fragmentOk && length > 0) {
+        if (fragmentLength == FRAGMENT_SIZE) {
+            flushFragment(false);
+            continue;
+        }
+        size_t chunk = min(FRAGMENT_SIZE - fragmentLength, length);
+        memcpy(fragmentBuffer + WEBSOCKETS_MAX_HEADER_SIZE + fragmentLength, data, chunk);
+        fragmentLength += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return fragmentOk;
+}
+
+bool GeminiSocket::writeText(const char* data) {
+    return writeText(data, strlen(data));
+}
+
+bool GeminiSocket::endText() {
+    if (fragmentOk) {
+        flushFragment(true);
+    }
+    if (fragmentOk) {
+        sentStats.record(messageLength);
+    }
+    return fragmentOk;
+}
+
+bool GeminiSocket::flushFragment(bool fin) {
+    // First frame carries the text opcode, the rest are continuations of the same message
+    WSopcode_t opcode = fragmentIsFirst ? WSop_text : WSop_continuation;
+    messageLength += fragmentLength;
+    fragmentOk = sendFrame(&_client, opcode, fragmentBuffer, fragmentLength, fin, true);
+    fragmentIsFirst = false;
+    fragmentLength = 0;
+    return fragmentOk;
+}
+
+bool GeminiSocket::sendTXT(const char* payload, size_t length) {
+    if (length == 0) {
+        length = strlen(payload);
+    }
+    bool sent = WebSocketsClient::sendTXT(payload, length);
+    if (sent) {
+        sentStats.record(length);
+    }
+    return sent;
+}
+
+bool GeminiSocket::sendTXT(String& payload) {
+    bool sent = WebSocketsClient::sendTXT(payload);
+    if (sent) {
+        sentStats.record(payload.length());
+    }
+    return sent;
+}
+
+const MessageStats& GeminiSocket::getSentStats() const {
+    return sentStats;
+}
+
+void GeminiSocket::resetSentStats() {
+    sentStats = MessageStats();
+}
@@ -0,0 +1,57 @@
+#ifndef GEMINI_SOCKET_H
+#define GEMINI_SOCKET_H
+
+#include <Arduino.h>
+#include <WebSocketsClient.h>
+
+// Outgoing or incoming message counters for one reporting window
+struct MessageStats {
+    uint32_t messages;
+    uint32_t bytes;
+    uint32_t maxBytes;
+    
+    void record(size_t length) {
+        messages++;
+        bytes += length;
+        if (length > maxBytes) {
+            maxBytes = length;
+        }
+    }
+};
+
+// WebSocketsClient with support for sending one text message as several fragments.
+// Large constant payloads (like the setup message in flash) are copied through a small
+// fixed buffer instead of being assembled into a heap String first.
+class GeminiSocket : public WebSocketsClient {
+private:
+    static const size_t FRAGMENT_SIZE = 1024;
+    
+    // Reserved header space in front of the payload lets the library mask in place (no extra copy)
+    uint8_t fragmentBuffer[WEBSOCKETS_MAX_HEADER_SIZE + FRAGMENT_SIZE];
+    size_t fragmentLength;
+    bool fragmentIsFirst;
+    bool fragmentOk;
+    size_t messageLength;       // Bytes of the fragmented message so far
+    MessageStats sentStats;
+    
+    bool flushFragment(bool fin);
+
+public:
+    GeminiSocket();
+    
+    // Fragmented text message: begin, write any number of pieces, then end to send the final frame
+    void beginText();
+    bool writeText(const char* data, size_t length);
+    bool writeText(const char* data);
+    bool endText();
+    
+    // Counted wrappers for the sendTXT overloads used by VisionAssistant
+    bool sendTXT(const char* payload, size_t length = 0);
+    bool sendTXT(String& payload);
+    
+    // Sent message counters (reset by the caller at the end of each reporting window)
+    const MessageStats& getSentStats() const;
+    void resetSentStats();
+};
+
+#endif
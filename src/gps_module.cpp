@@ -11,6 +11,9 @@ GPSModule::GPSModule() : gpsSerial(2) {
     currentData.timestamp = 0;
     currentData.dateTime = "";
     lastValidFix = 0;
+    dataPending = false;
+    dataGroup = nullptr;
+    dataBits = 0;
 }
 
 GPSModule::~GPSModule() {
@@ -26,6 +29,9 @@ bool GPSModule::initialize() {
     gpsSerial.begin(GPS_BAUD_RATE, SERIAL_8N1, GPS_RX_PIN, GPS_TX_PIN);
     Serial.println("GPS Serial started at 9600 baud rate");
     
+    // One callback per NMEA burst (after the line goes idle), from the UART event task
+    gpsSerial.onReceive([this]() { onUartData(); }, true);
+    
     // Wait longer for GPS to initialize
     Serial.println("Waiting for GPS module to stabilize...");
     delay(2000);
@@ -77,6 +83,24 @@ bool GPSModule::initialize() {
     }
 }
 
+void GPSModule::onUartData() {
+    dataPending = true;
+    if (dataGroup) {
+        xEventGroupSetBits(dataGroup, dataBits);
+    }
+}
+
+bool GPSModule::takeDataPending() {
+    bool pending = dataPending;
+    dataPending = false;
+    return pending;
+}
+
+void GPSModule::notifyOnData(EventGroupHandle_t group, EventBits_t bits) {
+    dataGroup = group;
+    dataBits = bits;
+}
+
 void GPSModule::update() {
     // Read available data from GPS and encode it
     while (gpsSerial.available() > 0) {
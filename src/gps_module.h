@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <HardwareSerial.h>
+#include <freertos/event_groups.h>
 #include <TinyGPS++.h>
 
 struct GPSData {
@@ -31,6 +32,13 @@ private:
     unsigned long lastValidFix;
     static const unsigned long GPS_TIMEOUT = 30000; // 30 seconds
     
+    // Set by the UART driver when a burst of NMEA data has arrived
+    volatile bool dataPending;
+    EventGroupHandle_t dataGroup;
+    EventBits_t dataBits;
+    
+    void onUartData();
+    
 public:
     GPSModule();
     ~GPSModule();
@@ -41,6 +49,12 @@ public:
     // Main update function, called regularly in loop
     void update();
     
+    // True (once) when the UART has received data since the last call
+    bool takeDataPending();
+    
+    // Also set these bits when data arrives, so the loop can sleep until then
+    void notifyOnData(EventGroupHandle_t group, EventBits_t bits);
+    
     // Data access
     GPSData getGPSData() const;
     bool hasValidFix() const;
@@ -0,0 +1,149 @@
+#include "http_body_stream.h"
+
+HttpBodyStream::HttpBodyStream(HTTPClient& http, WiFiClient* client)
+    : client(client), remaining(http.getSize()), chunked(false), complete(false), readAheadPos(0), readAheadLen(0) {
+    String transferEncoding = http.header("Transfer-Encoding");
+    transferEncoding.toLowerCase();
+    if (transferEncoding.indexOf("chunked") >= 0) {
+        chunked = true;
+        remaining = 0;
+    }
+    setTimeout(client->getTimeout());
+    if (!chunked && remaining == 0) {
+        complete = true;
+    }
+}
+
+void HttpBodyStream::prepare(HTTPClient& http) {
+    static const char* headerKeys[] = {"Transfer-Encoding"};
+    http.collectHeaders(headerKeys, 1);
+}
+
+bool HttpBodyStream::readChunkHeader() {
+    // "<hex size>[;ext]\r\n" - the CRLF ending the previous chunk shows up as an empty line
+    while (client->available() > 0) {
+        String line = client->readStringUntil('\n');
+        line.trim();
+        if (line.length() == 0) {
+            continue;
+        }
+        remaining = (int)strtol(line.c_str(), nullptr, 16);
+        if (remaining == 0) {
+            client->readStringUntil('\n');  // CRLF after the last chunk (no trailers expected)
+            complete = true;
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+size_t HttpBodyStream::readAvailable(uint8_t* buffer, size_t length) {
+    size_t buffered = readAheadLen - readAheadPos;
+    if (buffered > 0) {
+        if (buffered > length) {
+            buffered = length;
+        }
+        memcpy(buffer, readAhead + readAheadPos, buffered);
+        readAheadPos += buffered;
+    }
+    return buffered + readFromClient(buffer + buffered, length - buffered);
+}
+
+size_t HttpBodyStream::readFromClient(uint8_t* buffer, size_t length) {
+    if (complete || length == 0) {
+        return 0;
+    }
+    if (chunked && remaining == 0 && !readChunkHeader()) {
+        return 0;
+    }
+
+    size_t wanted = length;
+    if (remaining >= 0 && (size_t)remaining < wanted) {
+        wanted = remaining;
+    }
+    int available = client->available();
+    if (available <= 0) {
+        return 0;
+    }
+    if ((size_t)available < wanted) {
+        wanted = available;
+    }
+
+    int bytesRead = client->read(buffer, wanted);
+    if (bytesRead <= 0) {
+        return 0;
+    }
+    if (remaining >= 0) {
+        remaining -= bytesRead;
+        if (remaining == 0 && !chunked) {
+            complete = true;
+        }
+    }
+    return bytesRead;
+}
+
+bool HttpBodyStream::isFinished() const {
+    return readAheadEmpty() && (complete || (!client->connected() && client->available() == 0));
+}
+
+void HttpBodyStream::discardRemaining() {
+    uint8_t scratch[64];
+    unsigned long lastData = millis();
+    while (!isFinished() && millis() - lastData < getTimeout()) {
+        if (readAvailable(scratch, sizeof(scratch)) > 0) {
+            lastData = millis();
+        } else {
+            delay(1);
+        }
+    }
+}
+
+int HttpBodyStream::available() {
+    int buffered = readAheadLen - readAheadPos;
+    if (complete) {
+        return buffered;
+    }
+    int available = client->available();
+    if (available <= 0) {
+        return buffered;
+    }
+    if (!chunked && remaining >= 0 && available > remaining) {
+        available = remaining;
+    }
+    return buffered + available;  // Includes chunk framing for chunked bodies - only used as "has data"
+}
+
+int HttpBodyStream::read() {
+    uint8_t c;
+    return readBytes((char*)&c, 1) == 1 ? c : -1;
+}
+
+int HttpBodyStream::peek() {
+    if (readAheadEmpty()) {
+        readAheadPos = 0;
+        readAheadLen = readFromClient(readAhead, READ_AHEAD_SIZE);
+    }
+    return readAheadEmpty() ? -1 : readAhead[readAheadPos];
+}
+
+size_t HttpBodyStream::readBytes(char* buffer, size_t length) {
+    size_t total = 0;
+    unsigned long lastData = millis();
+    while (total < length && !isFinished()) {
+        if (readAheadEmpty() && length - total < READ_AHEAD_SIZE) {
+            readAheadPos = 0;
+            readAheadLen = readFromClient(readAhead, READ_AHEAD_SIZE);
+        }
+        size_t bytesRead = readAvailable((uint8_t*)buffer + total, length - total);
+        if (bytesRead > 0) {
+            total += bytesRead;
+            lastData = millis();
+        } else if (millis() - lastData > getTimeout()) {
+            break;
+        } else {
+            delay(1);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,54 @@
+#ifndef HTTP_BODY_STREAM_H
+#define HTTP_BODY_STREAM_H
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+
+// Reads exactly one HTTP response body from a kept-alive connection: stops at Content-Length
+// or the final chunk of a chunked response, so the connection can carry the next request.
+// Call prepare() before the request so the Transfer-Encoding header gets collected.
+class HttpBodyStream : public Stream {
+private:
+    static const size_t READ_AHEAD_SIZE = 128;
+
+    WiFiClient* client;
+    int remaining;          // Bytes left in the body (or current chunk when chunked), -1 = until close
+    bool chunked;
+    bool complete;          // All body bytes taken from the socket
+
+    // Byte-at-a-time readers (ArduinoJson) are served from here instead of one TLS read per byte
+    uint8_t readAhead[READ_AHEAD_SIZE];
+    size_t readAheadPos;
+    size_t readAheadLen;
+
+    bool readChunkHeader();
+    size_t readFromClient(uint8_t* buffer, size_t length);
+    bool readAheadEmpty() const { return readAheadPos == readAheadLen; }
+
+public:
+    HttpBodyStream(HTTPClient& http, WiFiClient* client);
+
+    static void prepare(HTTPClient& http);
+
+    // Read whatever body bytes are already buffered (never blocks on the network)
+    size_t readAvailable(uint8_t* buffer, size_t length);
+
+    // Whole body consumed - the connection may be reused
+    bool isComplete() const { return complete && readAheadEmpty(); }
+
+    // Body finished or the server closed the connection
+    bool isFinished() const;
+
+    // Skip whatever is left of the body (e.g. after a parser stopped at the end of the JSON)
+    void discardRemaining();
+
+    // Stream
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+    size_t write(uint8_t) override { return 0; }
+    void flush() override {}
+};
+
+#endif
@@ -0,0 +1,247 @@
+#include "http_connection_pool.h"
+#include <HTTPClient.h>
+
+HttpConnectionPool::HttpConnectionPool()
+    : handshakes(0), handshakeTotalMs(0), handshakeMaxMs(0), reuses(0), staleRetries(0) {
+    mutex = xSemaphoreCreateMutex();
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        connections[i].host[0] = '\0';
+        connections[i].port = 0;
+        connections[i].secure = false;
+        connections[i].client = nullptr;
+        connections[i].inUse = false;
+        connections[i].lastUsed = 0;
+        connections[i].requests = 0;
+    }
+}
+
+HttpConnectionPool& HttpConnectionPool::shared() {
+    static HttpConnectionPool pool;
+    return pool;
+}
+
+bool HttpConnectionPool::parseUrl(const String& url, char* host, size_t hostSize, uint16_t& port, bool& secure) {
+    int hostStart;
+    if (url.startsWith("https://")) {
+        secure = true;
+        port = 443;
+        hostStart = 8;
+    } else if (url.startsWith("http://")) {
+        secure = false;
+        port = 80;
+        hostStart = 7;
+    } else {
+        return false;
+    }
+
+    int hostEnd = hostStart;
+    while (hostEnd < (int)url.length() && url[hostEnd] != '/' && url[hostEnd] != '?' && url[hostEnd] != ':') {
+        hostEnd++;
+    }
+    if (hostEnd == hostStart || (size_t)(hostEnd - hostStart) >= hostSize) {
+        return false;
+    }
+    memcpy(host, url.c_str() + hostStart, hostEnd - hostStart);
+    host[hostEnd - hostStart] = '\0';
+
+    if (hostEnd < (int)url.length() && url[hostEnd] == ':') {
+        port = (uint16_t)atoi(url.c_str() + hostEnd + 1);
+    }
+    return port != 0;
+}
+
+WiFiClient* HttpConnectionPool::createClient(bool secure) {
+    if (secure) {
+        WiFiClientSecure* client = new WiFiClientSecure();
+        client->setInsecure();
+        return client;
+    }
+    return new WiFiClient();
+}
+
+bool HttpConnectionPool::connect(WiFiClient* client, const char* host, uint16_t port, bool secure, int32_t timeoutMs) {
+    unsigned long start = millis();
+    // The timeout overloads aren't virtual - call the TLS one explicitly for secure clients
+    bool ok = secure ? static_cast<WiFiClientSecure*>(client)->connect(host, port, timeoutMs)
+                     : client->connect(host, port, timeoutMs);
+    if (!ok) {
+        Serial.printf("❌ Connection to %s:%u failed\n", host, port);
+        return false;
+    }
+
+    uint32_t elapsed = millis() - start;
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    handshakes++;
+    handshakeTotalMs += elapsed;
+    if (elapsed > handshakeMaxMs) {
+        handshakeMaxMs = elapsed;
+    }
+    Serial.printf("🔐 %s %s:%u in %u ms (connects: %u, avg %u ms, max %u ms, reused: %u, stale retries: %u)\n",
+                  secure ? "TLS handshake with" : "Connected to", host, port, elapsed,
+                  handshakes, handshakeTotalMs / handshakes, handshakeMaxMs, reuses, staleRetries);
+    xSemaphoreGive(mutex);
+    return true;
+}
+
+void HttpConnectionPool::closeConnection(Connection& connection) {
+    if (connection.client) {
+        connection.client->stop();
+    }
+    connection.requests = 0;
+}
+
+void HttpConnectionPool::closeIdleConnections() {
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        if (!connections[i].inUse && connections[i].client && connections[i].client->connected()) {
+            closeConnection(connections[i]);
+        }
+    }
+}
+
+WiFiClient* HttpConnectionPool::acquire(const String& url, int32_t connectTimeoutMs, bool* reused) {
+    return acquire(url, connectTimeoutMs, true, reused);
+}
+
+WiFiClient* HttpConnectionPool::acquireFresh(const String& url, int32_t connectTimeoutMs) {
+    return acquire(url, connectTimeoutMs, false, nullptr);
+}
+
+bool HttpConnectionPool::shouldRetryFresh(bool reused, int httpCode) {
+    bool stale = reused && (httpCode == HTTPC_ERROR_SEND_HEADER_FAILED || httpCode == HTTPC_ERROR_SEND_PAYLOAD_FAILED ||
+                            httpCode == HTTPC_ERROR_NOT_CONNECTED || httpCode == HTTPC_ERROR_CONNECTION_LOST ||
+                            httpCode == HTTPC_ERROR_NO_HTTP_SERVER);
+    if (stale) {
+        xSemaphoreTake(mutex, portMAX_DELAY);
+        staleRetries++;
+        xSemaphoreGive(mutex);
+        Serial.printf("♻️ Kept-alive connection was stale (%s) - retrying on a new one\n",
+                      HTTPClient::errorToString(httpCode).c_str());
+    }
+    return stale;
+}
+
+WiFiClient* HttpConnectionPool::acquire(const String& url, int32_t connectTimeoutMs, bool allowReuse, bool* reused) {
+    if (reused) {
+        *reused = false;
+    }
+    char host[64];
+    uint16_t port;
+    bool secure;
+    if (!parseUrl(url, host, sizeof(host), port, secure)) {
+        Serial.printf("❌ Connection pool cannot parse URL: %s\n", url.c_str());
+        return nullptr;
+    }
+
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    // Reuse an open connection to the same host
+    for (int i = 0; allowReuse && i < MAX_CONNECTIONS; i++) {
+        Connection& connection = connections[i];
+        if (connection.inUse || !connection.client || connection.port != port ||
+            connection.secure != secure || strcmp(connection.host, host) != 0) {
+            continue;
+        }
+        if (connection.client->connected()) {
+            connection.inUse = true;
+            reuses++;
+            xSemaphoreGive(mutex);
+            if (reused) {
+                *reused = true;
+            }
+            return connection.client;
+        }
+        closeConnection(connection);  // The server closed it while idle
+    }
+
+    // Otherwise take a closed slot, or evict the least recently used idle connection
+    Connection* slot = nullptr;
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection& connection = connections[i];
+        if (connection.inUse) {
+            continue;
+        }
+        if (!connection.client || !connection.client->connected()) {
+            slot = &connection;
+            break;
+        }
+        if (!slot || connection.lastUsed < slot->lastUsed) {
+            slot = &connection;
+        }
+    }
+
+    // Every handshake needs a big chunk of internal heap - give back idle connections first
+    if (ESP.getFreeHeap() < LOW_HEAP_THRESHOLD) {
+        closeIdleConnections();
+    }
+
+    WiFiClient* client = nullptr;
+    if (slot) {
+        closeConnection(*slot);
+        if (slot->client && slot->secure != secure) {
+            delete slot->client;
+            slot->client = nullptr;
+        }
+        if (!slot->client) {
+            slot->client = createClient(secure);
+        }
+        strcpy(slot->host, host);
+        slot->port = port;
+        slot->secure = secure;
+        slot->inUse = true;
+        client = slot->client;
+    }
+    xSemaphoreGive(mutex);
+
+    if (!client) {
+        // All pooled connections are busy - use a one-off connection (deleted on release)
+        client = createClient(secure);
+    }
+
+    if (!connect(client, host, port, secure, connectTimeoutMs)) {
+        release(client, false);
+        return nullptr;
+    }
+    return client;
+}
+
+void HttpConnectionPool::release(WiFiClient* client, bool reusable) {
+    if (!client) {
+        return;
+    }
+
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection& connection = connections[i];
+        if (connection.client != client) {
+            continue;
+        }
+        if (reusable && client->connected()) {
+            connection.requests++;
+        } else {
+            closeConnection(connection);
+        }
+        connection.inUse = false;
+        connection.lastUsed = millis();
+        xSemaphoreGive(mutex);
+        return;
+    }
+    xSemaphoreGive(mutex);
+
+    // Not a pooled client
+    client->stop();
+    delete client;
+}
+
+void HttpConnectionPool::evictIdle() {
+    unsigned long now = millis();
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        Connection& connection = connections[i];
+        if (!connection.inUse && connection.client && connection.client->connected() &&
+            now - connection.lastUsed > IDLE_TIMEOUT) {
+            Serial.printf("🔌 Closing idle connection to %s (%u requests served)\n", connection.host, connection.requests);
+            closeConnection(connection);
+        }
+    }
+    xSemaphoreGive(mutex);
+}
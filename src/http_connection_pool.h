@@ -0,0 +1,76 @@
+#ifndef HTTP_CONNECTION_POOL_H
+#define HTTP_CONNECTION_POOL_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+
+// Persistent HTTP(S) connections shared by every HTTPClient user (Deepgram STT/TTS, Maps,
+// notifications, settings). A TLS handshake costs hundreds of ms and ~40 KB of heap, so
+// connections are kept alive and handed out again to requests for the same host while the server
+// keeps them open. The pool holds up to MAX_CONNECTIONS (three) in total, shared by all hosts; when
+// it is full, acquire() closes the least recently used idle connection, whatever its host.
+//
+// Usage: acquire() a client for the URL, run HTTPClient on it with setReuse(true), then
+// release() it - reusable only if the whole response body was read. A kept-alive connection can
+// have been closed by the server just before it was reused; when shouldRetryFresh() says so,
+// release the client and send the request once more on acquireFresh().
+class HttpConnectionPool {
+private:
+    struct Connection {
+        char host[64];
+        uint16_t port;
+        bool secure;
+        WiFiClient* client;         // WiFiClientSecure when secure
+        bool inUse;
+        unsigned long lastUsed;
+        uint32_t requests;          // Requests served since the handshake
+    };
+
+    static const int MAX_CONNECTIONS = 3;                 // Whole pool, not per host (LRU-evicted)
+    static const unsigned long IDLE_TIMEOUT = 30000;      // Close keep-alive connections nobody used for this long
+    static const uint32_t LOW_HEAP_THRESHOLD = 60000;     // Drop idle connections before handshaking below this
+    Connection connections[MAX_CONNECTIONS];
+    SemaphoreHandle_t mutex;
+
+    // Handshake metrics
+    uint32_t handshakes;
+    uint32_t handshakeTotalMs;
+    uint32_t handshakeMaxMs;
+    uint32_t reuses;
+    uint32_t staleRetries;
+
+    HttpConnectionPool();
+
+    static bool parseUrl(const String& url, char* host, size_t hostSize, uint16_t& port, bool& secure);
+    static WiFiClient* createClient(bool secure);
+    bool connect(WiFiClient* client, const char* host, uint16_t port, bool secure, int32_t timeoutMs);
+    void closeConnection(Connection& connection);
+    void closeIdleConnections();
+    WiFiClient* acquire(const String& url, int32_t connectTimeoutMs, bool allowReuse, bool* reused);
+
+public:
+    static const int32_t CONNECT_TIMEOUT = 10000;
+
+    static HttpConnectionPool& shared();
+
+    // Borrow a connected client for the URL's host (nullptr if the connection failed). reused is
+    // set when it is a kept-alive connection rather than a new one.
+    WiFiClient* acquire(const String& url, int32_t connectTimeoutMs = CONNECT_TIMEOUT, bool* reused = nullptr);
+
+    // Borrow a newly opened connection - for the retry after a stale kept-alive one
+    WiFiClient* acquireFresh(const String& url, int32_t connectTimeoutMs = CONNECT_TIMEOUT);
+
+    // True when a request on a reused connection failed before any response arrived (httpCode is
+    // an HTTPClient error) - the server most likely closed the connection while it sat idle, so
+    // the request never reached it and is safe to send again once
+    bool shouldRetryFresh(bool reused, int httpCode);
+
+    // Give the client back; a client that isn't reusable (or was closed) is shut down
+    void release(WiFiClient* client, bool reusable);
+
+    // Close connections idle for longer than IDLE_TIMEOUT (call periodically)
+    void evictIdle();
+};
+
+#endif
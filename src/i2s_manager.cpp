@@ -3,6 +3,7 @@
 // Static member definitions
 I2SDevice I2SManager::currentDevice = I2SDevice::NONE;
 bool I2SManager::initialized = false;
+QueueHandle_t I2SManager::rxEvents = NULL;
 
 bool I2SManager::requestI2SAccess(I2SDevice device) {
     if (currentDevice != I2SDevice::NONE && currentDevice != device) {
@@ -84,7 +85,7 @@ esp_err_t I2SManager::initializeMicrophone() {
     };
     
     Serial.println("Installing I2S driver for microphone...");
-    esp_err_t err = i2s_driver_install(I2S_PORT, &i2s_config, 0, NULL);
+    esp_err_t err = i2s_driver_install(I2S_PORT, &i2s_config, RX_EVENT_QUEUE_DEPTH, &rxEvents);
     if (err != ESP_OK) {
         Serial.printf("❌ Failed installing I2S driver: %s\n", esp_err_to_name(err));
         return err;
@@ -94,6 +95,7 @@ esp_err_t I2SManager::initializeMicrophone() {
     if (err != ESP_OK) {
         Serial.printf("❌ Failed setting I2S pins: %s\n", esp_err_to_name(err));
         i2s_driver_uninstall(I2S_PORT);
+        rxEvents = NULL;
         return err;
     }
     
@@ -101,6 +103,7 @@ esp_err_t I2SManager::initializeMicrophone() {
     if (err != ESP_OK) {
         Serial.printf("❌ Failed starting I2S: %s\n", esp_err_to_name(err));
         i2s_driver_uninstall(I2S_PORT);
+        rxEvents = NULL;
         return err;
     }
     
@@ -182,12 +185,17 @@ esp_err_t I2SManager::initializeSpeaker() {
 
 void I2SManager::shutdownI2S() {
     if (initialized) {
+        rxEvents = NULL;  // Deleted with the driver
         i2s_driver_uninstall(I2S_PORT);
         initialized = false;
         Serial.println("✅ I2S driver uninstalled");
     }
 }
 
+QueueHandle_t I2SManager::getRxEventQueue() {
+    return initialized && currentDevice == I2SDevice::MICROPHONE ? rxEvents : NULL;
+}
+
 bool I2SManager::isInitialized() {
     return initialized;
 }
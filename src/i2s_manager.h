@@ -19,9 +19,11 @@ class I2SManager {
 private:
     static I2SDevice currentDevice;
     static bool initialized;
+    static QueueHandle_t rxEvents;
     
 public:
     static const i2s_port_t I2S_PORT = I2S_NUM_1;
+    static const int RX_EVENT_QUEUE_DEPTH = 8;  // One event per DMA buffer
     /**
      * @brief Requests exclusive access to the I2S port for a specific device
      * @param device The device requesting access
@@ -71,6 +73,12 @@ public:
      */
     static void shutdownI2S();
     
+    /**
+     * @brief Gets the driver's event queue while the microphone is running
+     * @return I2S_EVENT_RX_DONE per filled DMA buffer, or NULL if the microphone is off
+     */
+    static QueueHandle_t getRxEventQueue();
+    
     /**
      * @brief Checks if I2S is currently initialized
      * @return true if initialized
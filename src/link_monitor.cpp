@@ -0,0 +1,136 @@
+#include "link_monitor.h"
+
+#include "esp_random.h"
+
+LinkMonitor::LinkMonitor() : connected(false), everConnected(false), lastReceiveTime(0), lastPingTime(0), pingSentAt(0), requestSentAt(0), rttCount(0), rttNext(0), reconnectCount(0), stallCount(0), backoffAttempt(0), reconnectDelay(BACKOFF_BASE) {
+}
+
+void LinkMonitor::onConnected(unsigned long now) {
+    if (everConnected) {
+        reconnectCount++;
+    }
+    everConnected = true;
+    connected = true;
+    lastReceiveTime = now;
+    lastPingTime = now;
+    pingSentAt = 0;
+    requestSentAt = 0;
+}
+
+void LinkMonitor::onDisconnected() {
+    connected = false;
+    pingSentAt = 0;
+    requestSentAt = 0;
+}
+
+void LinkMonitor::onSessionReady() {
+    backoffAttempt = 0;
+    reconnectDelay = BACKOFF_BASE;
+}
+
+void LinkMonitor::onMessageReceived(unsigned long now) {
+    lastReceiveTime = now;
+    requestSentAt = 0;
+}
+
+void LinkMonitor::onRequestSent(unsigned long now) {
+    if (requestSentAt == 0) {
+        requestSentAt = now ? now : 1;
+    }
+}
+
+bool LinkMonitor::isExpectingTraffic(unsigned long now) const {
+    return pingSentAt != 0 || requestSentAt != 0 || now - lastReceiveTime < ACTIVE_WINDOW;
+}
+
+bool LinkMonitor::isPingDue(unsigned long now) const {
+    return connected && pingSentAt == 0 && now - lastPingTime >= PING_INTERVAL;
+}
+
+void LinkMonitor::onPingSent(unsigned long now) {
+    lastPingTime = now;
+    pingSentAt = now ? now : 1;
+}
+
+void LinkMonitor::onPong(unsigned long now) {
+    lastReceiveTime = now;
+    if (pingSentAt == 0) {
+        return;  // Unsolicited pong
+    }
+    addRttSample(now - pingSentAt);
+    pingSentAt = 0;
+}
+
+void LinkMonitor::addRttSample(uint32_t rttMs) {
+    rttSamples[rttNext] = rttMs;
+    rttNext = (rttNext + 1) % RTT_WINDOW;
+    if (rttCount < RTT_WINDOW) {
+        rttCount++;
+    }
+}
+
+const char* LinkMonitor::checkStall(unsigned long now) {
+    if (!connected) {
+        return nullptr;
+    }
+
+    const char* reason = nullptr;
+    if (pingSentAt != 0 && now - pingSentAt >= PONG_TIMEOUT) {
+        reason = "no pong";
+    } else if (requestSentAt != 0 && now - requestSentAt >= RESPONSE_TIMEOUT) {
+        reason = "no response to request";
+    }
+
+    if (reason) {
+        stallCount++;
+        // Don't report the same stall twice before the connection is dropped
+        pingSentAt = 0;
+        requestSentAt = 0;
+    }
+    return reason;
+}
+
+unsigned long LinkMonitor::nextReconnectDelay() {
+    // Exponential backoff with "equal jitter": half fixed, half random, so many devices
+    // reconnecting after the same outage don't all hit the server at once
+    unsigned long ceiling = BACKOFF_MAX;
+    if (backoffAttempt < 16) {
+        unsigned long exponential = BACKOFF_BASE << backoffAttempt;
+        if (exponential < ceiling) {
+            ceiling = exponential;
+        }
+        backoffAttempt++;
+    }
+    unsigned long half = ceiling / 2;
+    reconnectDelay = half + esp_random() % (half + 1);
+    return reconnectDelay;
+}
+
+LinkQuality LinkMonitor::getQuality(unsigned long now) const {
+    LinkQuality quality = {};
+    quality.connected = connected;
+    quality.reconnectCount = reconnectCount;
+    quality.stallCount = stallCount;
+    quality.lastResponseAgeMs = lastReceiveTime ? now - lastReceiveTime : 0;
+    quality.reconnectDelayMs = connected ? 0 : reconnectDelay;
+
+    // Sort a copy of the window (at most 16 samples, insertion sort is plenty)
+    uint32_t sorted[RTT_WINDOW];
+    for (int i = 0; i < rttCount; i++) {
+        uint32_t value = rttSamples[i];
+        int j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+
+    quality.rttSamples = rttCount;
+    if (rttCount > 0) {
+        quality.rttP50Ms = sorted[(rttCount - 1) * 50 / 100];
+        quality.rttP90Ms = sorted[(rttCount - 1) * 90 / 100];
+        quality.rttMaxMs = sorted[rttCount - 1];
+    }
+    return quality;
+}
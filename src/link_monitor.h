@@ -0,0 +1,80 @@
+#ifndef LINK_MONITOR_H
+#define LINK_MONITOR_H
+
+#include <Arduino.h>
+
+// Snapshot of the Gemini link health for subsystems that want to adapt (frame rate, timeouts, ...)
+struct LinkQuality {
+    bool connected;
+    uint8_t rttSamples;             // Number of RTT samples in the window below
+    uint32_t rttP50Ms;
+    uint32_t rttP90Ms;
+    uint32_t rttMaxMs;
+    uint32_t reconnectCount;        // Successful reconnects after the first connection
+    uint32_t stallCount;            // Connections dropped by stall detection
+    unsigned long lastResponseAgeMs;  // Time since anything was received from the server
+    unsigned long reconnectDelayMs;   // Current reconnect backoff (0 while connected)
+};
+
+// Tracks the health of one WebSocket connection: ping/pong RTT samples, stalls (sent requests
+// or pings with no reply) and a jittered exponential reconnect backoff.
+// It only keeps the bookkeeping - the owner sends the pings and drops the connection.
+class LinkMonitor {
+private:
+    static const unsigned long PING_INTERVAL = 15000;      // RTT probe period while connected
+    static const unsigned long PONG_TIMEOUT = 8000;        // Unanswered ping = stalled link
+    static const unsigned long RESPONSE_TIMEOUT = 20000;   // Request with no server traffic = stalled link
+    static const unsigned long BACKOFF_BASE = 1000;
+    static const unsigned long BACKOFF_MAX = 60000;
+    static const int RTT_WINDOW = 16;
+    static const unsigned long ACTIVE_WINDOW = 2000;       // Traffic this recent = more is probably coming
+
+    bool connected;
+    bool everConnected;
+    unsigned long lastReceiveTime;
+    unsigned long lastPingTime;
+    unsigned long pingSentAt;       // 0 when no ping is outstanding
+    unsigned long requestSentAt;    // Oldest request not yet followed by server traffic (0 if none)
+
+    uint32_t rttSamples[RTT_WINDOW];
+    int rttCount;
+    int rttNext;
+
+    uint32_t reconnectCount;
+    uint32_t stallCount;
+    int backoffAttempt;
+    unsigned long reconnectDelay;
+
+    void addRttSample(uint32_t rttMs);
+
+public:
+    LinkMonitor();
+
+    // Connection lifecycle
+    void onConnected(unsigned long now);
+    void onDisconnected();
+    void onSessionReady();          // Setup finished - the link works, so the backoff starts over
+
+    // Traffic
+    void onMessageReceived(unsigned long now);
+    void onRequestSent(unsigned long now);   // A message that the server should answer
+
+    // True while a reply is outstanding or the server was heard from recently, i.e. while
+    // the socket should be polled often so replies (and pong RTTs) aren't delayed
+    bool isExpectingTraffic(unsigned long now) const;
+
+    // RTT probing
+    bool isPingDue(unsigned long now) const;
+    void onPingSent(unsigned long now);
+    void onPong(unsigned long now);
+
+    // Returns a reason if the link looks dead (and counts the stall), nullptr while healthy
+    const char* checkStall(unsigned long now);
+
+    // Delay before the next reconnect attempt; each call backs off further (with jitter)
+    unsigned long nextReconnectDelay();
+
+    LinkQuality getQuality(unsigned long now) const;
+};
+
+#endif
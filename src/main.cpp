@@ -7,16 +7,36 @@
 #include "microphone.h"
 #include "deepgram_client.h"
 #include "settings_manager.h"
+#include "network_executor.h"
+#include "http_connection_pool.h"
+#include "voice_activity.h"
+#include "wake_word_scheduler.h"
+#include "wake_word_prefilter.h"
+#include "speculative_transcriber.h"
+#include "audio_dsp.h"
+#include "audio_config.h"
+#include "audio_stats.h"
+#include "noise_suppressor.h"
+#include "mfcc_extractor.h"
+#include "wake_word_spotter.h"
+#include "message_queue.h"
+#include "wake_monitor.h"
+#include <freertos/event_groups.h>
+#include <freertos/timers.h>
+#include "gemini_config.h"
 #include <ArduinoJson.h>
 
 VisionAssistant visionAssistant;
 TTS tts;
 DeepgramClient deepgramClient(DEEPGRAM_API_KEY);
 SettingsManager settingsManager(NOTIFICATIONS_API_URL);
+NetworkExecutor networkExecutor;
 bool ttsAvailable = false;
+volatile bool native_audio_turn_active = false; // A Gemini audio turn is being streamed to the speaker
 
 // Button Pin for Push-to-Talk and SOS
 const int BUTTON_PIN = 15;
+const unsigned long BUTTON_DEBOUNCE_MS = 30;  // The level must hold this long after the last edge
 
 // Wake words (optimized for Deepgram's acoustic search - longer phrases work better)
 const char* WAKE_WORDS[] = {
@@ -24,12 +44,13 @@ const char* WAKE_WORDS[] = {
 };
 const int WAKE_WORDS_COUNT = sizeof(WAKE_WORDS) / sizeof(WAKE_WORDS[0]);
 
-// Audio buffer for wake word detection (3 seconds)
+// Audio buffer for wake word detection (3 seconds at the reduced wake search rate)
 const int WAKE_WORD_BUFFER_SECONDS = 3;
 const int SAMPLE_RATE = 16000;
 const int BITS_PER_SAMPLE = 16;
 const int CHANNELS = 1;
-const int WAKE_WORD_BUFFER_SIZE = WAKE_WORD_BUFFER_SECONDS * SAMPLE_RATE * (BITS_PER_SAMPLE / 8) * CHANNELS;
+const int WAKE_SEARCH_SAMPLE_RATE = SAMPLE_RATE / AUDIO_WAKE_SEARCH_DECIMATION;
+const int WAKE_WORD_BUFFER_SIZE = WAKE_WORD_BUFFER_SECONDS * WAKE_SEARCH_SAMPLE_RATE * (BITS_PER_SAMPLE / 8) * CHANNELS;
 
 // Audio buffer for command recording (15 seconds maximum)
 const int COMMAND_BUFFER_SECONDS = 15;
@@ -37,25 +58,98 @@ const int COMMAND_BUFFER_SIZE = COMMAND_BUFFER_SECONDS * SAMPLE_RATE * (BITS_PER
 
 uint8_t* wake_word_buffer = nullptr;
 uint8_t* command_buffer = nullptr;
-uint8_t* stt_temp_buffer = nullptr;
 volatile int wake_word_buffer_index = 0;  // Made volatile for dual-core access
 volatile int command_buffer_index = 0;    // For command recording
 volatile bool is_recording = false;       // Made volatile for dual-core access
 volatile bool wake_word_buffer_has_wrapped = false;  // Track if wake word buffer has wrapped around
-volatile uint32_t buffer_sequence = 0;    // Sequence number to track buffer updates
+uint32_t wake_word_buffer_end_sample = 0;  // Capture sample (VAD count) at wake_word_buffer_index
 volatile float baseline_audio_level = 0.0f; // Baseline audio level for silence detection
 volatile bool baseline_calculated = false;  // Whether baseline has been calculated
 volatile bool is_speaking = false; // Flag to prevent TTS overlap
 
+// Speech detection on the microphone stream gates the cloud wake word search
+// (both only touched by the audio task)
+VoiceActivityDetector wakeVad;
+WakeWordScheduler wakeScheduler(WAKE_WORD_BUFFER_SECONDS * SAMPLE_RATE);  // Ring length in capture samples
+WakeWordPrefilter wakePrefilter(AUDIO_WAKE_PREFILTER_THRESHOLD);
+int wakePrefilterScore = 0;             // Score of the window being searched
+
+// Level statistics of everything captured, kept per block for a little longer than a full
+// command so level checks and upload logs never rescan PCM (audio task only)
+AudioStatsRing captureStats((COMMAND_BUFFER_SECONDS + 1) * SAMPLE_RATE / AudioStatsRing::BLOCK_SAMPLES);
+
+// Capture DSP chain, run by the audio task on every microphone block
+DcBlocker captureDcBlocker;
+HighPassBiquad captureHighPass(AUDIO_HIGHPASS_HZ, SAMPLE_RATE);
+AutomaticGainControl captureAgc(AUDIO_AGC_TARGET_PEAK, AUDIO_AGC_MIN_GAIN, AUDIO_AGC_MAX_GAIN, AUDIO_AGC_INITIAL_GAIN);
+NoiseGate captureNoiseGate(AUDIO_NOISE_GATE_RMS);
+AudioDspChain captureDsp(SAMPLE_RATE);
+
+// Feeds the wake word ring at the reduced rate (capture sample n lands at ring sample n / factor)
+PolyphaseDecimator wakeDecimator(SAMPLE_RATE, AUDIO_WAKE_SEARCH_DECIMATION, AUDIO_WAKE_SEARCH_FILTER_TAPS);
+
+// Denoises the command buffer while it records, from a noise spectrum learned between utterances
+NoiseSuppressor commandSuppressor;
+
+// Personal wake word matched on the device (replaces the cloud search once enrolled;
+// both only touched by the audio task)
+MfccExtractor wakeMfcc;
+WakeWordSpotter wakeSpotter;
+
+// Speculative transcription of the command at speech pauses (state only touched by the audio task)
+SpeculativeTranscriber speculativeStt(DEEPGRAM_API_KEY);
+uint32_t recording_id = 0;              // Bumped for every new command recording
+uint32_t recording_start_sample = 0;    // wakeVad position when the recording started
+uint32_t speculative_speech_end = 0;    // End of the speech the last speculative job covers
+int speculative_bytes = 0;              // Command audio that job covers (0 = none)
+const unsigned long SPECULATIVE_STT_WAIT_MS = 12000;  // Longer than the Deepgram request timeout
+
 // GPS and Places API
 GPSData last_checked_gps_data;
 unsigned long last_places_check_time = 0;
+bool places_request_in_flight = false;
+
+// Network request deadlines (the executor gives up on requests that can't finish in time)
+const unsigned long PLACES_TIMEOUT_MS = 10000;
+const unsigned long DIRECTIONS_TIMEOUT_MS = 10000;
+const unsigned long EMERGENCY_ALERT_TIMEOUT_MS = 15000;
 
 // Core synchronization
 TaskHandle_t AudioTaskHandle = NULL;
 SemaphoreHandle_t audioMutex;
-QueueHandle_t commandQueue;
-QueueHandle_t audioCommandQueue; // For sending commands to the audio task
+QueueHandle_t voiceClipQueue; // Recorded commands to stream to Gemini as audio
+
+// Event-driven scheduling: both loops sleep until work arrives instead of polling on a fixed
+// delay. Setting this to false restores the old fixed delays, to compare the wake reports.
+const bool EVENT_DRIVEN_LOOPS = true;
+const unsigned long LOOP_MAX_SLEEP_MS = 10;    // The Gemini WebSocket is polled, so the loop still ticks
+const unsigned long LOOP_IDLE_SLEEP_MS = 100;  // ...but only this often while the link has nothing in flight
+const unsigned long AUDIO_MAX_SLEEP_MS = 100;  // Recording timeouts and enrollment still need checking
+
+// Events that wake the main loop
+EventGroupHandle_t loopEvents;
+const EventBits_t LOOP_EVENT_BUTTON = BIT0;
+const EventBits_t LOOP_EVENT_COMMAND = BIT1;
+const EventBits_t LOOP_EVENT_VOICE_CLIP = BIT2;
+const EventBits_t LOOP_EVENT_NETWORK = BIT3;
+const EventBits_t LOOP_EVENT_GPS = BIT4;
+const EventBits_t LOOP_EVENTS_ALL = LOOP_EVENT_BUTTON | LOOP_EVENT_COMMAND | LOOP_EVENT_VOICE_CLIP |
+                                    LOOP_EVENT_NETWORK | LOOP_EVENT_GPS;
+
+WakeMonitor loopWake("Main loop");
+WakeMonitor audioWake("Audio task");
+uint32_t micOverruns = 0;  // DMA buffers the I2S driver dropped before the audio task read them
+
+// Debounced button edges, from the debounce timer to handleButton()
+struct ButtonEdge {
+    bool pressed;
+    unsigned long at;           // millis() when the level settled
+    uint32_t firstEdgeMicros;   // First interrupt of the bounce burst, for response latency
+};
+QueueHandle_t buttonEdgeQueue;
+TimerHandle_t buttonDebounceTimer;
+volatile bool buttonEdgePending = false;
+volatile uint32_t buttonFirstEdgeMicros = 0;
 
 // Enum for audio task commands
 enum class AudioCommandType {
@@ -63,113 +157,209 @@ enum class AudioCommandType {
     PLAY_DING,
     PLAY_BUTTON_DING,
     START_RECORDING,
-    STOP_RECORDING_AND_PROCESS
+    STOP_RECORDING_AND_PROCESS,
+    PLAY_AUDIO_STREAM,
+    ENROLL_WAKE_WORD,
+    CLEAR_WAKE_WORD
 };
 
-// Struct for audio commands
-struct AudioCommand {
-    AudioCommandType type;
-    char text[256]; // For SPEAK_TEXT command
-};
+// Messages between the cores come from a shared block pool; the queues carry handles.
+// Audio commands: repeated dings/state changes at the tail fold into one, and senders wait
+// briefly for space rather than losing a command. Transcribed commands: the newest wins.
+const int MESSAGE_POOL_BLOCKS = 96;
+MessagePool messagePool(MESSAGE_POOL_BLOCKS);
+MessageQueue audioCommandQueue("Audio command", messagePool, 5, QueuePolicy::COALESCE, 100);
+MessageQueue commandQueue("Command", messagePool, 5, QueuePolicy::DROP_OLDEST); // Text: transcript, value: millis() when recording stopped
+
+// Queue a command for the audio task (text is only used by SPEAK_TEXT, which never coalesces)
+bool queueAudioCommand(AudioCommandType type, const String& text = String()) {
+    return audioCommandQueue.send((uint16_t)type, text.c_str(), text.length(), 0, type != AudioCommandType::SPEAK_TEXT);
+}
 
-// Struct for command messages (safer than String objects)
-struct CommandMessage {
-    char command[256]; // Fixed size buffer instead of String
+// Recorded voice command handed to the main loop in audio command mode (main loop frees pcm)
+struct VoiceClip {
+    uint8_t* pcm;
+    size_t size;
+    unsigned long recordedAt;
 };
 
 // Function declarations
 void audioTask(void *pvParameters);
+void IRAM_ATTR onButtonInterrupt();
+void onButtonDebounced(TimerHandle_t timer);
+bool waitForAudioWork();
+void waitForLoopWork();
 void process_audio();
 void playDingSound();
 void playButtonDingSound();
 String cleanTextForWakeWord(const String& text);
-void sendEmergencyAlert(const String& alertType, const String& description);
-void handleSystemAction(const JsonDocument& doc);
+void sendEmergencyAlert(const String& alertType, const String& description, ToolCallId callId = 0);
+void handleSystemAction(JsonObjectConst args, ToolCallId callId);
+void queueEnrollmentPrompt(const char* text);
 void initializeLanguageSettings();
 void calculateBaselineAudioLevel();
 bool isAudioSilent();
+void resetCommandProcessing();
+bool prefilterRejects(const WakeWindow& window);
+uint32_t wakeRingOffset(uint32_t sample);
 void processRecordedCommand();
 void handleButton();
 void checkAndAnnounceNearbyPlaces();
+void onNearbyPlacesResponse(const NetResponse& response, void* context);
+void onDirectionsResponse(const NetResponse& response, void* context);
+void onEmergencyAlertResponse(const NetResponse& response, void* context);
+void onSettingsUpdated(const UserSettings& settings);
 String stripHtmlTags(const String& html);
 
-// Tool call handler for system actions
-void toolHandler(const String& toolName, const String& jsonParams) {
-    if (toolName == "systemAction") {
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, jsonParams);
-        if (error) {
-            Serial.printf("Failed to parse systemAction JSON: %s\n", error.c_str());
-            return;
-        }
-        
-        // Conditionally print based on shouldSpeak to reduce log noise
-        if (doc["shouldSpeak"].as<bool>()) {
-            Serial.printf("systemAction call received with params: %s\n", jsonParams.c_str());
-        }
-        
-        handleSystemAction(doc);
-    } else if (toolName == "getDirections") {
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, jsonParams);
-        if (error) {
-            Serial.printf("Failed to parse getDirections JSON: %s\n", error.c_str());
-            return;
-        }
-        String destination = doc["destination"].as<String>();
-        Serial.printf("getDirections call received with destination: %s\n", destination.c_str());
-
-        GPSData origin = visionAssistant.getCurrentGPSData();
-        if (!origin.isValid) {
-            String message = "Sorry, I can't get directions without a valid GPS location.";
-            AudioCommand cmd;
-            cmd.type = AudioCommandType::SPEAK_TEXT;
-            strncpy(cmd.text, message.c_str(), sizeof(cmd.text) - 1);
-            cmd.text[sizeof(cmd.text) - 1] = '\0';
-            xQueueSend(audioCommandQueue, &cmd, 0);
-            return;
+// A directions lookup in flight on the network executor (freed by its response handler)
+struct DirectionsRequest {
+    String destination;
+    ToolCallId callId;
+};
+
+// systemAction tool: speaking, logging and intents (args are read directly from the parsed Gemini message)
+void systemActionTool(JsonObjectConst args, ToolCallId callId) {
+    // Conditionally print based on shouldSpeak to reduce log noise
+    if (args["shouldSpeak"].as<bool>()) {
+        Serial.print("systemAction call received with params: ");
+        serializeJson(args, Serial);
+        Serial.println();
+    }
+    
+    handleSystemAction(args, callId);
+}
+
+// getDirections tool: the lookup runs on the network executor, the route goes back to Gemini
+void getDirectionsTool(JsonObjectConst args, ToolCallId callId) {
+    String destination = args["destination"].as<String>();
+    Serial.printf("getDirections call received with destination: %s\n", destination.c_str());
+
+    GPSData origin = visionAssistant.getCurrentGPSData();
+    if (!origin.isValid) {
+        String message = "Sorry, I can't get directions without a valid GPS location.";
+        if (!visionAssistant.isNativeAudioEnabled()) {
+            queueAudioCommand(AudioCommandType::SPEAK_TEXT, message);
         }
+        visionAssistant.completeToolCall(callId, "No valid GPS location - cannot get directions", true);
+        return;
+    }
 
-        HTTPClient http;
-        String url = "https://maps.googleapis.com/maps/api/directions/json?origin=" +
-                     String(origin.latitude, 6) + "," + String(origin.longitude, 6) +
-                     "&destination=" + destination +
-                     "&key=" + String(GEMINI_API_KEY);
-        
-        http.begin(url);
-        int httpResponseCode = http.GET();
-        String directions = "";
-
-        if (httpResponseCode == 200) {
-            String payload = http.getString();
-            JsonDocument dirDoc;
-            deserializeJson(dirDoc, payload);
-
-            if (dirDoc["status"] == "OK") {
-                JsonArray steps = dirDoc["routes"][0]["legs"][0]["steps"];
-                directions = "Starting route. ";
-                for (int i = 0; i < steps.size() && i < 3; i++) { // Read out first 3 steps
-                    String instruction = steps[i]["html_instructions"];
-                    directions += stripHtmlTags(instruction) + ". ";
+    String url = "https://maps.googleapis.com/maps/api/directions/json?origin=" +
+                 String(origin.latitude, 6) + "," + String(origin.longitude, 6) +
+                 "&destination=" + destination +
+                 "&key=" + String(GEMINI_API_KEY);
+    
+    DirectionsRequest* request = new DirectionsRequest{destination, callId};
+    if (!networkExecutor.get("directions", url, NetPriority::INTERACTIVE, DIRECTIONS_TIMEOUT_MS,
+                             onDirectionsResponse, request)) {
+        delete request;
+        visionAssistant.completeToolCall(callId, "Network busy - directions request dropped", true);
+    }
+}
+
+// setWakeWord tool: enroll a personal wake word or go back to the built-in ones.
+// The audio task runs the enrollment itself and talks the user through it.
+void setWakeWordTool(JsonObjectConst args, ToolCallId callId) {
+    String action = args["action"].as<String>();
+    Serial.printf("setWakeWord call received with action: %s\n", action.c_str());
+
+    AudioCommandType type;
+    if (action == "enroll") {
+        type = AudioCommandType::ENROLL_WAKE_WORD;
+    } else if (action == "reset") {
+        type = AudioCommandType::CLEAR_WAKE_WORD;
+    } else {
+        visionAssistant.completeToolCall(callId, "Unknown action - use enroll or reset", true);
+        return;
+    }
+    if (!queueAudioCommand(type)) {
+        visionAssistant.completeToolCall(callId, "Audio busy - try again", true);
+        return;
+    }
+    visionAssistant.completeToolCall(callId, action == "enroll"
+        ? "Enrollment started - the device will ask the user to say their wake word three times"
+        : "Personal wake word removed - back to the built-in wake words");
+}
+
+// Speak the first steps of a directions lookup and return the route to Gemini
+// (runs from networkExecutor.poll() on the main loop)
+void onDirectionsResponse(const NetResponse& response, void* context) {
+    DirectionsRequest* request = static_cast<DirectionsRequest*>(context);
+    String directions = "";
+    String route = "";
+    bool found = false;
+
+    if (response.statusCode == 200) {
+        // Only the fields we read - a full directions response is tens of kilobytes of JSON
+        JsonDocument filter;
+        filter["status"] = true;
+        JsonObject leg = filter["routes"][0]["legs"][0].to<JsonObject>();
+        leg["distance"]["text"] = true;
+        leg["duration"]["text"] = true;
+        leg["steps"][0]["html_instructions"] = true;
+
+        JsonDocument dirDoc;
+        deserializeJson(dirDoc, response.body, DeserializationOption::Filter(filter));
+
+        if (dirDoc["status"] == "OK") {
+            found = true;
+            JsonObject firstLeg = dirDoc["routes"][0]["legs"][0];
+            JsonArray steps = firstLeg["steps"];
+            directions = "Starting route. ";
+            route = "Route to " + request->destination + ": " + firstLeg["distance"]["text"].as<String>() +
+                    ", " + firstLeg["duration"]["text"].as<String>() + ". Steps: ";
+            for (int i = 0; i < steps.size(); i++) {
+                String instruction = stripHtmlTags(steps[i]["html_instructions"].as<String>());
+                if (i < 3) { // Read out first 3 steps
+                    directions += instruction + ". ";
                 }
-            } else {
-                directions = "Sorry, I could not find directions to " + destination;
+                route += String(i + 1) + ". " + instruction + ". ";
             }
         } else {
-            directions = "Sorry, there was an error getting directions.";
+            directions = "Sorry, I could not find directions to " + request->destination;
+            route = "No route found to " + request->destination + " (status " + dirDoc["status"].as<String>() + ")";
         }
-        http.end();
-
-        AudioCommand cmd;
-        cmd.type = AudioCommandType::SPEAK_TEXT;
-        strncpy(cmd.text, directions.c_str(), sizeof(cmd.text) - 1);
-        cmd.text[sizeof(cmd.text) - 1] = '\0';
-        if (xQueueSend(audioCommandQueue, &cmd, 0) != pdTRUE) {
-            Serial.println("❌ Failed to queue SPEAK_TEXT command for directions");
+    } else {
+        directions = "Sorry, there was an error getting directions.";
+        route = "Directions request failed (HTTP " + String(response.statusCode) + ")";
+    }
+
+    visionAssistant.completeToolCall(request->callId, route, !found);
+    delete request;
+
+    // In native audio mode Gemini speaks the route itself from the tool result
+    if (visionAssistant.isNativeAudioEnabled()) {
+        return;
+    }
+    if (!queueAudioCommand(AudioCommandType::SPEAK_TEXT, directions)) {
+        Serial.println("❌ Failed to queue SPEAK_TEXT command for directions");
+    }
+}
+
+// Native audio handler: Gemini PCM chunks go straight into the TTS stream (called from the WebSocket loop)
+void audioResponseHandler(const uint8_t* pcm, size_t length, bool turnComplete) {
+    if (!ttsAvailable) {
+        return;
+    }
+
+    if (length > 0) {
+        if (!native_audio_turn_active) {
+            native_audio_turn_active = true;
+            is_speaking = true;
+            if (tts.beginStream(GEMINI_AUDIO_SAMPLE_RATE)) {
+                // Nobody is draining the stream yet - hand playback to the audio task
+                if (!queueAudioCommand(AudioCommandType::PLAY_AUDIO_STREAM)) {
+                    Serial.println("❌ Failed to queue PLAY_AUDIO_STREAM command");
+                }
+            }
         }
-     } else {
-         Serial.printf("Tool call handler invoked for unknown tool: %s\n", toolName.c_str());
-     }
+        tts.writeStream(pcm, length);
+    }
+
+    if (turnComplete && native_audio_turn_active) {
+        native_audio_turn_active = false;
+        tts.endStream();
+    }
 }
 
 void playDingSound() {
@@ -299,7 +489,7 @@ String getSeverityLevel(const String& alertType) {
     }
 }
 
-void sendEmergencyAlert(const String& alertType, const String& description) {
+void sendEmergencyAlert(const String& alertType, const String& description, ToolCallId callId) {
     Serial.println("🚨 Emergency protocol activated!");
     Serial.printf("Alert Type: %s\n", alertType.c_str());
     Serial.printf("Description: %s\n", description.c_str());
@@ -352,37 +542,51 @@ void sendEmergencyAlert(const String& alertType, const String& description) {
     String jsonString;
     serializeJson(notificationDoc, jsonString);
     
-    // Send POST request to notifications API
-    HTTPClient http;
-    http.begin(String(NOTIFICATIONS_API_URL) + "/notifications");
-    http.addHeader("Content-Type", "application/json");
+    // Send POST request to notifications API (ahead of any other queued network work)
+    String url = String(NOTIFICATIONS_API_URL) + "/notifications";
     
     Serial.println("📡 Sending emergency notification to API...");
-    Serial.printf("URL: %s\n", String(NOTIFICATIONS_API_URL) + "/notifications");
+    Serial.printf("URL: %s\n", url.c_str());
     Serial.printf("JSON: %s\n", jsonString.c_str());
     
-    int httpResponseCode = http.POST(jsonString);
-    
-    if (httpResponseCode > 0) {
-        String response = http.getString();
-        Serial.printf("✅ Emergency notification sent successfully! Response code: %d\n", httpResponseCode);
-        Serial.printf("Response: %s\n", response.c_str());
+    // The tool call (if any) is answered once the alert is delivered or has failed
+    void* context = (void*)(uintptr_t)callId;
+    if (!networkExecutor.post("emergency", url, jsonString, "application/json", NetPriority::EMERGENCY,
+                              EMERGENCY_ALERT_TIMEOUT_MS, onEmergencyAlertResponse, context)) {
+        Serial.println("❌ Failed to queue emergency notification");
+        if (callId) {
+            visionAssistant.completeToolCall(callId, "Failed to queue emergency notification", true);
+        }
+    }
+}
+
+void onEmergencyAlertResponse(const NetResponse& response, void* context) {
+    ToolCallId callId = (ToolCallId)(uintptr_t)context;
+    bool delivered = response.statusCode > 0;
+    if (delivered) {
+        Serial.printf("✅ Emergency notification sent successfully! Response code: %d\n", response.statusCode);
+        Serial.printf("Response: %s\n", response.body.c_str());
     } else {
-        Serial.printf("❌ Failed to send emergency notification. Error code: %d\n", httpResponseCode);
-        Serial.printf("Error: %s\n", http.errorToString(httpResponseCode).c_str());
+        Serial.printf("❌ Failed to send emergency notification. Error code: %d\n", response.statusCode);
+        Serial.printf("Error: %s\n", HTTPClient::errorToString(response.statusCode).c_str());
+    }
+
+    if (callId) {
+        visionAssistant.completeToolCall(callId, delivered ? "Emergency notification sent (HTTP " + String(response.statusCode) + ")"
+                                                           : "Failed to send emergency notification (error " + String(response.statusCode) + ")",
+                                         !delivered);
     }
-    
-    http.end();
 }
 
-void handleSystemAction(const JsonDocument& doc) {
+void handleSystemAction(JsonObjectConst args, ToolCallId callId) {
     // Extract parameters
-    String intent = doc["intent"].as<String>();
-    bool shouldSpeak = doc["shouldSpeak"].as<bool>();
-    String message = doc["message"].as<String>();
-    String logEntry = doc["logEntry"].as<String>();
-    // String routeTo = doc["routeTo"].as<String>();
-    String routeParams = doc["routeParams"].as<String>();
+    String intent = args["intent"].as<String>();
+    bool shouldSpeak = args["shouldSpeak"].as<bool>();
+    String message = args["message"].as<String>();
+    String logEntry = args["logEntry"].as<String>();
+    // String routeTo = args["routeTo"].as<String>();
+    String routeParams = args["routeParams"].as<String>();
+    bool spoken = false;
     
     if (shouldSpeak) {
         Serial.printf("Intent: %s\n", intent.c_str());
@@ -392,22 +596,20 @@ void handleSystemAction(const JsonDocument& doc) {
         Serial.printf("Route Params: %s\n", routeParams.c_str());
     }
     
-    // Handle speaking if required
-    if (shouldSpeak && !message.isEmpty()) {
+    // Handle speaking if required (in native audio mode Gemini already speaks its own replies)
+    if (shouldSpeak && !message.isEmpty() && !visionAssistant.isNativeAudioEnabled()) {
         if (is_speaking) {
             Serial.println("🗣️ TTS is already active, dropping new speak request.");
+            visionAssistant.completeToolCall(callId, "Not spoken: already speaking");
             return;
         }
         if (ttsAvailable) {
             is_speaking = true; // Set flag before sending
-            AudioCommand cmd;
-            cmd.type = AudioCommandType::SPEAK_TEXT;
-            strncpy(cmd.text, message.c_str(), sizeof(cmd.text) - 1);
-            cmd.text[sizeof(cmd.text) - 1] = '\0'; // Ensure null termination
-            
-            if (xQueueSend(audioCommandQueue, &cmd, 0) != pdTRUE) {
+            if (!queueAudioCommand(AudioCommandType::SPEAK_TEXT, message)) {
                 Serial.println("❌ Failed to queue SPEAK_TEXT command");
                 is_speaking = false; // Reset flag if queueing failed
+            } else {
+                spoken = true;
             }
         } else {
             Serial.println("TTS not available to speak message.");
@@ -474,7 +676,8 @@ void handleSystemAction(const JsonDocument& doc) {
         }
         
         // Send emergency alert with determined type
-        sendEmergencyAlert(alertType, description);
+        sendEmergencyAlert(alertType, description, callId);
+        return; // Answered once the alert request finishes
     }
     else if (intent == "obstacle_alert") {
         Serial.println("⚠️ Obstacle alert detected!");
@@ -483,8 +686,10 @@ void handleSystemAction(const JsonDocument& doc) {
             Serial.printf("OBSTACLE LOG: %s\n", logEntry.c_str());
         }
         // Obstacle alerts should always be spoken for safety
-        if (!message.isEmpty() && ttsAvailable) {
-            tts.speakText(message);
+        if (!message.isEmpty() && ttsAvailable && !visionAssistant.isNativeAudioEnabled()) {
+            if (!queueAudioCommand(AudioCommandType::SPEAK_TEXT, message)) {
+                Serial.println("❌ Failed to queue SPEAK_TEXT command for obstacle alert");
+            }
         }
     }
     else if (intent == "contextual_assistance") {
@@ -537,6 +742,8 @@ void handleSystemAction(const JsonDocument& doc) {
     //     Serial.printf("Routing to: %s with params: %s\n", routeTo.c_str(), routeParams.c_str());
     //     // Add routing logic here as needed
     // }
+    
+    visionAssistant.completeToolCall(callId, "Handled intent " + intent + (spoken ? " (message spoken)" : ""));
 }
 
 String cleanTextForWakeWord(const String& text) {
@@ -579,15 +786,10 @@ void calculateBaselineAudioLevel() {
         return; // Safety check
     }
     
-    int16_t* samples = (int16_t*)command_buffer;
-    
-    float sum_squares = 0.0f;
-    for (int i = 0; i < samples_to_analyze; i++) {
-        float sample = (float)samples[i];
-        sum_squares += sample * sample;
-    }
+    // Levels come from the capture statistics - command sample i was captured at recording_start_sample + i
+    AudioWindowStats stats = captureStats.query(recording_start_sample, recording_start_sample + samples_to_analyze);
     
-    baseline_audio_level = sqrt(sum_squares / samples_to_analyze);
+    baseline_audio_level = stats.rms();
     baseline_calculated = true;
     
     Serial.printf("📊 Baseline audio level calculated: %.2f (from %d samples)\n", baseline_audio_level, samples_to_analyze);
@@ -607,15 +809,9 @@ bool isAudioSilent() {
         return false; // Safety check
     }
     
-    int16_t* samples = (int16_t*)command_buffer;
+    AudioWindowStats stats = captureStats.query(recording_start_sample + start_index, recording_start_sample + total_samples);
     
-    float sum_squares = 0.0f;
-    for (int i = start_index; i < start_index + samples_to_check && i < total_samples; i++) {
-        float sample = (float)samples[i];
-        sum_squares += sample * sample;
-    }
-    
-    float current_level = sqrt(sum_squares / samples_to_check);
+    float current_level = stats.rms();
     
     // Consider it silent if current level is less than 1.2x baseline + small threshold (made more sensitive)
     float silence_threshold = baseline_audio_level * 1.2f + 50.0f;
@@ -644,6 +840,7 @@ void initializeLanguageSettings() {
         
         // Set language for both STT and TTS
         deepgramClient.setDefaultLanguage(language);
+        speculativeStt.setDefaultLanguage(language);
         tts.setDefaultLanguage(language);
         
         Serial.printf("🎤 Deepgram STT language set to: %s\n", language.c_str());
@@ -653,6 +850,13 @@ void initializeLanguageSettings() {
     }
 }
 
+// Apply refreshed settings (runs from networkExecutor.poll() on the main loop)
+void onSettingsUpdated(const UserSettings& settings) {
+    deepgramClient.setDefaultLanguage(settings.language);
+    speculativeStt.setDefaultLanguage(settings.language);
+    tts.setDefaultLanguage(settings.language);
+}
+
 void setup() {
     Serial.begin(115200);
     Serial.println("Starting setup...");
@@ -662,13 +866,19 @@ void setup() {
     
     // Create synchronization primitives
     audioMutex = xSemaphoreCreateMutex();
-    commandQueue = xQueueCreate(5, sizeof(CommandMessage)); // Use CommandMessage struct instead of String
-    audioCommandQueue = xQueueCreate(5, sizeof(AudioCommand)); // Create audio command queue
+    bool queuesReady = messagePool.begin() && commandQueue.begin() && audioCommandQueue.begin();
+    voiceClipQueue = xQueueCreate(2, sizeof(VoiceClip));
+    loopEvents = xEventGroupCreate();
+    buttonEdgeQueue = xQueueCreate(8, sizeof(ButtonEdge));
+    buttonDebounceTimer = xTimerCreate("ButtonDebounce", pdMS_TO_TICKS(BUTTON_DEBOUNCE_MS), pdFALSE, nullptr, onButtonDebounced);
     
-    if (!audioMutex || !commandQueue || !audioCommandQueue) {
+    if (!audioMutex || !queuesReady || !voiceClipQueue || !loopEvents || !buttonEdgeQueue || !buttonDebounceTimer) {
         Serial.println("CRITICAL: Failed to create synchronization primitives!");
         while (true) delay(1000);
     }
+    commandQueue.notifyOnSend(loopEvents, LOOP_EVENT_COMMAND);
+    networkExecutor.notifyOnCompletion(loopEvents, LOOP_EVENT_NETWORK);
+    visionAssistant.notifyOnGpsData(loopEvents, LOOP_EVENT_GPS);
     
     // Print memory info at startup
     Serial.printf("🔧 Startup memory info:\n");
@@ -689,14 +899,12 @@ void setup() {
         Serial.println("PSRAM found, using ps_malloc.");
         wake_word_buffer = (uint8_t*)ps_malloc(WAKE_WORD_BUFFER_SIZE);
         command_buffer = (uint8_t*)ps_malloc(COMMAND_BUFFER_SIZE);
-        stt_temp_buffer = (uint8_t*)ps_malloc(WAKE_WORD_BUFFER_SIZE);
     }
     
-    if (!wake_word_buffer || !command_buffer || !stt_temp_buffer) {
+    if (!wake_word_buffer || !command_buffer) {
         Serial.println("CRITICAL: Failed to allocate audio buffers!");
         Serial.printf("Tried to allocate wake word buffer: %d bytes\n", WAKE_WORD_BUFFER_SIZE);
         Serial.printf("Tried to allocate command buffer: %d bytes\n", COMMAND_BUFFER_SIZE);
-        Serial.printf("Tried to allocate stt temp buffer: %d bytes\n", WAKE_WORD_BUFFER_SIZE);
         Serial.printf("Free heap: %d bytes\n", ESP.getFreeHeap());
         if (psramFound()) {
             Serial.printf("Free PSRAM: %d bytes\n", ESP.getFreePsram());
@@ -731,6 +939,30 @@ void setup() {
     // Initialize language settings after WiFi is connected
     initializeLanguageSettings();
     
+    // Start the network executor (HTTP requests from the main loop run on its task)
+    if (!networkExecutor.begin()) {
+        Serial.println("CRITICAL: Failed to start network executor!");
+        while (true) delay(1000);
+    }
+    
+    // Without it commands are still transcribed, just only after recording stops
+    if (!speculativeStt.begin()) {
+        Serial.println("⚠️ Speculative transcription unavailable");
+    }
+    
+    // Without an enrolled wake word the cloud search is used
+    wakeSpotter.begin();
+    captureStats.begin();
+    
+    // DC and rumble removal first, so the AGC measures the voice band only
+    captureDsp.addStage(&captureDcBlocker);
+    captureDsp.addStage(&captureHighPass);
+    captureDsp.addStage(&captureAgc);
+    if (AUDIO_NOISE_GATE_ENABLED) {
+        captureDsp.addStage(&captureNoiseGate);
+    }
+    wakeDecimator.logResponse(AUDIO_WAKE_SEARCH_PASSBAND_HZ);
+    
     // Start audio task on Core 0 (microphone will be initialized there)
     Serial.println("Starting audio task on Core 0...");
     xTaskCreatePinnedToCore(
@@ -794,17 +1026,19 @@ void setup() {
     }
     
     // Set the tool callback
-    visionAssistant.setToolCallback(toolHandler);
+    visionAssistant.registerTool("systemAction", systemActionTool);
+    visionAssistant.registerTool("getDirections", getDirectionsTool);
+    visionAssistant.registerTool("setWakeWord", setWakeWordTool);
+    visionAssistant.setAudioCallback(audioResponseHandler);
     
-    // Set up button pin
+    // Set up button pin: edges start the debounce timer, which reports the settled level
     pinMode(BUTTON_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButtonInterrupt, CHANGE);
     Serial.println("Button pin initialized.");
     
     // Play a ding sound to indicate setup is complete
     Serial.println("✅ Setup complete! Playing notification sound...");
-    AudioCommand setupCompleteDingCmd;
-    setupCompleteDingCmd.type = AudioCommandType::PLAY_BUTTON_DING;
-    if (xQueueSend(audioCommandQueue, &setupCompleteDingCmd, 0) != pdTRUE) {
+    if (!queueAudioCommand(AudioCommandType::PLAY_BUTTON_DING)) {
         Serial.println("❌ Failed to queue setup complete ding command");
     }
     
@@ -826,9 +1060,13 @@ void process_audio() {
     int32_t raw_buffer[read_buffer_size];
     size_t bytes_read = 0;
 
-    esp_err_t result = read_microphone_data(raw_buffer, sizeof(raw_buffer), &bytes_read);
+    // Event-driven: the task was woken for captured buffers, so take only what is ready. The
+    // driver reports ESP_ERR_TIMEOUT when that is less than the whole read buffer (usually one
+    // 256-sample DMA buffer) - the samples it did read are still good.
+    esp_err_t result = read_microphone_data(raw_buffer, sizeof(raw_buffer), &bytes_read, EVENT_DRIVEN_LOOPS ? 0 : 100);
+    bool partialRead = result == ESP_ERR_TIMEOUT && bytes_read > 0;
 
-    if (result == ESP_OK && bytes_read > 0) {
+    if ((result == ESP_OK || partialRead) && bytes_read > 0) {
         int samples_read = bytes_read / sizeof(int32_t);
         
         // Debug: Log microphone reading stats occasionally
@@ -841,20 +1079,42 @@ void process_audio() {
         if (millis() - last_read_debug > 5000) {  // Every 5 seconds
             float avg_bytes_per_read = (float)total_bytes / total_reads;
             float effective_sample_rate = (total_bytes / sizeof(int32_t)) / ((millis() - last_read_debug) / 1000.0);
-            Serial.printf("🎤 Mic stats: %d reads, avg %.1f bytes/read, ~%.0f samples/sec\n", 
-                         total_reads, avg_bytes_per_read, effective_sample_rate);
+            Serial.printf("🎤 Mic stats: %d reads, avg %.1f bytes/read, ~%.0f samples/sec, %u DMA overruns\n", 
+                         total_reads, avg_bytes_per_read, effective_sample_rate, micOverruns);
             last_read_debug = millis();
             total_reads = 0;
             total_bytes = 0;
         }
         
+        // Convert 32-bit samples to 16-bit units (same as working demo), then filter and level
+        // the whole block in place - the AGC replaces the old fixed 2x gain
+        for (int i = 0; i < samples_read; i++) {
+            raw_buffer[i] >>= 14;
+        }
+        captureDsp.process(raw_buffer, samples_read);
+        captureDsp.report(millis());
+        if (!wakeVad.isSpeech()) {
+            commandSuppressor.observeBackground(raw_buffer, samples_read);
+        } else {
+            commandSuppressor.interruptBackground();
+        }
+        
+        // Store the decimated block in the wake word buffer (continuous circular buffer)
+        int16_t wake_samples[read_buffer_size / AUDIO_WAKE_SEARCH_DECIMATION + 1];
+        int wake_count = wakeDecimator.process(raw_buffer, samples_read, wake_samples);
+        wakeDecimator.report(millis());
+        for (int i = 0; i < wake_count; i++) {
+            if (wake_word_buffer_index + 2 > WAKE_WORD_BUFFER_SIZE) {
+                wake_word_buffer_has_wrapped = true;
+                wake_word_buffer_index = 0;
+            }
+            memcpy(wake_word_buffer + wake_word_buffer_index, &wake_samples[i], 2);
+            wake_word_buffer_index += 2;
+        }
+        
         // Process each sample
         for (int i = 0; i < samples_read; i++) {
-            // Convert 32-bit sample to 16-bit (same as working demo)
-            int32_t sample = raw_buffer[i] >> 14;
-
-            // Apply digital gain (reduced from 5 to 2 like working demo)
-            sample = sample * 2;
+            int32_t sample = raw_buffer[i];
 
             // Clip to 16-bit range to prevent overflow
             if (sample > 32767) {
@@ -866,20 +1126,11 @@ void process_audio() {
             int16_t sample16 = (int16_t)sample;
             uint8_t* sample_bytes = (uint8_t*)&sample16;
             
-            // Store in wake word buffer (continuous circular buffer) - ensure we have space for 2 bytes
-            if (wake_word_buffer_index + 2 <= WAKE_WORD_BUFFER_SIZE) {
-                wake_word_buffer[wake_word_buffer_index] = sample_bytes[0];
-                wake_word_buffer[wake_word_buffer_index + 1] = sample_bytes[1];
-                wake_word_buffer_index += 2;
-            } else {
-                // Buffer is full, wrap to beginning (circular buffer)
-                wake_word_buffer_has_wrapped = true;
-                wake_word_buffer_index = 0;
-                if (wake_word_buffer_index + 2 <= WAKE_WORD_BUFFER_SIZE) {
-                    wake_word_buffer[wake_word_buffer_index] = sample_bytes[0];
-                    wake_word_buffer[wake_word_buffer_index + 1] = sample_bytes[1];
-                    wake_word_buffer_index += 2;
-                }
+            wakeVad.addSample(sample16);
+            captureStats.addSample(sample16);
+            wakePrefilter.addSample(sample16);
+            if (wakeSpotter.isActive() && wakeMfcc.addSample(sample16)) {
+                wakeSpotter.addFrame(wakeMfcc.getFeatures(), wakeVad.getSampleCount());
             }
             
             // Store in command buffer if recording - ensure we have space for 2 bytes
@@ -888,13 +1139,9 @@ void process_audio() {
                 command_buffer[command_buffer_index + 1] = sample_bytes[1];
                 command_buffer_index += 2;
             }
-            
-            // Increment sequence every 1000 samples to track buffer updates
-            if ((wake_word_buffer_index % 2000) == 0) {
-                buffer_sequence++;
-            }
         }
-    } else if (result != ESP_OK) {
+        wake_word_buffer_end_sample = wakeVad.getSampleCount();
+    } else if (result != ESP_OK && !(result == ESP_ERR_TIMEOUT && EVENT_DRIVEN_LOOPS)) {
         static unsigned long last_error = 0;
         if (millis() - last_error > 10000) {  // Log error every 10 seconds
             Serial.printf("Microphone read error: %s\n", esp_err_to_name(result));
@@ -915,29 +1162,33 @@ void audioTask(void *pvParameters) {
     // Give microphone additional time to stabilize (like in working demo)
     delay(1000);
     
-    unsigned long last_stt_time = 0;
     unsigned long recording_start_time = 0;
     
     while (true) {
+        // Sleep until the microphone has filled a DMA buffer or a command is queued
+        audioWake.asleep();
+        audioWake.awake(waitForAudioWork());
+
         // Check for commands from the main core
-        AudioCommand receivedCmd;
-        if (xQueueReceive(audioCommandQueue, &receivedCmd, 0) == pdTRUE) {
+        MessageHandle receivedCmd;
+        if (audioCommandQueue.receive(receivedCmd)) {
+            AudioCommandType type = (AudioCommandType)messagePool.type(receivedCmd);
             bool micWasActive = is_microphone_active();
             if (micWasActive) {
                 stop_microphone();
             }
 
-            if (receivedCmd.type == AudioCommandType::SPEAK_TEXT) {
-                Serial.printf("🎤 Audio task received SPEAK_TEXT: \"%s\"\n", receivedCmd.text);
-                tts.speakText(String(receivedCmd.text));
+            if (type == AudioCommandType::SPEAK_TEXT) {
+                Serial.printf("🎤 Audio task received SPEAK_TEXT: \"%s\"\n", messagePool.text(receivedCmd));
+                tts.speakText(String(messagePool.text(receivedCmd)));
                 is_speaking = false; // Reset flag after speaking is done
-            } else if (receivedCmd.type == AudioCommandType::PLAY_DING) {
+            } else if (type == AudioCommandType::PLAY_DING) {
                 Serial.println("🎤 Audio task received PLAY_DING");
                 playDingSound();
-            } else if (receivedCmd.type == AudioCommandType::PLAY_BUTTON_DING) {
+            } else if (type == AudioCommandType::PLAY_BUTTON_DING) {
                 Serial.println("🎤 Audio task received PLAY_BUTTON_DING");
                 playButtonDingSound();
-            } else if (receivedCmd.type == AudioCommandType::START_RECORDING) {
+            } else if (type == AudioCommandType::START_RECORDING) {
                 Serial.println("🎤 Audio task received START_RECORDING");
                 if (is_speaking) {
                     Serial.println("🚫 Button pressed during speech - cancelling TTS...");
@@ -946,6 +1197,7 @@ void audioTask(void *pvParameters) {
                 
                 is_recording = true;
                 recording_start_time = millis();
+                resetCommandProcessing();
                 Serial.println("Recording command (button press)...");
                 
                 if (xSemaphoreTake(audioMutex, portMAX_DELAY)) {
@@ -956,12 +1208,26 @@ void audioTask(void *pvParameters) {
                     }
                     xSemaphoreGive(audioMutex);
                 }
-            } else if (receivedCmd.type == AudioCommandType::STOP_RECORDING_AND_PROCESS) {
+            } else if (type == AudioCommandType::STOP_RECORDING_AND_PROCESS) {
                 Serial.println("🎤 Audio task received STOP_RECORDING_AND_PROCESS");
                 if (is_recording) {
                     processRecordedCommand();
                 }
+            } else if (type == AudioCommandType::PLAY_AUDIO_STREAM) {
+                Serial.println("🎤 Audio task received PLAY_AUDIO_STREAM");
+                tts.playStream();
+                is_speaking = false; // Reset flag after the streamed turn is done
+            } else if (type == AudioCommandType::ENROLL_WAKE_WORD) {
+                Serial.println("🎤 Audio task received ENROLL_WAKE_WORD");
+                tts.speakText("After each ding, say your new wake word.");
+                playDingSound();
+                wakeSpotter.startEnrollment(wakeVad.getSampleCount(), millis());
+            } else if (type == AudioCommandType::CLEAR_WAKE_WORD) {
+                Serial.println("🎤 Audio task received CLEAR_WAKE_WORD");
+                wakeSpotter.clear();
+                tts.speakText("Personal wake word removed.");
             }
+            messagePool.release(receivedCmd);
 
             if (micWasActive) {
                 setup_microphone();
@@ -974,145 +1240,102 @@ void audioTask(void *pvParameters) {
             xSemaphoreGive(audioMutex);
         }
 
-        // Speech-to-text processing every 1 second for wake word detection (only when not recording)
-        // Note: Wake word detection uses Deepgram's search API for acoustic pattern matching
-        // Command transcription after wake word still uses regular transcription API
-        if (!is_recording && millis() - last_stt_time > 1000) {
-            last_stt_time = millis();
-
-            // Check if wake word buffer is allocated and has sufficient data
-            if (!wake_word_buffer || (!wake_word_buffer_has_wrapped && wake_word_buffer_index < 8000)) {
-                // Add debug info about buffer state
-                static unsigned long last_debug = 0;
-                if (millis() - last_debug > 10000) {  // Debug every 10 seconds
-                    Serial.printf("Wake word buffer state: allocated=%s, index=%d, required=8000, wrapped=%s\n", 
-                                wake_word_buffer ? "yes" : "no", wake_word_buffer_index, 
-                                wake_word_buffer_has_wrapped ? "yes" : "no");
-                    
-                    // Show some sample values to see if we're getting real audio data
-                    if (wake_word_buffer && wake_word_buffer_index > 100) {
-                        int16_t* samples = (int16_t*)wake_word_buffer;
-                        Serial.printf("Sample audio values: %d, %d, %d, %d, %d\n", 
-                                    samples[0], samples[1], samples[10], samples[50], samples[100]);
-                    }
-                    
-                    // Check buffer bounds
-                    if (wake_word_buffer_index > WAKE_WORD_BUFFER_SIZE) {
-                        Serial.printf("❌ CRITICAL: Wake word buffer index out of bounds: %d > %d\n", 
-                                    wake_word_buffer_index, WAKE_WORD_BUFFER_SIZE);
-                        wake_word_buffer_index = 0; // Reset to prevent corruption
-                        wake_word_buffer_has_wrapped = false;
-                    }
-                    
-                    Serial.printf("Buffer sequence: %u\n", buffer_sequence);
-                    last_debug = millis();
-                }
-                continue;
-            }
-
-            // Create a temporary buffer with the last 3 seconds of audio
-            if (!stt_temp_buffer) {
-                Serial.println("STT temp buffer not allocated");
-                continue;
-            }
-            uint8_t* temp_buffer = stt_temp_buffer;
-            
-            int current_index;
-            bool has_wrapped;
-            uint32_t current_sequence;
-            static uint32_t last_transcribed_sequence = 0;
-            
-            if (xSemaphoreTake(audioMutex, portMAX_DELAY)) {
-                current_index = wake_word_buffer_index;
-                has_wrapped = wake_word_buffer_has_wrapped;
-                current_sequence = buffer_sequence;
-                
-                // Only transcribe if we have new audio data
-                if (current_sequence == last_transcribed_sequence) {
-                    xSemaphoreGive(audioMutex);
-                    continue; // Skip transcription - no new audio
-                }
-                
-                // Copy the most recent audio data in proper circular buffer order
-                if (has_wrapped) {
-                    // Buffer has wrapped - copy from current position to end, then from start to current
-                    int bytes_from_current_to_end = WAKE_WORD_BUFFER_SIZE - current_index;
-                    memcpy(stt_temp_buffer, wake_word_buffer + current_index, bytes_from_current_to_end);
-                    memcpy(stt_temp_buffer + bytes_from_current_to_end, wake_word_buffer, current_index);
-                } else {
-                    // Buffer hasn't wrapped yet, copy what we have and pad with zeros
-                    memcpy(stt_temp_buffer, wake_word_buffer, current_index);
-                    memset(stt_temp_buffer + current_index, 0, WAKE_WORD_BUFFER_SIZE - current_index);
-                }
-                
-                // Update the last transcribed sequence
-                last_transcribed_sequence = current_sequence;
-                
-                // Debug: show buffer state
-                static unsigned long lastBufferDebug = 0;
-                if (millis() - lastBufferDebug > 5000) {
-                    Serial.printf("Buffer debug: index=%d, wrapped=%s, seq=%u, samples=[%d,%d,%d]\n", 
-                                current_index, has_wrapped ? "yes" : "no", current_sequence,
-                                ((int16_t*)wake_word_buffer)[0], ((int16_t*)wake_word_buffer)[1], ((int16_t*)wake_word_buffer)[2]);
-                    lastBufferDebug = millis();
-                }
-                
-                xSemaphoreGive(audioMutex);
-            }
+        // Talk the user through wake word enrollment
+        switch (wakeSpotter.pollEnrollment(wakeVad, millis())) {
+            case WakeWordSpotter::EnrollResult::CAPTURED:
+                queueEnrollmentPrompt(nullptr);
+                break;
+            case WakeWordSpotter::EnrollResult::REJECTED:
+                queueEnrollmentPrompt("Please say just the wake word.");
+                break;
+            case WakeWordSpotter::EnrollResult::COMPLETE:
+                queueEnrollmentPrompt("Got it. Your new wake word is ready.");
+                break;
+            case WakeWordSpotter::EnrollResult::FAILED:
+                queueEnrollmentPrompt("Sorry, I couldn't save your wake word.");
+                break;
+            case WakeWordSpotter::EnrollResult::TIMED_OUT:
+                queueEnrollmentPrompt("I didn't hear anything, so your wake word is unchanged.");
+                break;
+            default:
+                break;
+        }
 
-            // Only transcribe if we have enough real audio data (not just zeros)
-            bool hasRealAudio = false;
-            int16_t* samples = (int16_t*)stt_temp_buffer;
-            int sampleCount = WAKE_WORD_BUFFER_SIZE / 2;
-            for (int i = 0; i < sampleCount; i++) {
-                if (abs(samples[i]) > 50) { // Threshold for real audio
-                    hasRealAudio = true;
-                    break;
-                }
+        // Wake word detection: an enrolled personal wake word is matched on the device; otherwise the
+        // VAD-driven scheduler decides when a stretch of speech is worth a Deepgram search (acoustic
+        // search API). Command transcription still uses the regular API.
+        WakeWindow wakeWindow;
+        bool wakeWordDetected = false;
+        if (is_recording || wakeSpotter.isEnrolling()) {
+            wakeScheduler.skipTo(wakeVad.getSampleCount());  // Command audio isn't searched for wake words
+            wakeSpotter.takeDetection();
+        } else if (wakeSpotter.isEnrolled()) {
+            wakeScheduler.skipTo(wakeVad.getSampleCount());
+            wakeWordDetected = wakeSpotter.takeDetection();
+            if (wakeWordDetected) {
+                Serial.println("🎙️ Personal wake word detected on device!");
             }
-
-            bool wakeWordDetected = false;
-            if (hasRealAudio) {
-                // Use Deepgram's search API for wake word detection instead of transcription
-                Serial.println("🔍 Searching for wake words using Deepgram search API...");
-                // TODO INCREASE CONFIDENCE
-                wakeWordDetected = deepgramClient.searchForWakeWords(stt_temp_buffer, WAKE_WORD_BUFFER_SIZE, WAKE_WORDS, WAKE_WORDS_COUNT, 0.60f);
-                
-                if (wakeWordDetected) {
-                    Serial.println("✅ Wake word detected via search API!");
-                }
+        } else if (wake_word_buffer && wakeScheduler.nextWindow(wakeVad, millis(), wakeWindow) &&
+                   !prefilterRejects(wakeWindow)) {
+            // Upload the window straight out of the ring buffer, oldest part first. Window positions
+            // are capture samples; the ring holds the decimated stream.
+            // Only this task writes the ring (process_audio), so it can't change during the upload.
+            uint32_t startOffset = wakeRingOffset(wakeWindow.start);
+            uint32_t endOffset = wakeRingOffset(wakeWindow.end);
+            PcmSegment segments[2];
+            int segmentCount = 1;
+            segments[0].data = wake_word_buffer + startOffset;
+            if (startOffset < endOffset) {
+                segments[0].size = endOffset - startOffset;
             } else {
-                Serial.println("No real audio detected in buffer, skipping wake word search");
+                // Window wraps - start offset to end of ring, then from the beginning
+                segments[0].size = WAKE_WORD_BUFFER_SIZE - startOffset;
+                segments[1].data = wake_word_buffer;
+                segments[1].size = endOffset;
+                segmentCount = 2;
             }
 
+            Serial.printf("🔍 Searching %u ms of speech for wake words (noise floor %u, energy %u)...\n",
+                          (wakeWindow.end - wakeWindow.start) / (SAMPLE_RATE / 1000),
+                          wakeVad.getNoiseFloor(), wakeVad.getLastEnergy());
+            // TODO INCREASE CONFIDENCE
+            AudioWindowStats windowStats = captureStats.query(wakeWindow.start, wakeWindow.end);
+            wakeWordDetected = deepgramClient.searchForWakeWords(segments, segmentCount, WAKE_WORDS, WAKE_WORDS_COUNT, 0.60f,
+                                                                 &windowStats, WAKE_SEARCH_SAMPLE_RATE);
+            wakeScheduler.onSearchComplete(wakeWindow, wakeWordDetected, millis());
+            wakePrefilter.recordOutcome(wakePrefilterScore, true, wakeWordDetected);
             if (wakeWordDetected) {
                 Serial.println("🎙️ Wake word detected via Deepgram search API!");
-                
-                // If TTS is active, cancel it immediately
-                if (is_speaking) {
-                    Serial.println("🚫 Wake word detected during speech - cancelling TTS...");
-                    tts.cancel();
-                }
-                
-                // Queue a ding sound to be played by the audio task, which will handle I2S switching
-                AudioCommand dingCmd;
-                dingCmd.type = AudioCommandType::PLAY_DING;
-                if (xQueueSend(audioCommandQueue, &dingCmd, 0) != pdTRUE) {
-                    Serial.println("❌ Failed to queue PLAY_DING command");
-                }
-                
-                is_recording = true;
-                recording_start_time = millis();
-                Serial.println("Recording command (max 15 seconds)...");
-                
-                if (xSemaphoreTake(audioMutex, portMAX_DELAY)) {
-                    command_buffer_index = 0; // Clear command buffer to start recording new audio
-                    baseline_calculated = false; // Reset baseline
-                    if (command_buffer) {
-                        memset(command_buffer, 0, COMMAND_BUFFER_SIZE); // Clear the command buffer
-                    }
-                    xSemaphoreGive(audioMutex);
+            }
+        }
+        wakeScheduler.report(millis());
+        wakePrefilter.report(millis());
+        wakeSpotter.report(millis());
+
+        if (wakeWordDetected) {
+            // If TTS is active, cancel it immediately
+            if (is_speaking) {
+                Serial.println("🚫 Wake word detected during speech - cancelling TTS...");
+                tts.cancel();
+            }
+            
+            // Queue a ding sound to be played by the audio task, which will handle I2S switching
+            if (!queueAudioCommand(AudioCommandType::PLAY_DING)) {
+                Serial.println("❌ Failed to queue PLAY_DING command");
+            }
+            
+            is_recording = true;
+            recording_start_time = millis();
+            resetCommandProcessing();
+            Serial.println("Recording command (max 15 seconds)...");
+            
+            if (xSemaphoreTake(audioMutex, portMAX_DELAY)) {
+                command_buffer_index = 0; // Clear command buffer to start recording new audio
+                baseline_calculated = false; // Reset baseline
+                if (command_buffer) {
+                    memset(command_buffer, 0, COMMAND_BUFFER_SIZE); // Clear the command buffer
                 }
+                xSemaphoreGive(audioMutex);
             }
         }
 
@@ -1130,6 +1353,24 @@ void audioTask(void *pvParameters) {
                 }
             }
 
+            // Denoise what has been recorded so far (up to one hop behind the newest audio)
+            int suppressed = commandSuppressor.process(command_buffer_index / 2) * 2;
+
+            // At each pause in the command, transcribe what we have so far in the background.
+            // If the user doesn't speak again, that transcript is the final one.
+            uint32_t speechEnd = wakeVad.getSpeechEnd();
+            bool audioCommandMode = visionAssistant.isAudioCommandsEnabled() && visionAssistant.isSetupComplete();
+            if (!audioCommandMode && !wakeVad.isSpeech() && (int32_t)(speechEnd - recording_start_sample) > 0 &&
+                speechEnd != speculative_speech_end && !speculativeStt.isBusy()) {
+                int recorded = suppressed;  // Only the denoised part - the rest still changes
+                AudioWindowStats recordedStats = captureStats.query(recording_start_sample, recording_start_sample + recorded / 2);
+                if (recorded > 8000 && recorded <= COMMAND_BUFFER_SIZE &&
+                    speculativeStt.start(recording_id, command_buffer, recorded, &recordedStats)) {
+                    speculative_speech_end = speechEnd;
+                    speculative_bytes = recorded;
+                }
+            }
+
             // Check for silence after baseline is calculated and at least 3 seconds have passed
             bool shouldStopForSilence = false;
             if (baseline_calculated && millis() - recording_start_time > 3000) { // Wait 3 seconds before checking silence
@@ -1177,87 +1418,246 @@ void audioTask(void *pvParameters) {
             }
         }
 
-        // Small delay to prevent watchdog issues
+        audioWake.report(millis());
+    }
+}
+
+// Blocks the audio task until there is something to do; false if it woke on the timeout
+bool waitForAudioWork() {
+    if (!EVENT_DRIVEN_LOOPS) {
         vTaskDelay(pdMS_TO_TICKS(10));
+        return false;
+    }
+    if (audioCommandQueue.pending() > 0) {
+        return true;
+    }
+    // While capturing, the DMA buffers (16 ms each) pace the task and queued commands are
+    // picked up with the next buffer; otherwise the command queue itself wakes it
+    if (is_microphone_active() && wake_word_buffer && command_buffer) {
+        return wait_for_microphone_data(pdMS_TO_TICKS(AUDIO_MAX_SLEEP_MS), &micOverruns);
+    }
+    return audioCommandQueue.waitForMessage(pdMS_TO_TICKS(AUDIO_MAX_SLEEP_MS));
+}
+
+// Blocks the main loop until an event arrives or the WebSocket poll is due
+void waitForLoopWork() {
+    if (!EVENT_DRIVEN_LOOPS) {
+        delay(10);
+        loopWake.awake(false);
+        return;
+    }
+    // More queued work than the last pass handled - go straight round again
+    // (an audio command upload also sends its next chunk on the next pass)
+    if (commandQueue.pending() > 0 || visionAssistant.isStreamingAudioCommand() ||
+        uxQueueMessagesWaiting(voiceClipQueue) > 0 || uxQueueMessagesWaiting(buttonEdgeQueue) > 0) {
+        loopWake.awake(true);
+        return;
+    }
+    // Unsolicited server messages (goAway, resumption updates) can wait a little; replies can't
+    unsigned long sleepMs = visionAssistant.isLinkIdle() ? LOOP_IDLE_SLEEP_MS : LOOP_MAX_SLEEP_MS;
+    EventBits_t events = xEventGroupWaitBits(loopEvents, LOOP_EVENTS_ALL, pdTRUE, pdFALSE, pdMS_TO_TICKS(sleepMs));
+    loopWake.awake((events & LOOP_EVENTS_ALL) != 0);
+}
+
+// Byte offset of a capture sample in the decimated wake word ring. Counted back from the write
+// position, so it stays right when the 32-bit capture sample counter wraps (~74 h).
+uint32_t wakeRingOffset(uint32_t sample) {
+    const uint32_t ringSamples = WAKE_WORD_BUFFER_SIZE / 2;
+    uint32_t back = (wake_word_buffer_end_sample - sample) / AUDIO_WAKE_SEARCH_DECIMATION % ringSamples;
+    return (wake_word_buffer_index / 2 + ringSamples - back) % ringSamples * 2;
+}
+
+// Local first stage of the cloud wake word search: true if the window isn't worth uploading
+bool prefilterRejects(const WakeWindow& window) {
+    wakePrefilterScore = wakePrefilter.score(window.start, window.end);
+    if (!AUDIO_WAKE_PREFILTER_ENABLED || AUDIO_WAKE_PREFILTER_SHADOW || wakePrefilter.passes(wakePrefilterScore)) {
+        return false;
+    }
+    Serial.printf("🔕 Skipping wake word search: %u ms of speech scored %d\n",
+                  (window.end - window.start) / (SAMPLE_RATE / 1000), wakePrefilterScore);
+    wakePrefilter.recordOutcome(wakePrefilterScore, false, false);
+    wakeScheduler.onSearchSkipped();
+    return true;
+}
+
+// Called whenever a new command recording starts - results for older recordings are never used
+void resetCommandProcessing() {
+    // A job from the last recording may still be uploading straight from command_buffer - let it
+    // finish before the new recording clears and refills the buffer (its result is discarded)
+    if (speculativeStt.isBusy()) {
+        unsigned long waitStart = millis();
+        if (speculativeStt.waitUntilIdle(SPECULATIVE_STT_WAIT_MS)) {
+            Serial.printf("⏳ Waited %lu ms for the previous speculative upload to finish\n", millis() - waitStart);
+        } else {
+            Serial.println("⚠️ Previous speculative upload still running - its audio will be overwritten");
+        }
+    }
+    commandSuppressor.start((int16_t*)command_buffer);
+    recording_id++;
+    recording_start_sample = wakeVad.getSampleCount();
+    speculative_speech_end = 0;
+    speculative_bytes = 0;
+}
+
+// Feedback during wake word enrollment (queued from the audio task to itself): optional speech,
+// then a ding while there are more utterances to record
+void queueEnrollmentPrompt(const char* text) {
+    if (text && ttsAvailable) {
+        is_speaking = true;
+        if (!queueAudioCommand(AudioCommandType::SPEAK_TEXT, text)) {
+            Serial.println("❌ Failed to queue enrollment prompt");
+            is_speaking = false;
+        }
+    }
+    if (wakeSpotter.isEnrolling()) {
+        if (!queueAudioCommand(AudioCommandType::PLAY_DING)) {
+            Serial.println("❌ Failed to queue PLAY_DING command");
+        }
     }
 }
 
 void processRecordedCommand() {
     is_recording = false;
+    unsigned long recordingEndTime = millis();
+    commandSuppressor.finish(command_buffer_index / 2);
     
     // Play a ding sound to indicate the command was transcribed
-    AudioCommand buttonDingCmd;
-    buttonDingCmd.type = AudioCommandType::PLAY_BUTTON_DING;
-    if (xQueueSend(audioCommandQueue, &buttonDingCmd, 0) != pdTRUE) {
+    if (!queueAudioCommand(AudioCommandType::PLAY_BUTTON_DING)) {
         Serial.println("❌ Failed to queue PLAY_BUTTON_DING command");
     }
 
-    if (command_buffer && command_buffer_index > 8000) { // Need at least 0.5s of audio
-        uint8_t* temp_command_buffer = (uint8_t*)malloc(command_buffer_index);
-        if (temp_command_buffer && xSemaphoreTake(audioMutex, portMAX_DELAY)) {
-            if (command_buffer_index <= COMMAND_BUFFER_SIZE) {
-                memcpy(temp_command_buffer, command_buffer, command_buffer_index);
-                int buffer_size = command_buffer_index;
-                xSemaphoreGive(audioMutex);
+    // Audio command mode: hand the raw PCM to the main loop, which streams it on the Gemini socket
+    if (visionAssistant.isAudioCommandsEnabled() && visionAssistant.isSetupComplete() &&
+        command_buffer && command_buffer_index > 8000) {
+        VoiceClip clip;
+        clip.pcm = nullptr;
+        clip.size = 0;
+        clip.recordedAt = recordingEndTime;
+        if (xSemaphoreTake(audioMutex, portMAX_DELAY)) {
+            int recorded_bytes = command_buffer_index;
+            clip.size = (recorded_bytes <= COMMAND_BUFFER_SIZE) ? recorded_bytes : COMMAND_BUFFER_SIZE;
+            clip.pcm = (uint8_t*)ps_malloc(clip.size);
+            if (clip.pcm) {
+                memcpy(clip.pcm, command_buffer, clip.size);
+            }
+            xSemaphoreGive(audioMutex);
+        }
+        if (clip.pcm) {
+            Serial.printf("🎤 Handing %u bytes of command audio to Gemini\n", clip.size);
+            if (xQueueSend(voiceClipQueue, &clip, 0) != pdTRUE) {
+                Serial.println("Failed to queue voice clip");
+                free(clip.pcm);
+            } else {
+                xEventGroupSetBits(loopEvents, LOOP_EVENT_VOICE_CLIP);
+            }
+            return;
+        }
+        Serial.println("Failed to copy voice clip - falling back to transcription");
+    }
 
+    if (command_buffer && command_buffer_index > 8000) { // Need at least 0.5s of audio
+        // Upload straight from command_buffer - only this task records into or clears it, and
+        // recording has stopped, so it stays unchanged until the upload finishes
+        int buffer_size = 0;
+        if (xSemaphoreTake(audioMutex, portMAX_DELAY)) {
+            buffer_size = command_buffer_index;
+            xSemaphoreGive(audioMutex);
+        }
+        if (buffer_size <= COMMAND_BUFFER_SIZE) {
+            // Reuse the transcript started at the last pause if no speech came after it - the
+            // trailing silence recorded since then adds nothing to the transcript
+            String command;
+            bool speculative = speculative_bytes > 0 && !wakeVad.isSpeech() &&
+                               wakeVad.getSpeechEnd() == speculative_speech_end &&
+                               speculativeStt.takeResult(recording_id, speculative_bytes, command, SPECULATIVE_STT_WAIT_MS);
+            if (!speculative) {
                 Serial.printf("🎤 Processing %d bytes of command audio\n", buffer_size);
-                String command = deepgramClient.transcribe(temp_command_buffer, buffer_size);
-                Serial.println("Command: " + command);
-
-                if (!command.isEmpty()) {
-                    CommandMessage cmdMsg;
-                    strncpy(cmdMsg.command, command.c_str(), sizeof(cmdMsg.command) - 1);
-                    cmdMsg.command[sizeof(cmdMsg.command) - 1] = '\0';
-                    if (xQueueSend(commandQueue, &cmdMsg, 0) != pdTRUE) {
-                        Serial.println("Failed to queue command");
-                    }
+                AudioWindowStats commandStats = captureStats.query(recording_start_sample, recording_start_sample + buffer_size / 2);
+                command = deepgramClient.transcribe(command_buffer, buffer_size, &commandStats);
+            }
+            Serial.println("Command: " + command);
+
+            if (!command.isEmpty()) {
+                if (!commandQueue.send(0, command.c_str(), command.length(), recordingEndTime)) {
+                    Serial.println("Failed to queue command");
                 }
-                free(temp_command_buffer);
-            } else {
-                Serial.printf("❌ Command buffer index out of bounds: %d > %d\n", command_buffer_index, COMMAND_BUFFER_SIZE);
-                xSemaphoreGive(audioMutex);
-                free(temp_command_buffer);
             }
         } else {
-            Serial.println("Failed to allocate temp command buffer or get mutex");
-            if (temp_command_buffer) free(temp_command_buffer);
+            Serial.printf("❌ Command buffer index out of bounds: %d > %d\n", buffer_size, COMMAND_BUFFER_SIZE);
         }
     } else {
         Serial.printf("Not enough audio data recorded: %d bytes\n", command_buffer_index);
     }
 }
 
+// Button GPIO interrupt: (re)start the debounce timer on every edge of a bounce burst
+void IRAM_ATTR onButtonInterrupt() {
+    if (!buttonEdgePending) {
+        buttonFirstEdgeMicros = micros();
+        buttonEdgePending = true;
+    }
+    BaseType_t woken = pdFALSE;
+    xTimerResetFromISR(buttonDebounceTimer, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+// Runs on the timer task once the button has been still for BUTTON_DEBOUNCE_MS
+void onButtonDebounced(TimerHandle_t timer) {
+    static bool settled_state = HIGH;
+    bool state = digitalRead(BUTTON_PIN);
+    buttonEdgePending = false;
+    if (state == settled_state) {
+        return; // Bounced back to where it was
+    }
+    settled_state = state;
+
+    ButtonEdge edge;
+    edge.pressed = state == LOW;
+    edge.at = millis();
+    edge.firstEdgeMicros = buttonFirstEdgeMicros;
+    if (xQueueSend(buttonEdgeQueue, &edge, 0) != pdTRUE) {
+        Serial.println("❌ Button edge queue full - dropping edge");
+    }
+    xEventGroupSetBits(loopEvents, LOOP_EVENT_BUTTON);
+}
+
 void handleButton() {
-    static bool last_button_state = HIGH;
     static bool button_held_down = false;
     static int short_press_count = 0;
     static unsigned long last_press_time = 0;
     static unsigned long press_start_time = 0;
 
-    bool current_button_state = digitalRead(BUTTON_PIN);
-
-    // Button pressed
-    if (current_button_state == LOW && last_button_state == HIGH) {
-        delay(50); // Debounce
-        if (digitalRead(BUTTON_PIN) == LOW) {
-            press_start_time = millis();
+    ButtonEdge edge;
+    while (xQueueReceive(buttonEdgeQueue, &edge, 0) == pdTRUE) {
+        // Button pressed
+        if (edge.pressed) {
+            press_start_time = edge.at;
             button_held_down = true;
 
             // Check if this press is part of an SOS sequence
-            if (millis() - last_press_time < 1000) { // 1 second between presses for SOS
+            if (edge.at - last_press_time < 1000) { // 1 second between presses for SOS
                 short_press_count++;
             } else {
                 short_press_count = 1; // Reset if too much time has passed
             }
-            last_press_time = millis();
+            last_press_time = edge.at;
 
             Serial.printf("Button pressed, count: %d\n", short_press_count);
+
+            // Start recording right away unless this press completes an SOS sequence
+            if (short_press_count < 5 && !is_recording) {
+                Serial.println("Starting push-to-talk recording.");
+                if (!queueAudioCommand(AudioCommandType::START_RECORDING)) {
+                    Serial.println("❌ Failed to queue START_RECORDING command");
+                }
+            }
+            loopWake.recordLatency(micros() - edge.firstEdgeMicros);
         }
-    }
-    // Button released
-    else if (current_button_state == HIGH && last_button_state == LOW) {
-        if (button_held_down) {
-            unsigned long press_duration = millis() - press_start_time;
+        // Button released
+        else if (button_held_down) {
+            unsigned long press_duration = edge.at - press_start_time;
 
             if (press_duration < 500) { // Short press
                 Serial.printf("Short press detected (duration: %lu ms)\n", press_duration);
@@ -1269,9 +1669,7 @@ void handleButton() {
             } else { // Long press (push-to-talk)
                 Serial.printf("Long press detected (duration: %lu ms) - stopping recording.\n", press_duration);
                 short_press_count = 0; // Reset SOS count on long press
-                AudioCommand cmd;
-                cmd.type = AudioCommandType::STOP_RECORDING_AND_PROCESS;
-                if (xQueueSend(audioCommandQueue, &cmd, 0) != pdTRUE) {
+                if (!queueAudioCommand(AudioCommandType::STOP_RECORDING_AND_PROCESS)) {
                     Serial.println("❌ Failed to queue STOP_RECORDING_AND_PROCESS command");
                 }
             }
@@ -1279,29 +1677,15 @@ void handleButton() {
         }
     }
 
-    // Start recording on initial press if it's not an SOS sequence that's about to trigger
-    if (button_held_down && (millis() - press_start_time > 50) && (millis() - press_start_time < 100) && short_press_count < 5) {
-        if (!is_recording) {
-            Serial.println("Starting push-to-talk recording.");
-            AudioCommand cmd;
-            cmd.type = AudioCommandType::START_RECORDING;
-            if (xQueueSend(audioCommandQueue, &cmd, 0) != pdTRUE) {
-                Serial.println("❌ Failed to queue START_RECORDING command");
-            }
-        }
-    }
-
     // Reset SOS count if time between presses is too long
     if (short_press_count > 0 && millis() - last_press_time > 1000) {
         // Serial.println("Resetting SOS count due to timeout.");
         short_press_count = 0;
     }
-
-    last_button_state = current_button_state;
 }
 
 void checkAndAnnounceNearbyPlaces() {
-    if (millis() - last_places_check_time < 30000) { // Check every 30 seconds
+    if (places_request_in_flight || millis() - last_places_check_time < 30000) { // Check every 30 seconds
         return;
     }
     last_places_check_time = millis();
@@ -1319,35 +1703,32 @@ void checkAndAnnounceNearbyPlaces() {
 
     last_checked_gps_data = current_gps_data;
 
-    HTTPClient http;
     String url = "https://maps.googleapis.com/maps/api/place/nearbysearch/json?location=" +
                  String(current_gps_data.latitude, 6) + "," +
                  String(current_gps_data.longitude, 6) +
                  "&radius=50&key=" + String(GEMINI_API_KEY);
 
-    http.begin(url);
-    int httpResponseCode = http.GET();
-
-    if (httpResponseCode == 200) {
-        String payload = http.getString();
-        JsonDocument doc;
-        deserializeJson(doc, payload);
-
-        if (doc["results"].size() > 0) {
-            String place_name = doc["results"][0]["name"].as<String>();
-            String message = "You are entering " + place_name;
-            Serial.println(message);
-
-            AudioCommand cmd;
-            cmd.type = AudioCommandType::SPEAK_TEXT;
-            strncpy(cmd.text, message.c_str(), sizeof(cmd.text) - 1);
-            cmd.text[sizeof(cmd.text) - 1] = '\0';
-            if (xQueueSend(audioCommandQueue, &cmd, 0) != pdTRUE) {
-                Serial.println("❌ Failed to queue SPEAK_TEXT command for nearby place");
-            }
+    places_request_in_flight = networkExecutor.get("places", url, NetPriority::NORMAL, PLACES_TIMEOUT_MS, onNearbyPlacesResponse);
+}
+
+void onNearbyPlacesResponse(const NetResponse& response, void* context) {
+    places_request_in_flight = false;
+    if (response.statusCode != 200) {
+        return;
+    }
+
+    JsonDocument doc;
+    deserializeJson(doc, response.body);
+
+    if (doc["results"].size() > 0) {
+        String place_name = doc["results"][0]["name"].as<String>();
+        String message = "You are entering " + place_name;
+        Serial.println(message);
+
+        if (!queueAudioCommand(AudioCommandType::SPEAK_TEXT, message)) {
+            Serial.println("❌ Failed to queue SPEAK_TEXT command for nearby place");
         }
     }
-    http.end();
 }
 
 String stripHtmlTags(const String& html) {
@@ -1378,22 +1759,40 @@ void loop() {
         Serial.printf("Setup delay complete, starting main loop processing on core %d\n", xPortGetCoreID());
     }
     
-    // Handle button presses for push-to-talk and SOS
+    // Handle debounced button edges for push-to-talk and SOS
     handleButton();
 
     // Run the vision assistant (handles WebSocket communication, GPS updates, and frame processing)
     visionAssistant.run();
 
+    // Deliver finished network requests (places, directions, alerts, settings)
+    networkExecutor.poll();
+    HttpConnectionPool::shared().evictIdle();
+
     // Check for nearby places
     checkAndAnnounceNearbyPlaces();
     
     // Check for commands from the audio task
-    CommandMessage cmdMsg;
-    if (xQueueReceive(commandQueue, &cmdMsg, 0) == pdTRUE) {
-        Serial.printf("Received command from audio core: %s\n", cmdMsg.command);
+    MessageHandle cmdMsg;
+    if (commandQueue.receive(cmdMsg)) {
+        Serial.printf("Received command from audio core: %s\n", messagePool.text(cmdMsg));
         
         // Play button ding sound to indicate command was transcribed and is being processed
-        visionAssistant.sendTextMessage(String(cmdMsg.command)); // Convert to String only when needed locally
+        visionAssistant.beginCommandLatency(CommandPath::TEXT, messagePool.value(cmdMsg));
+        visionAssistant.sendTextMessage(String(messagePool.text(cmdMsg))); // Convert to String only when needed locally
+        messagePool.release(cmdMsg);
+    }
+    commandQueue.report(millis());
+    audioCommandQueue.report(millis());
+    loopWake.report(millis());
+    
+    // Check for recorded voice commands to stream as audio
+    // (one at a time - the next clip waits in the queue while the last one is still uploading)
+    VoiceClip clip;
+    if (!visionAssistant.isStreamingAudioCommand() && xQueueReceive(voiceClipQueue, &clip, 0) == pdTRUE) {
+        Serial.printf("Received voice clip from audio core: %u bytes\n", clip.size);
+        visionAssistant.beginCommandLatency(CommandPath::AUDIO, clip.recordedAt);
+        visionAssistant.sendAudioCommand(clip.pcm, clip.size);  // Frees the clip when done
     }
     
     // Print GPS status every 30 seconds
@@ -1413,14 +1812,12 @@ void loop() {
     if (millis() - lastLanguageUpdate > 300000) { // 5 minutes
         if (WiFi.status() == WL_CONNECTED) {
             Serial.println("🔄 Refreshing language settings...");
-            String currentLanguage = settingsManager.getLanguage();
-            deepgramClient.setDefaultLanguage(currentLanguage);
-            tts.setDefaultLanguage(currentLanguage);
+            settingsManager.fetchSettingsAsync(networkExecutor, onSettingsUpdated);
         }
         lastLanguageUpdate = millis();
     }
     
-    // Set a 2-second delay in the main loop to control the Gemini sending rate.
-    // Small delay to prevent watchdog issues
-    delay(10);
+    // Sleep until there is work (also keeps the watchdog fed)
+    loopWake.asleep();
+    waitForLoopWork();
 }
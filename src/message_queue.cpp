@@ -0,0 +1,285 @@
+#include "message_queue.h"
+
+MessagePool::MessagePool(int blockCount)
+    : blockCount(blockCount), storage(nullptr), used(nullptr), usedBlocks(0), peakBlocks(0), allocFailures(0) {
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    poolMux = unlocked;
+}
+
+bool MessagePool::begin() {
+    if (storage) {
+        return true;
+    }
+    size_t size = (size_t)blockCount * BLOCK_SIZE;
+    storage = (uint8_t*)(psramFound() ? ps_malloc(size) : malloc(size));
+    used = (uint8_t*)calloc(blockCount, 1);
+    if (!storage || !used) {
+        Serial.println("❌ Failed to allocate message pool");
+        free(storage);
+        free(used);
+        storage = nullptr;
+        used = nullptr;
+        return false;
+    }
+    Serial.printf("✅ Message pool: %d blocks of %u bytes\n", blockCount, (unsigned)BLOCK_SIZE);
+    return true;
+}
+
+MessageHandle MessagePool::create(uint16_t type, const char* text, size_t length, uint32_t value) {
+    if (!storage) {
+        return NO_MESSAGE;
+    }
+    if (!text) {
+        length = 0;
+    }
+    int needed = (sizeof(Header) + length + 1 + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    // First fit - messages are short-lived, so the slab rarely fragments
+    int start = -1;
+    portENTER_CRITICAL(&poolMux);
+    int run = 0;
+    for (int i = 0; i < blockCount; i++) {
+        run = used[i] ? 0 : run + 1;
+        if (run == needed) {
+            start = i - needed + 1;
+            break;
+        }
+    }
+    if (start >= 0) {
+        memset(used + start, 1, needed);
+        usedBlocks += needed;
+        if (usedBlocks > peakBlocks) {
+            peakBlocks = usedBlocks;
+        }
+    } else {
+        allocFailures++;
+    }
+    portEXIT_CRITICAL(&poolMux);
+
+    if (start < 0) {
+        Serial.printf("❌ Message pool exhausted (%u bytes requested)\n", (unsigned)length);
+        return NO_MESSAGE;
+    }
+
+    MessageHandle handle = (MessageHandle)start;
+    Header* h = header(handle);
+    h->type = type;
+    h->blocks = needed;
+    h->length = length;
+    h->value = value;
+    h->enqueuedAt = 0;
+    char* body = (char*)(h + 1);
+    if (length > 0) {
+        memcpy(body, text, length);
+    }
+    body[length] = '\0';
+    return handle;
+}
+
+void MessagePool::release(MessageHandle handle) {
+    if (handle == NO_MESSAGE || !storage) {
+        return;
+    }
+    int blocks = header(handle)->blocks;
+    portENTER_CRITICAL(&poolMux);
+    memset(used + handle, 0, blocks);
+    usedBlocks -= blocks;
+    portEXIT_CRITICAL(&poolMux);
+}
+
+MessageQueue::MessageQueue(const char* name, MessagePool& pool, int depth, QueuePolicy policy, unsigned long deadlineMs)
+    : name(name), pool(pool), depth(depth > MAX_DEPTH ? MAX_DEPTH : depth), policy(policy),
+      deadline(pdMS_TO_TICKS(deadlineMs)), head(0), count(0), itemSignal(nullptr), spaceSignal(nullptr),
+      receiver(nullptr), notifyGroup(nullptr), notifyBits(0), sent(0), received(0), dropped(0), coalesced(0),
+      blockedSends(0), waitTotalUs(0), waitMaxUs(0), peakCount(0), lastReportAt(0) {
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    queueMux = unlocked;
+}
+
+bool MessageQueue::begin() {
+    if (itemSignal) {
+        return true;
+    }
+    itemSignal = xSemaphoreCreateBinary();
+    spaceSignal = xSemaphoreCreateBinary();
+    if (!itemSignal || !spaceSignal) {
+        Serial.printf("❌ Failed to create %s queue signals\n", name);
+        return false;
+    }
+    return true;
+}
+
+void MessageQueue::notifyOnSend(EventGroupHandle_t group, EventBits_t bits) {
+    notifyGroup = group;
+    notifyBits = bits;
+}
+
+MessageHandle MessageQueue::tryInsert(MessageHandle handle, bool mayCoalesce, bool& inserted) {
+    MessageHandle discard = NO_MESSAGE;
+    inserted = true;
+
+    portENTER_CRITICAL(&queueMux);
+    int tail = (head + count - 1) % depth;
+    if (policy == QueuePolicy::COALESCE && mayCoalesce && count > 0 &&
+        pool.type(ring[tail]) == pool.type(handle)) {
+        // Same message already waiting at the tail - keep the newer copy in its place
+        discard = ring[tail];
+        ring[tail] = handle;
+        coalesced++;
+    } else if (count < depth) {
+        ring[(head + count) % depth] = handle;
+        count++;
+    } else if (policy == QueuePolicy::DROP_OLDEST) {
+        discard = ring[head];
+        ring[head] = handle;
+        head = (head + 1) % depth;
+        dropped++;
+    } else {
+        inserted = false;
+    }
+    if (inserted) {
+        sent++;
+        if (count > peakCount) {
+            peakCount = count;
+        }
+    }
+    portEXIT_CRITICAL(&queueMux);
+    return discard;
+}
+
+bool MessageQueue::send(MessageHandle handle, bool mayCoalesce) {
+    if (handle == NO_MESSAGE) {
+        return false;
+    }
+    if (!itemSignal) {
+        Serial.printf("❌ %s queue not started - dropping message\n", name);
+        pool.release(handle);
+        return false;
+    }
+
+    pool.stampEnqueued(handle, micros());
+    bool inserted;
+    MessageHandle discard = tryInsert(handle, mayCoalesce, inserted);
+
+    // Full under a blocking policy: wait for the receiver, unless we are the receiver
+    if (!inserted && deadline > 0 && xTaskGetCurrentTaskHandle() != receiver) {
+        TickType_t startTick = xTaskGetTickCount();
+        portENTER_CRITICAL(&queueMux);
+        blockedSends++;
+        portEXIT_CRITICAL(&queueMux);
+        while (!inserted) {
+            TickType_t waited = xTaskGetTickCount() - startTick;
+            if (waited >= deadline || xSemaphoreTake(spaceSignal, deadline - waited) != pdTRUE) {
+                break;
+            }
+            discard = tryInsert(handle, mayCoalesce, inserted);
+        }
+    }
+
+    if (!inserted) {
+        portENTER_CRITICAL(&queueMux);
+        dropped++;
+        portEXIT_CRITICAL(&queueMux);
+        Serial.printf("⚠️ %s queue full - dropping message type %u\n", name, pool.type(handle));
+        pool.release(handle);
+        return false;
+    }
+    pool.release(discard);
+    xSemaphoreGive(itemSignal);
+    if (notifyGroup) {
+        xEventGroupSetBits(notifyGroup, notifyBits);
+    }
+    return true;
+}
+
+bool MessageQueue::send(uint16_t type, const char* text, size_t length, uint32_t value, bool mayCoalesce) {
+    MessageHandle handle = pool.create(type, text, length, value);
+    if (handle == NO_MESSAGE) {
+        portENTER_CRITICAL(&queueMux);
+        dropped++;
+        portEXIT_CRITICAL(&queueMux);
+        return false;
+    }
+    return send(handle, mayCoalesce);
+}
+
+bool MessageQueue::receive(MessageHandle& handle, TickType_t wait) {
+    receiver = xTaskGetCurrentTaskHandle();
+    TickType_t startTick = xTaskGetTickCount();
+    while (true) {
+        handle = NO_MESSAGE;
+        portENTER_CRITICAL(&queueMux);
+        if (count > 0) {
+            handle = ring[head];
+            head = (head + 1) % depth;
+            count--;
+            received++;
+        }
+        portEXIT_CRITICAL(&queueMux);
+
+        if (handle != NO_MESSAGE) {
+            uint32_t waitedUs = micros() - pool.enqueuedAt(handle);
+            portENTER_CRITICAL(&queueMux);
+            waitTotalUs += waitedUs;
+            if (waitedUs > waitMaxUs) {
+                waitMaxUs = waitedUs;
+            }
+            portEXIT_CRITICAL(&queueMux);
+            if (spaceSignal) {
+                xSemaphoreGive(spaceSignal);
+            }
+            return true;
+        }
+
+        TickType_t waited = xTaskGetTickCount() - startTick;
+        if (!itemSignal || waited >= wait || xSemaphoreTake(itemSignal, wait - waited) != pdTRUE) {
+            return false;
+        }
+    }
+}
+
+bool MessageQueue::waitForMessage(TickType_t wait) {
+    TickType_t startTick = xTaskGetTickCount();
+    while (pending() == 0) {
+        TickType_t waited = xTaskGetTickCount() - startTick;
+        if (!itemSignal || waited >= wait || xSemaphoreTake(itemSignal, wait - waited) != pdTRUE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int MessageQueue::pending() {
+    portENTER_CRITICAL(&queueMux);
+    int n = count;
+    portEXIT_CRITICAL(&queueMux);
+    return n;
+}
+
+void MessageQueue::report(unsigned long now) {
+    if (lastReportAt == 0) {
+        lastReportAt = now ? now : 1;
+        return;
+    }
+    if (now - lastReportAt < REPORT_INTERVAL) {
+        return;
+    }
+    lastReportAt = now;
+
+    portENTER_CRITICAL(&queueMux);
+    uint32_t sentNow = sent;
+    uint32_t receivedNow = received;
+    uint32_t droppedNow = dropped;
+    uint32_t coalescedNow = coalesced;
+    uint32_t blockedNow = blockedSends;
+    uint64_t waitTotal = waitTotalUs;
+    uint32_t waitMax = waitMaxUs;
+    int peak = peakCount;
+    portEXIT_CRITICAL(&queueMux);
+
+    Serial.printf("📊 %s queue: %u sent, %u dropped, %u coalesced, %u blocked sends, peak depth %d/%d, "
+                  "wait avg %.1f ms max %.1f ms; pool peak %d/%d blocks, %u failed allocations\n",
+                  name, sentNow, droppedNow, coalescedNow, blockedNow, peak, depth,
+                  receivedNow ? waitTotal / 1000.0f / receivedNow : 0.0f, waitMax / 1000.0f,
+                  pool.peakUsedBlocks(), pool.capacityBlocks(), pool.failedAllocations());
+}
@@ -0,0 +1,137 @@
+#ifndef MESSAGE_QUEUE_H
+#define MESSAGE_QUEUE_H
+
+#include <Arduino.h>
+#include <freertos/event_groups.h>
+
+// Messages between the cores live in a fixed slab of small blocks and only a 2-byte handle is
+// passed through the queue, so a ding costs one block instead of a 260-byte copy per hop and
+// spoken text is no longer truncated to a fixed buffer. Both classes are safe to use from
+// either core.
+
+typedef uint16_t MessageHandle;
+static const MessageHandle NO_MESSAGE = 0xFFFF;
+
+// Fixed pool of BLOCK_SIZE-byte blocks. A message takes a contiguous run: a small header
+// followed by its text (null-terminated), so the receiver reads it in place.
+class MessagePool {
+public:
+    static const size_t BLOCK_SIZE = 64;
+
+private:
+    struct Header {
+        uint16_t type;
+        uint16_t blocks;
+        uint32_t length;            // Text bytes, excluding the terminator
+        uint32_t value;             // Caller-defined (e.g. a timestamp)
+        uint32_t enqueuedAt;        // micros() when it was last sent, for queue wait times
+    };
+
+    int blockCount;
+    uint8_t* storage;
+    uint8_t* used;                  // Per block: 1 if part of a live message
+    int usedBlocks;
+    int peakBlocks;
+    uint32_t allocFailures;
+    portMUX_TYPE poolMux;
+
+    Header* header(MessageHandle handle) const {
+        return (Header*)(storage + (size_t)handle * BLOCK_SIZE);
+    }
+
+public:
+    explicit MessagePool(int blockCount);
+
+    // Allocates the slab (PSRAM if available)
+    bool begin();
+
+    // New message with a copy of the text; NO_MESSAGE when the pool has no run long enough
+    MessageHandle create(uint16_t type, const char* text = nullptr, size_t length = 0, uint32_t value = 0);
+    void release(MessageHandle handle);
+
+    uint16_t type(MessageHandle handle) const { return header(handle)->type; }
+    const char* text(MessageHandle handle) const { return (const char*)(header(handle) + 1); }
+    size_t length(MessageHandle handle) const { return header(handle)->length; }
+    uint32_t value(MessageHandle handle) const { return header(handle)->value; }
+
+    void stampEnqueued(MessageHandle handle, uint32_t micros) { header(handle)->enqueuedAt = micros; }
+    uint32_t enqueuedAt(MessageHandle handle) const { return header(handle)->enqueuedAt; }
+
+    int capacityBlocks() const { return blockCount; }
+    int peakUsedBlocks() const { return peakBlocks; }
+    uint32_t failedAllocations() const { return allocFailures; }
+};
+
+// What send() does when the queue is full
+enum class QueuePolicy : uint8_t {
+    DROP_OLDEST,            // Discard the oldest queued message - the newest matters most
+    BLOCK_WITH_DEADLINE,    // Wait up to the deadline for space, then drop the new message
+    COALESCE                // Fold into an identical message at the tail, else block like above
+};
+
+// Bounded FIFO of message handles with a backpressure policy. The queue owns a message once
+// send() is called (dropped messages go back to the pool); the receiver releases it when done.
+class MessageQueue {
+private:
+    static const int MAX_DEPTH = 16;
+    static const unsigned long REPORT_INTERVAL = 300000;
+
+    const char* name;
+    MessagePool& pool;
+    int depth;
+    QueuePolicy policy;
+    TickType_t deadline;
+
+    MessageHandle ring[MAX_DEPTH];
+    int head;
+    int count;
+    portMUX_TYPE queueMux;
+    SemaphoreHandle_t itemSignal;   // Given after every send, so a blocked receiver rechecks
+    SemaphoreHandle_t spaceSignal;  // Given after every receive, so a blocked sender rechecks
+    TaskHandle_t receiver;          // Last task to receive - it never waits on its own queue
+    EventGroupHandle_t notifyGroup; // Optional: bits set after every send, to wake the receiver
+    EventBits_t notifyBits;
+
+    // Metrics
+    uint32_t sent;
+    uint32_t received;
+    uint32_t dropped;
+    uint32_t coalesced;
+    uint32_t blockedSends;
+    uint64_t waitTotalUs;
+    uint32_t waitMaxUs;
+    int peakCount;
+    unsigned long lastReportAt;
+
+    // Inserts under the lock; NO_MESSAGE if queued, else the handle the caller must release
+    MessageHandle tryInsert(MessageHandle handle, bool mayCoalesce, bool& inserted);
+
+public:
+    // deadlineMs: how long BLOCK_WITH_DEADLINE / COALESCE senders wait for space
+    MessageQueue(const char* name, MessagePool& pool, int depth, QueuePolicy policy, unsigned long deadlineMs = 0);
+
+    bool begin();
+
+    // Also set these bits after every send, for a receiver that waits on several sources
+    void notifyOnSend(EventGroupHandle_t group, EventBits_t bits);
+
+    // Hands the message to the queue. mayCoalesce marks messages that carry nothing a duplicate
+    // at the tail doesn't (dings, state changes). False if this message was dropped.
+    bool send(MessageHandle handle, bool mayCoalesce = false);
+
+    // Creates and sends in one step; false if the pool is exhausted or the message was dropped
+    bool send(uint16_t type, const char* text = nullptr, size_t length = 0, uint32_t value = 0, bool mayCoalesce = false);
+
+    // Oldest message, waiting up to wait ticks; the caller releases it to the pool
+    bool receive(MessageHandle& handle, TickType_t wait = 0);
+
+    // Blocks until a message is queued (without taking it) or wait ticks pass
+    bool waitForMessage(TickType_t wait);
+
+    int pending();
+
+    // Logs sends, drops, coalesced messages and queue wait times periodically
+    void report(unsigned long now);
+};
+
+#endif
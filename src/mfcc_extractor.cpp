@@ -0,0 +1,94 @@
+#include "mfcc_extractor.h"
+#include <math.h>
+
+static float hzToMel(float hz) {
+    return 2595.0f * log10f(1.0f + hz / 700.0f);
+}
+
+static float melToHz(float mel) {
+    return 700.0f * (powf(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+MfccExtractor::MfccExtractor() {
+    for (int n = 0; n < FRAME_SAMPLES; n++) {
+        window[n] = 0.54f - 0.46f * cosf(2.0f * (float)M_PI * n / (FRAME_SAMPLES - 1));
+    }
+
+    float lowMel = hzToMel(LOW_HZ);
+    float highMel = hzToMel(HIGH_HZ);
+    for (int i = 0; i < MEL_BANDS + 2; i++) {
+        float hz = melToHz(lowMel + (highMel - lowMel) * i / (MEL_BANDS + 1));
+        bandEdges[i] = hz * RealFft::SIZE / SAMPLE_RATE;
+    }
+
+    float scale = sqrtf(2.0f / MEL_BANDS);
+    for (int c = 0; c < COEFFS; c++) {
+        for (int b = 0; b < MEL_BANDS; b++) {
+            dct[c][b] = scale * cosf((float)M_PI * (c + 1) * (b + 0.5f) / MEL_BANDS);
+        }
+    }
+
+    reset();
+}
+
+void MfccExtractor::reset() {
+    fill = 0;
+    meanReady = false;
+    for (int c = 0; c < COEFFS; c++) {
+        mean[c] = 0;
+        features[c] = 0;
+    }
+}
+
+void MfccExtractor::computeFrame() {
+    // Pre-emphasis and window, zero-padded to the FFT size and packed as even/odd pairs
+    float previous = frame[0];
+    for (int n = 0; n < RealFft::HALF; n++) {
+        for (int j = 0; j < 2; j++) {
+            int i = 2 * n + j;
+            float value = 0;
+            if (i < FRAME_SAMPLES) {
+                value = (frame[i] - PRE_EMPHASIS * previous) * window[i];
+                previous = frame[i];
+            }
+            if (j) {
+                fft.im[n] = value;
+            } else {
+                fft.re[n] = value;
+            }
+        }
+    }
+    fft.forward();
+
+    // Triangular mel bands over the power spectrum
+    float logEnergy[MEL_BANDS];
+    for (int b = 0; b < MEL_BANDS; b++) {
+        float low = bandEdges[b];
+        float center = bandEdges[b + 1];
+        float high = bandEdges[b + 2];
+        float energy = 0;
+        for (int k = (int)ceilf(low); k <= (int)high && k < RealFft::HALF; k++) {
+            float weight = k < center ? (k - low) / (center - low) : (high - k) / (high - center);
+            energy += weight * (fft.re[k] * fft.re[k] + fft.im[k] * fft.im[k]);
+        }
+        logEnergy[b] = logf(energy + 1.0f);
+    }
+
+    for (int c = 0; c < COEFFS; c++) {
+        float value = 0;
+        for (int b = 0; b < MEL_BANDS; b++) {
+            value += dct[c][b] * logEnergy[b];
+        }
+        if (!meanReady) {
+            mean[c] = value;
+        }
+        mean[c] += (value - mean[c]) * MEAN_RATE;
+        int32_t quantised = (int32_t)lroundf((value - mean[c]) * QUANT_SCALE);
+        features[c] = quantised > 127 ? 127 : (quantised < -127 ? -127 : quantised);
+    }
+    meanReady = true;
+
+    // Keep the overlap for the next frame
+    memmove(frame, frame + HOP_SAMPLES, (FRAME_SAMPLES - HOP_SAMPLES) * sizeof(int16_t));
+    fill = FRAME_SAMPLES - HOP_SAMPLES;
+}
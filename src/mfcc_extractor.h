@@ -0,0 +1,56 @@
+#ifndef MFCC_EXTRACTOR_H
+#define MFCC_EXTRACTOR_H
+
+#include <Arduino.h>
+#include "real_fft.h"
+
+// Streaming MFCC features for keyword matching: 25 ms frames every 10 ms, pre-emphasis, Hamming
+// window, 24 mel bands (100-6000 Hz) and 12 cepstral coefficients. A running cepstral mean is
+// removed so microphone colouring and gain changes cancel out, and the result is quantised to
+// int8 so templates are small and distances are cheap.
+class MfccExtractor {
+public:
+    static const int COEFFS = 12;           // c1..c12 - c0 (loudness) is left out
+    static const int FRAME_SAMPLES = 400;
+    static const int HOP_SAMPLES = 160;
+
+private:
+    static const int SAMPLE_RATE = 16000;
+    static const int MEL_BANDS = 24;
+    static constexpr float LOW_HZ = 100.0f;
+    static constexpr float HIGH_HZ = 6000.0f;
+    static constexpr float PRE_EMPHASIS = 0.97f;
+    static constexpr float MEAN_RATE = 1.0f / 128;  // ~1.3 s
+    static constexpr float QUANT_SCALE = 8.0f;
+
+    RealFft fft;
+    float window[FRAME_SAMPLES];
+    float bandEdges[MEL_BANDS + 2];         // Triangle corners in FFT bins
+    float dct[COEFFS][MEL_BANDS];
+    int16_t frame[FRAME_SAMPLES];
+    int fill;
+    float mean[COEFFS];
+    bool meanReady;
+    int8_t features[COEFFS];
+
+    void computeFrame();
+
+public:
+    MfccExtractor();
+
+    void reset();
+
+    // Returns true when the sample completed a frame - read it with getFeatures()
+    inline bool addSample(int16_t sample) {
+        frame[fill++] = sample;
+        if (fill < FRAME_SAMPLES) {
+            return false;
+        }
+        computeFrame();
+        return true;
+    }
+
+    const int8_t* getFeatures() const { return features; }
+};
+
+#endif
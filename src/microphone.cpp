@@ -21,15 +21,36 @@ bool setup_microphone() {
     return true;
 }
 
-esp_err_t read_microphone_data(int32_t* buffer, size_t buffer_size, size_t* bytes_read) {
+esp_err_t read_microphone_data(int32_t* buffer, size_t buffer_size, size_t* bytes_read, TickType_t timeout) {
     if (!I2SManager::hasI2SAccess(I2SDevice::MICROPHONE)) {
         Serial.println("❌ Cannot read microphone: No I2S access");
         return ESP_ERR_INVALID_STATE;
     }
     
-    // Use longer timeout for reliable data reading (1 second instead of 100ms)
-    // TODO
-    return i2s_read(I2SManager::I2S_PORT, buffer, buffer_size, bytes_read, 100);
+    return i2s_read(I2SManager::I2S_PORT, buffer, buffer_size, bytes_read, timeout);
+}
+
+bool wait_for_microphone_data(TickType_t timeout, uint32_t* overruns) {
+    QueueHandle_t events = I2SManager::getRxEventQueue();
+    if (!events) {
+        vTaskDelay(timeout);  // Driver not running - don't spin
+        return false;
+    }
+
+    i2s_event_t event;
+    bool ready = false;
+    TickType_t wait = timeout;
+    // Block for the first event, then take whatever else is queued without waiting
+    while (xQueueReceive(events, &event, wait) == pdTRUE) {
+        if (event.type == I2S_EVENT_RX_DONE) {
+            ready = true;
+        } else if (event.type == I2S_EVENT_RX_Q_OVF) {
+            (*overruns)++;
+            ready = true;
+        }
+        wait = 0;
+    }
+    return ready;
 }
 
 void stop_microphone() {
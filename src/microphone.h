@@ -16,9 +16,19 @@ bool setup_microphone();
  * @param buffer The buffer to store the audio data.
  * @param buffer_size The size of the buffer.
  * @param bytes_read A pointer to store the number of bytes read.
+ * @param timeout Ticks to wait for DMA buffers (0 returns only what has already been captured).
  * @return esp_err_t The result of the I2S read operation.
  */
-esp_err_t read_microphone_data(int32_t* buffer, size_t buffer_size, size_t* bytes_read);
+esp_err_t read_microphone_data(int32_t* buffer, size_t buffer_size, size_t* bytes_read, TickType_t timeout = 100);
+
+/**
+ * @brief Sleeps until the I2S driver has filled a DMA buffer.
+ * 
+ * @param timeout Ticks to wait.
+ * @param overruns Incremented for each buffer the driver dropped because it wasn't read in time.
+ * @return true if captured audio is ready, false on timeout or if the microphone is off.
+ */
+bool wait_for_microphone_data(TickType_t timeout, uint32_t* overruns);
 
 /**
  * @brief Stops the microphone and releases I2S resources.
@@ -0,0 +1,306 @@
+#include "network_executor.h"
+
+#include <HTTPClient.h>
+#include <WiFi.h>
+#include "http_connection_pool.h"
+
+NetworkExecutor::NetworkExecutor() : nextSequence(0), pendingSignal(nullptr), doneGroup(nullptr), doneBits(0) {
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    requestMux = unlocked;
+    for (int i = 0; i < MAX_REQUESTS; i++) {
+        requests[i].state = SlotState::FREE;
+    }
+    for (int i = 0; i < WORKER_COUNT; i++) {
+        workers[i] = nullptr;
+    }
+}
+
+bool NetworkExecutor::begin() {
+    if (pendingSignal) {
+        return true;
+    }
+
+    pendingSignal = xSemaphoreCreateCounting(MAX_REQUESTS, 0);
+    if (!pendingSignal) {
+        Serial.println("❌ Failed to create network executor semaphore");
+        return false;
+    }
+
+    // Same core and priority as the main loop: the workers mostly sleep on sockets, and the
+    // scheduler time-slices them with the loop while a TLS handshake is busy on the CPU
+    for (int i = 0; i < WORKER_COUNT; i++) {
+        char name[12];
+        snprintf(name, sizeof(name), "NetTask%d", i);
+        xTaskCreatePinnedToCore(taskEntry, name, TASK_STACK_SIZE, this, 1, &workers[i], 1);
+        if (!workers[i]) {
+            Serial.printf("❌ Failed to create network worker %d\n", i);
+            return i > 0;  // Fewer workers still work, just without overlap
+        }
+    }
+    Serial.printf("✅ Network executor started (%d workers)\n", WORKER_COUNT);
+    return true;
+}
+
+bool NetworkExecutor::get(const char* label, const String& url, NetPriority priority, unsigned long timeoutMs,
+                          NetCallback callback, void* context) {
+    return submit(label, false, url, String(), nullptr, priority, timeoutMs, callback, context);
+}
+
+bool NetworkExecutor::post(const char* label, const String& url, const String& body, const char* contentType,
+                           NetPriority priority, unsigned long timeoutMs, NetCallback callback, void* context) {
+    return submit(label, true, url, body, contentType, priority, timeoutMs, callback, context);
+}
+
+bool NetworkExecutor::submit(const char* label, bool isPost, const String& url, const String& body, const char* contentType,
+                             NetPriority priority, unsigned long timeoutMs, NetCallback callback, void* context) {
+    if (!pendingSignal) {
+        Serial.printf("❌ Network executor not started - dropping %s request\n", label);
+        return false;
+    }
+
+    // Claim a free slot, or evict the lowest-priority request that hasn't started yet
+    Request* slot = nullptr;
+    bool evicted = false;
+    portENTER_CRITICAL(&requestMux);
+    for (int i = 0; i < MAX_REQUESTS && !slot; i++) {
+        if (requests[i].state == SlotState::FREE) {
+            slot = &requests[i];
+        }
+    }
+    if (!slot) {
+        for (int i = 0; i < MAX_REQUESTS; i++) {
+            Request& candidate = requests[i];
+            if (candidate.state == SlotState::PENDING && candidate.priority < priority &&
+                (!slot || candidate.priority < slot->priority ||
+                 (candidate.priority == slot->priority && candidate.sequence > slot->sequence))) {
+                slot = &candidate;
+            }
+        }
+        evicted = slot != nullptr;
+    }
+    if (slot) {
+        slot->state = SlotState::CLAIMED;
+    }
+    portEXIT_CRITICAL(&requestMux);
+
+    if (!slot) {
+        Serial.printf("❌ Network queue full - dropping %s request\n", label);
+        return false;
+    }
+
+    // The slot is ours while CLAIMED - fill it outside the critical section (String copies allocate)
+    NetCallback evictedCallback = nullptr;
+    void* evictedContext = nullptr;
+    const char* evictedLabel = nullptr;
+    if (evicted) {
+        evictedCallback = slot->callback;
+        evictedContext = slot->context;
+        evictedLabel = slot->label;
+        Serial.printf("⚠️ Network queue full - evicting %s request for %s\n", evictedLabel, label);
+    }
+
+    unsigned long now = millis();
+    slot->label = label;
+    slot->isPost = isPost;
+    slot->url = url;
+    slot->body = body;
+    slot->contentType = contentType;
+    slot->priority = priority;
+    slot->submittedAt = now;
+    slot->deadline = now + timeoutMs;
+    slot->callback = callback;
+    slot->context = context;
+    slot->response.label = label;
+    slot->response.statusCode = 0;
+    slot->response.body = String();
+    slot->response.queuedMs = 0;
+    slot->response.elapsedMs = 0;
+
+    portENTER_CRITICAL(&requestMux);
+    slot->sequence = nextSequence++;
+    slot->state = SlotState::PENDING;
+    portEXIT_CRITICAL(&requestMux);
+    if (!evicted) {
+        xSemaphoreGive(pendingSignal);  // An eviction swapped one pending request for another
+    }
+
+    // Tell the evicted request's owner last, so a callback that resubmits sees a consistent pool
+    if (evictedCallback) {
+        NetResponse response;
+        response.label = evictedLabel;
+        response.statusCode = ERROR_EVICTED;
+        response.queuedMs = 0;
+        response.elapsedMs = 0;
+        evictedCallback(response, evictedContext);
+    }
+    return true;
+}
+
+void NetworkExecutor::notifyOnCompletion(EventGroupHandle_t group, EventBits_t bits) {
+    doneGroup = group;
+    doneBits = bits;
+}
+
+void NetworkExecutor::poll() {
+    for (int i = 0; i < MAX_REQUESTS; i++) {
+        Request& request = requests[i];
+
+        portENTER_CRITICAL(&requestMux);
+        bool done = request.state == SlotState::DONE;
+        if (done) {
+            request.state = SlotState::CLAIMED;
+        }
+        portEXIT_CRITICAL(&requestMux);
+        if (!done) {
+            continue;
+        }
+
+        NetCallback callback = request.callback;
+        void* context = request.context;
+        NetResponse response = std::move(request.response);
+
+        portENTER_CRITICAL(&requestMux);
+        request.state = SlotState::FREE;
+        portEXIT_CRITICAL(&requestMux);
+
+        Serial.printf("📡 %s: HTTP %d in %lu ms (queued %lu ms)\n", response.label, response.statusCode,
+                      response.elapsedMs, response.queuedMs);
+        if (callback) {
+            callback(response, context);
+        }
+    }
+}
+
+int NetworkExecutor::pendingCount() {
+    int count = 0;
+    portENTER_CRITICAL(&requestMux);
+    for (int i = 0; i < MAX_REQUESTS; i++) {
+        if (requests[i].state == SlotState::PENDING || requests[i].state == SlotState::RUNNING) {
+            count++;
+        }
+    }
+    portEXIT_CRITICAL(&requestMux);
+    return count;
+}
+
+void NetworkExecutor::taskEntry(void* parameter) {
+    static_cast<NetworkExecutor*>(parameter)->workerLoop();
+}
+
+void NetworkExecutor::workerLoop() {
+    while (true) {
+        // One count per pending request, so a worker only wakes when there is work for it
+        xSemaphoreTake(pendingSignal, portMAX_DELAY);
+        bool claimed = false;
+        Request* request = takeNextRequest(claimed);
+        if (!request) {
+            if (claimed) {
+                // An evicting submit() keeps the evicted request's count but holds the slot as
+                // CLAIMED while it refills it - hand the count back and look again next tick
+                vTaskDelay(1);
+                xSemaphoreGive(pendingSignal);
+            }
+            continue;
+        }
+
+        execute(*request);
+
+        portENTER_CRITICAL(&requestMux);
+        request->state = SlotState::DONE;
+        portEXIT_CRITICAL(&requestMux);
+        if (doneGroup) {
+            xEventGroupSetBits(doneGroup, doneBits);
+        }
+    }
+}
+
+NetworkExecutor::Request* NetworkExecutor::takeNextRequest(bool& claimed) {
+    Request* best = nullptr;
+    portENTER_CRITICAL(&requestMux);
+    for (int i = 0; i < MAX_REQUESTS; i++) {
+        Request& candidate = requests[i];
+        if (candidate.state == SlotState::CLAIMED) {
+            claimed = true;
+        }
+        if (candidate.state == SlotState::PENDING &&
+            (!best || candidate.priority > best->priority ||
+             (candidate.priority == best->priority && candidate.sequence < best->sequence))) {
+            best = &candidate;
+        }
+    }
+    if (best) {
+        best->state = SlotState::RUNNING;
+    }
+    portEXIT_CRITICAL(&requestMux);
+    return best;
+}
+
+void NetworkExecutor::execute(Request& request) {
+    unsigned long startTime = millis();
+    request.response.queuedMs = startTime - request.submittedAt;
+
+    long remaining = (long)(request.deadline - startTime);
+    if (remaining <= 0) {
+        request.response.statusCode = ERROR_DEADLINE_EXCEEDED;
+        return;
+    }
+    if (WiFi.status() != WL_CONNECTED) {
+        request.response.statusCode = HTTPC_ERROR_NOT_CONNECTED;
+        return;
+    }
+
+    // The remaining deadline bounds the connect and every read
+    HttpConnectionPool& pool = HttpConnectionPool::shared();
+    bool reused = false;
+    WiFiClient* client = pool.acquire(request.url, remaining, &reused);
+    int httpCode;
+    while (true) {
+        if (!client) {
+            request.response.statusCode = HTTPC_ERROR_CONNECTION_REFUSED;
+            request.response.elapsedMs = millis() - startTime;
+            return;
+        }
+
+        HTTPClient http;
+        http.setReuse(true);
+        remaining = (long)(request.deadline - millis());
+        http.setTimeout(remaining <= 0 ? 1 : (remaining > 65535 ? 65535 : (uint16_t)remaining));
+
+        if (!http.begin(*client, request.url)) {
+            pool.release(client, false);
+            request.response.statusCode = HTTPC_ERROR_CONNECTION_REFUSED;
+            request.response.elapsedMs = millis() - startTime;
+            return;
+        }
+
+        if (request.isPost) {
+            if (request.contentType) {
+                http.addHeader("Content-Type", request.contentType);
+            }
+            httpCode = http.POST(request.body);
+        } else {
+            httpCode = http.GET();
+        }
+
+        // A stale kept-alive connection gets one retry on a new one, if the deadline allows
+        remaining = (long)(request.deadline - millis());
+        if (remaining > 0 && pool.shouldRetryFresh(reused, httpCode)) {
+            http.end();
+            pool.release(client, false);
+            client = pool.acquireFresh(request.url, remaining);
+            reused = false;
+            continue;
+        }
+
+        if (httpCode > 0) {
+            request.response.body = http.getString();
+        }
+        http.end();
+        // getString() consumes the whole body, so the connection is clean for the next request
+        pool.release(client, httpCode > 0);
+        break;
+    }
+
+    request.response.statusCode = httpCode;
+    request.response.elapsedMs = millis() - startTime;
+}
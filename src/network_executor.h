@@ -0,0 +1,105 @@
+#ifndef NETWORK_EXECUTOR_H
+#define NETWORK_EXECUTOR_H
+
+#include <Arduino.h>
+#include <freertos/event_groups.h>
+
+// Request priorities (higher runs first; equal priorities run in submission order)
+enum class NetPriority : uint8_t {
+    BACKGROUND,   // Settings refresh
+    NORMAL,       // Nearby places
+    INTERACTIVE,  // The user is waiting for the answer (tool calls)
+    EMERGENCY     // Emergency alerts
+};
+
+// Result of a request, handed to the completion callback on the main loop
+struct NetResponse {
+    const char* label;
+    int statusCode;             // HTTP status, or a negative HTTPClient / executor error code
+    String body;
+    unsigned long queuedMs;     // Time spent waiting for the worker
+    unsigned long elapsedMs;    // Time spent on the network
+};
+
+typedef void (*NetCallback)(const NetResponse& response, void* context);
+
+// Runs blocking HTTP requests on worker tasks so the main loop never waits on the network.
+// Requests wait in a small fixed pool and are picked by priority; each one has a deadline that
+// bounds both its queueing time and its socket timeouts. Completions are delivered by poll(),
+// which the main loop calls every iteration, so callbacks run in the same context as before.
+class NetworkExecutor {
+public:
+    // Executor error codes (HTTPClient uses -1 to -11)
+    static const int ERROR_DEADLINE_EXCEEDED = -100;  // Expired before the worker got to it
+    static const int ERROR_EVICTED = -101;            // Dropped for a higher-priority request
+
+private:
+    enum class SlotState : uint8_t {
+        FREE,
+        CLAIMED,    // Being filled in by submit()
+        PENDING,
+        RUNNING,
+        DONE
+    };
+
+    struct Request {
+        SlotState state;
+        NetPriority priority;
+        uint32_t sequence;
+        const char* label;
+        bool isPost;
+        String url;
+        String body;
+        const char* contentType;
+        unsigned long submittedAt;
+        unsigned long deadline;
+        NetCallback callback;
+        void* context;
+        NetResponse response;
+    };
+
+    static const int MAX_REQUESTS = 8;
+    static const int WORKER_COUNT = 2;     // Independent requests (e.g. one batch of tool calls) overlap
+    static const uint32_t TASK_STACK_SIZE = 8192;
+
+    Request requests[MAX_REQUESTS];
+    uint32_t nextSequence;
+    TaskHandle_t workers[WORKER_COUNT];
+    SemaphoreHandle_t pendingSignal;       // Counts PENDING requests
+    EventGroupHandle_t doneGroup;          // Optional: bits set when a request finishes, to wake poll()'s caller
+    EventBits_t doneBits;
+    portMUX_TYPE requestMux;
+
+    static void taskEntry(void* parameter);
+    void workerLoop();
+    Request* takeNextRequest(bool& claimed);  // claimed: some slot is being filled or delivered
+    void execute(Request& request);
+
+public:
+    NetworkExecutor();
+
+    // Starts the worker tasks (call once WiFi is up)
+    bool begin();
+
+    // Queue a request; returns false if the pool is full of equal or higher priority work.
+    // The callback runs later from poll(); context is passed through untouched.
+    bool get(const char* label, const String& url, NetPriority priority, unsigned long timeoutMs,
+             NetCallback callback, void* context = nullptr);
+    bool post(const char* label, const String& url, const String& body, const char* contentType,
+              NetPriority priority, unsigned long timeoutMs, NetCallback callback, void* context = nullptr);
+
+    // Also set these bits when a request finishes, so the main loop can sleep until then
+    void notifyOnCompletion(EventGroupHandle_t group, EventBits_t bits);
+
+    // Deliver finished requests to their callbacks (main loop only)
+    void poll();
+
+    // Requests queued or in flight
+    int pendingCount();
+
+private:
+    bool submit(const char* label, bool isPost, const String& url, const String& body, const char* contentType,
+                NetPriority priority, unsigned long timeoutMs, NetCallback callback, void* context);
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include "noise_suppressor.h"
+#include <math.h>
+
+NoiseSuppressor::NoiseSuppressor()
+    : noiseFrames(0), observeCount(0), backgroundFill(0), pcm(nullptr), active(false), inputPos(0), outputPos(0), frameCount(0),
+      cycles(0), noiseIn(0), noiseOut(0) {
+    for (int n = 0; n < FRAME_SIZE; n++) {
+        window[n] = sinf((float)M_PI * n / FRAME_SIZE);  // sqrt of a periodic Hann - squares sum to 1 at 50% overlap
+    }
+    for (int k = 0; k < BINS; k++) {
+        noisePower[k] = 0;
+    }
+}
+
+void NoiseSuppressor::observeBackground(const int32_t* block, int count) {
+    while (count > 0) {
+        int take = min(count, FRAME_SIZE - backgroundFill);
+        bool analysed = observeCount % OBSERVE_INTERVAL == 0;
+        if (analysed) {
+            for (int i = 0; i < take; i++) {
+                int32_t sample = block[i];
+                background[backgroundFill + i] = sample > 32767 ? 32767 : (sample < -32768 ? -32768 : sample);
+            }
+        }
+        backgroundFill += take;
+        block += take;
+        count -= take;
+        if (backgroundFill == FRAME_SIZE) {
+            if (analysed) {
+                analyseBackground();
+            }
+            observeCount++;
+            backgroundFill = 0;
+        }
+    }
+}
+
+void NoiseSuppressor::analyseBackground() {
+    for (int n = 0; n < HALF_SIZE; n++) {
+        fft.re[n] = background[2 * n] * window[2 * n];
+        fft.im[n] = background[2 * n + 1] * window[2 * n + 1];
+    }
+    fft.forward();
+
+    float smoothing = noiseFrames == 0 ? 0.0f : NOISE_SMOOTHING;
+    for (int k = 0; k < BINS; k++) {
+        float power = k < HALF_SIZE ? fft.re[k] * fft.re[k] + fft.im[k] * fft.im[k] : fft.nyquist * fft.nyquist;
+        noisePower[k] = smoothing * noisePower[k] + (1.0f - smoothing) * power;
+    }
+    if (noiseFrames < MIN_NOISE_FRAMES) {
+        noiseFrames++;
+    }
+}
+
+void NoiseSuppressor::start(int16_t* pcm) {
+    this->pcm = pcm;
+    active = pcm && isReady();
+    inputPos = 0;
+    outputPos = 0;
+    frameCount = 0;
+    for (int i = 0; i < HOP_SIZE; i++) {
+        history[i] = 0;
+        overlap[i] = 0;
+    }
+    for (int k = 0; k < BINS; k++) {
+        cleanPower[k] = noisePower[k];
+    }
+    cycles = 0;
+    noiseIn = 0;
+    noiseOut = 0;
+}
+
+void NoiseSuppressor::processHop(const int16_t* input, int count, size_t limit) {
+    uint32_t startCycles = ESP.getCycleCount();
+
+    // Frame = previous hop + this hop (zero-padded), windowed and packed as even/odd pairs
+    for (int n = 0; n < HOP_SIZE / 2; n++) {
+        fft.re[n] = history[2 * n] * window[2 * n];
+        fft.im[n] = history[2 * n + 1] * window[2 * n + 1];
+    }
+    for (int i = 0; i < HOP_SIZE; i++) {
+        history[i] = i < count ? input[i] : 0;
+    }
+    for (int n = 0; n < HOP_SIZE / 2; n++) {
+        fft.re[HOP_SIZE / 2 + n] = history[2 * n] * window[HOP_SIZE + 2 * n];
+        fft.im[HOP_SIZE / 2 + n] = history[2 * n + 1] * window[HOP_SIZE + 2 * n + 1];
+    }
+    fft.forward();
+
+    // Decision-directed Wiener gain per bin
+    float frameNoise = 0;
+    float frameNoiseOut = 0;
+    for (int k = 0; k < BINS; k++) {
+        bool isNyquist = k == HALF_SIZE;
+        float power = isNyquist ? fft.nyquist * fft.nyquist : fft.re[k] * fft.re[k] + fft.im[k] * fft.im[k];
+        float noise = noisePower[k] > 1.0f ? noisePower[k] : 1.0f;
+        float posterior = power / noise - 1.0f;
+        float prior = DD_BETA * cleanPower[k] / noise + (1.0f - DD_BETA) * (posterior > 0 ? posterior : 0);
+        float gain = prior / (1.0f + prior);
+        if (gain < MIN_GAIN) {
+            gain = MIN_GAIN;
+        }
+        cleanPower[k] = gain * gain * power;
+        frameNoise += noise;
+        frameNoiseOut += noise * gain * gain;
+        if (isNyquist) {
+            fft.nyquist *= gain;
+        } else {
+            fft.re[k] *= gain;
+            fft.im[k] *= gain;
+        }
+    }
+    noiseIn += frameNoise;
+    noiseOut += frameNoiseOut;
+
+    fft.inverse();
+
+    // Overlap-add: the first half completes the previous hop, the second waits for the next frame
+    size_t base = frameCount > 0 ? (frameCount - 1) * HOP_SIZE : 0;
+    for (int n = 0; n < HOP_SIZE / 2; n++) {
+        for (int j = 0; j < 2; j++) {
+            int i = 2 * n + j;
+            float value = overlap[i] + (j ? fft.im[n] : fft.re[n]) * window[i];
+            overlap[i] = (j ? fft.im[HOP_SIZE / 2 + n] : fft.re[HOP_SIZE / 2 + n]) * window[HOP_SIZE + i];
+            size_t pos = base + i;
+            if (frameCount > 0 && pos < limit) {
+                int32_t sample = (int32_t)lroundf(value);
+                pcm[pos] = sample > 32767 ? 32767 : (sample < -32768 ? -32768 : sample);
+            }
+        }
+    }
+
+    frameCount++;
+    size_t done = (frameCount - 1) * HOP_SIZE;
+    outputPos = done < limit ? done : limit;
+    cycles += ESP.getCycleCount() - startCycles;
+}
+
+size_t NoiseSuppressor::process(size_t available) {
+    if (!active) {
+        outputPos = available;
+        return outputPos;
+    }
+    while (inputPos + HOP_SIZE <= available) {
+        processHop(pcm + inputPos, HOP_SIZE, available);
+        inputPos += HOP_SIZE;
+    }
+    return outputPos;
+}
+
+void NoiseSuppressor::finish(size_t total) {
+    if (!active) {
+        outputPos = total;
+        return;
+    }
+    process(total);
+    if (inputPos < total) {
+        processHop(pcm + inputPos, total - inputPos, total);
+        inputPos += HOP_SIZE;
+    }
+    processHop(nullptr, 0, total);  // Flush the last overlap
+    outputPos = total;
+    active = false;
+
+    float seconds = (float)total / SAMPLE_RATE;
+    if (seconds > 0 && noiseOut > 0) {
+        Serial.printf("🔇 Noise suppression: %.1f s of audio, %.1f dB noise reduction, %.1f ms CPU per second of audio\n",
+                      seconds, 10.0 * log10(noiseIn / noiseOut), cycles / (ESP.getCpuFreqMHz() * 1000.0f) / seconds);
+    }
+}
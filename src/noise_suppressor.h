@@ -0,0 +1,77 @@
+#ifndef NOISE_SUPPRESSOR_H
+#define NOISE_SUPPRESSOR_H
+
+#include <Arduino.h>
+#include "real_fft.h"
+
+// STFT noise suppressor for command audio: 512-point frames with 50% overlap, sqrt-Hann analysis
+// and synthesis windows, and a decision-directed Wiener gain per frequency bin. The noise
+// spectrum is learned from microphone blocks the VAD classes as background, so it is ready
+// before a command starts. The command buffer is processed in place while it is being recorded,
+// one hop behind the newest audio.
+class NoiseSuppressor {
+public:
+    static const int FRAME_SIZE = RealFft::SIZE;    // 32 ms at 16 kHz
+    static const int HOP_SIZE = FRAME_SIZE / 2;
+
+private:
+    static const int SAMPLE_RATE = 16000;
+    static const int HALF_SIZE = RealFft::HALF;
+    static const int BINS = FRAME_SIZE / 2 + 1;
+    static const int OBSERVE_INTERVAL = 4;              // Analyse every 4th background frame (~8/s)
+    static const int MIN_NOISE_FRAMES = 8;              // ~1 s of background before suppressing
+    static constexpr float NOISE_SMOOTHING = 0.9f;
+    static constexpr float DD_BETA = 0.98f;             // A priori SNR smoothing (less musical noise)
+    static constexpr float MIN_GAIN = 0.1f;             // -20 dB floor
+
+    RealFft fft;
+    float window[FRAME_SIZE];
+
+    float noisePower[BINS];
+    int noiseFrames;
+    int observeCount;           // Background frames seen
+    int16_t background[FRAME_SIZE];     // Background frame being collected from capture blocks
+    int backgroundFill;
+
+    // Current stream
+    int16_t* pcm;
+    bool active;                // False until the noise estimate is ready - audio passes unchanged
+    size_t inputPos;            // Samples consumed
+    size_t outputPos;           // Samples written back (final)
+    uint32_t frameCount;
+    float history[HOP_SIZE];    // Unprocessed input of the previous hop
+    float overlap[HOP_SIZE];    // Second half of the previous output frame
+    float cleanPower[BINS];     // |G*X|^2 of the previous frame
+
+    // Per-stream statistics
+    uint64_t cycles;
+    double noiseIn;
+    double noiseOut;
+
+    void analyseBackground();
+    void processHop(const int16_t* input, int count, size_t limit);
+
+public:
+    NoiseSuppressor();
+
+    // Feed a background block (any length, 16-bit units) from the capture path; blocks are
+    // joined into FRAME_SIZE frames
+    void observeBackground(const int32_t* block, int count);
+    // The background was interrupted (speech) - drop the partly collected frame
+    void interruptBackground() { backgroundFill = 0; }
+    bool isReady() const { return noiseFrames >= MIN_NOISE_FRAMES; }
+
+    // Start suppressing a new recording held in pcm
+    void start(int16_t* pcm);
+
+    // Process all complete hops of the first `available` samples; returns how many samples are
+    // final (they no longer change)
+    size_t process(size_t available);
+
+    // Process the tail of a recording of `total` samples; everything is final afterwards
+    void finish(size_t total);
+
+    size_t getProcessed() const { return outputPos; }
+};
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef PCM_SEGMENT_H
+#define PCM_SEGMENT_H
+
+#include <Arduino.h>
+
+// A run of 16-bit PCM samples; one upload can span several (e.g. both halves of a ring buffer)
+struct PcmSegment {
+    const uint8_t* data;
+    size_t size;
+};
+
+#endif
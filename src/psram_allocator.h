@@ -0,0 +1,90 @@
+#ifndef PSRAM_ALLOCATOR_H
+#define PSRAM_ALLOCATOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "esp_heap_caps.h"
+
+// ArduinoJson allocator that keeps JsonDocument memory in PSRAM (falls back to internal RAM)
+// so parsing large messages doesn't fragment the heap needed for TLS and WiFi.
+class SpiRamAllocator : public ArduinoJson::Allocator {
+public:
+    void* allocate(size_t size) override {
+        void* ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+        return ptr ? ptr : malloc(size);
+    }
+
+    void deallocate(void* pointer) override {
+        heap_caps_free(pointer);
+    }
+
+    void* reallocate(void* pointer, size_t new_size) override {
+        void* ptr = heap_caps_realloc(pointer, new_size, MALLOC_CAP_SPIRAM);
+        return ptr ? ptr : realloc(pointer, new_size);
+    }
+
+    static SpiRamAllocator* instance() {
+        static SpiRamAllocator allocator;
+        return &allocator;
+    }
+};
+
+// SpiRamAllocator with a byte budget: a JsonDocument on it fails with NoMemory instead of
+// growing, so parsing an unexpectedly large response stays within a fixed memory bound.
+class BoundedSpiRamAllocator : public ArduinoJson::Allocator {
+private:
+    struct Header {
+        size_t size;
+        uint32_t reserved;  // Keeps the returned block 8-byte aligned
+    };
+
+    size_t budget;
+    size_t used;
+
+public:
+    explicit BoundedSpiRamAllocator(size_t budget) : budget(budget), used(0) {}
+
+    void* allocate(size_t size) override {
+        if (used + size > budget) {
+            return nullptr;
+        }
+        Header* header = (Header*)SpiRamAllocator::instance()->allocate(sizeof(Header) + size);
+        if (!header) {
+            return nullptr;
+        }
+        header->size = size;
+        used += size;
+        return header + 1;
+    }
+
+    void deallocate(void* pointer) override {
+        if (!pointer) {
+            return;
+        }
+        Header* header = (Header*)pointer - 1;
+        used -= header->size;
+        SpiRamAllocator::instance()->deallocate(header);
+    }
+
+    void* reallocate(void* pointer, size_t new_size) override {
+        if (!pointer) {
+            return allocate(new_size);
+        }
+        Header* header = (Header*)pointer - 1;
+        size_t old_size = header->size;
+        if (used - old_size + new_size > budget) {
+            return nullptr;
+        }
+        header = (Header*)SpiRamAllocator::instance()->reallocate(header, sizeof(Header) + new_size);
+        if (!header) {
+            return nullptr;
+        }
+        header->size = new_size;
+        used = used - old_size + new_size;
+        return header + 1;
+    }
+
+    size_t getUsed() const { return used; }
+};
+
+#endif
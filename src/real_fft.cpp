@@ -0,0 +1,106 @@
+#include "real_fft.h"
+#include <math.h>
+
+float RealFft::cosTable[RealFft::HALF];
+float RealFft::sinTable[RealFft::HALF];
+bool RealFft::tablesReady = false;
+
+RealFft::RealFft() : nyquist(0) {
+    if (!tablesReady) {
+        for (int k = 0; k < HALF; k++) {
+            cosTable[k] = cosf(2.0f * (float)M_PI * k / SIZE);
+            sinTable[k] = -sinf(2.0f * (float)M_PI * k / SIZE);
+        }
+        tablesReady = true;
+    }
+    for (int k = 0; k < HALF; k++) {
+        re[k] = 0;
+        im[k] = 0;
+    }
+}
+
+void RealFft::fft() {
+    // Bit-reversal permutation
+    for (int i = 1, j = 0; i < HALF; i++) {
+        int bit = HALF >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            float t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    // Radix-2 butterflies; a HALF-point FFT uses every other twiddle of the SIZE-point table
+    for (int len = 2; len <= HALF; len <<= 1) {
+        int half = len >> 1;
+        int step = SIZE / len;
+        for (int i = 0; i < HALF; i += len) {
+            for (int m = 0; m < half; m++) {
+                float wr = cosTable[m * step];
+                float wi = sinTable[m * step];
+                int a = i + m;
+                int b = a + half;
+                float vr = re[b] * wr - im[b] * wi;
+                float vi = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - vr;
+                im[b] = im[a] - vi;
+                re[a] += vr;
+                im[a] += vi;
+            }
+        }
+    }
+}
+
+void RealFft::forward() {
+    // re/im hold even/odd samples as one complex sequence; untangle its FFT into the real spectrum
+    fft();
+    float dc = re[0] + im[0];
+    nyquist = re[0] - im[0];
+    re[0] = dc;
+    im[0] = 0;
+    for (int k = 1; k <= HALF / 2; k++) {
+        int m = HALF - k;
+        float evenRe = (re[k] + re[m]) * 0.5f;
+        float evenIm = (im[k] - im[m]) * 0.5f;
+        float oddRe = (im[k] + im[m]) * 0.5f;
+        float oddIm = (re[m] - re[k]) * 0.5f;
+        float twRe = cosTable[k] * oddRe - sinTable[k] * oddIm;
+        float twIm = cosTable[k] * oddIm + sinTable[k] * oddRe;
+        re[k] = evenRe + twRe;
+        im[k] = evenIm + twIm;
+        re[m] = evenRe - twRe;
+        im[m] = twIm - evenIm;
+    }
+}
+
+void RealFft::inverse() {
+    // Rebuild the packed even/odd sequence, then inverse FFT via conjugation
+    float z0Re = (re[0] + nyquist) * 0.5f;
+    float z0Im = (re[0] - nyquist) * 0.5f;
+    re[0] = z0Re;
+    im[0] = -z0Im;
+    for (int k = 1; k <= HALF / 2; k++) {
+        int m = HALF - k;
+        float evenRe = (re[k] + re[m]) * 0.5f;
+        float evenIm = (im[k] - im[m]) * 0.5f;
+        float diffRe = (re[k] - re[m]) * 0.5f;
+        float diffIm = (im[k] + im[m]) * 0.5f;
+        // Odd part = diff * conj(W^k)
+        float oddRe = diffRe * cosTable[k] + diffIm * sinTable[k];
+        float oddIm = diffIm * cosTable[k] - diffRe * sinTable[k];
+        // Z[k] = even + i*odd, Z[m] = conj(even) + i*conj(odd); stored conjugated for the inverse
+        re[k] = evenRe - oddIm;
+        im[k] = -(evenIm + oddRe);
+        re[m] = evenRe + oddIm;
+        im[m] = -(oddRe - evenIm);
+    }
+    fft();
+    const float scale = 1.0f / HALF;
+    for (int n = 0; n < HALF; n++) {
+        re[n] *= scale;
+        im[n] *= -scale;
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef REAL_FFT_H
+#define REAL_FFT_H
+
+#include <Arduino.h>
+
+// 512-point FFT of real audio frames, computed as a 256-point complex radix-2 FFT of the
+// even/odd sample pairs. Callers pack the frame into re/im (even samples in re, odd in im),
+// call forward() and read bins 0..255 from re/im plus the real Nyquist bin; inverse() goes
+// back the same way. The twiddle table is shared by all instances.
+class RealFft {
+public:
+    static const int SIZE = 512;
+    static const int HALF = SIZE / 2;
+
+    float re[HALF];
+    float im[HALF];
+    float nyquist;
+
+private:
+    static float cosTable[HALF];       // e^(-2*pi*i*k/SIZE)
+    static float sinTable[HALF];
+    static bool tablesReady;
+
+    void fft();                        // In place on re/im, HALF points
+
+public:
+    RealFft();
+
+    void forward();
+    void inverse();
+};
+
+#endif
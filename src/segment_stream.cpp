@@ -0,0 +1,61 @@
+#include "segment_stream.h"
+
+SegmentStream::SegmentStream() : segmentCount(0), current(0), offset(0), remaining(0), totalSize(0), firstReadAt(0), lastReadAt(0) {
+}
+
+bool SegmentStream::add(const void* data, size_t size) {
+    if (size == 0) {
+        return true;
+    }
+    if (!data || segmentCount >= MAX_SEGMENTS) {
+        return false;
+    }
+    segments[segmentCount].data = (const uint8_t*)data;
+    segments[segmentCount].size = size;
+    segmentCount++;
+    remaining += size;
+    totalSize += size;
+    return true;
+}
+
+int SegmentStream::available() {
+    return remaining > INT32_MAX ? INT32_MAX : (int)remaining;
+}
+
+int SegmentStream::peek() {
+    if (remaining == 0) {
+        return -1;
+    }
+    return segments[current].data[offset];
+}
+
+int SegmentStream::read() {
+    uint8_t c;
+    return readBytes((char*)&c, 1) == 1 ? c : -1;
+}
+
+size_t SegmentStream::readBytes(char* buffer, size_t length) {
+    if (firstReadAt == 0) {
+        firstReadAt = millis();
+    }
+
+    size_t copied = 0;
+    while (copied < length && remaining > 0) {
+        const Segment& segment = segments[current];
+        size_t chunk = segment.size - offset;
+        if (chunk > length - copied) {
+            chunk = length - copied;
+        }
+        memcpy(buffer + copied, segment.data + offset, chunk);
+        copied += chunk;
+        offset += chunk;
+        remaining -= chunk;
+        if (offset == segment.size) {
+            current++;
+            offset = 0;
+        }
+    }
+
+    lastReadAt = millis();
+    return copied;
+}
@@ -0,0 +1,48 @@
+#ifndef SEGMENT_STREAM_H
+#define SEGMENT_STREAM_H
+
+#include <Arduino.h>
+
+// Presents several memory regions (e.g. a WAV header plus both halves of a wrapped ring
+// buffer) as one read-only Stream, so HTTPClient::sendRequest() can upload them back to back
+// without first copying everything into a contiguous buffer. The regions must stay untouched
+// until the upload finishes.
+class SegmentStream : public Stream {
+private:
+    struct Segment {
+        const uint8_t* data;
+        size_t size;
+    };
+
+    static const int MAX_SEGMENTS = 4;
+
+    Segment segments[MAX_SEGMENTS];
+    int segmentCount;
+    int current;            // Segment being read
+    size_t offset;          // Read position inside the current segment
+    size_t remaining;       // Unread bytes across all segments
+    size_t totalSize;
+    unsigned long firstReadAt;
+    unsigned long lastReadAt;
+
+public:
+    SegmentStream();
+
+    // Append a region (empty regions are skipped)
+    bool add(const void* data, size_t size);
+
+    size_t size() const { return totalSize; }
+    // Time between the first and last byte being read (the upload's transfer time)
+    unsigned long getTransferMs() const { return lastReadAt - firstReadAt; }
+
+    // Stream
+    int available() override;
+    int read() override;
+    int peek() override;
+    using Stream::readBytes;
+    size_t readBytes(char* buffer, size_t length) override;
+    size_t write(uint8_t) override { return 0; }
+    void flush() override {}
+};
+
+#endif
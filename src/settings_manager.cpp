@@ -1,8 +1,13 @@
 #include "settings_manager.h"
 #include <WiFi.h>
+#include "http_connection_pool.h"
 
 SettingsManager::SettingsManager(const String& apiUrl) 
-    : notificationsApiUrl(apiUrl), lastFetchTime(0) {
+    : notificationsApiUrl(apiUrl), lastFetchTime(0), fetchInFlight(false), fetchCallback(nullptr) {
+}
+
+String SettingsManager::getSettingsUrl() const {
+    return notificationsApiUrl + "/settings?device_id=companion_app";
 }
 
 bool SettingsManager::fetchSettings() {
@@ -12,60 +17,93 @@ bool SettingsManager::fetchSettings() {
     }
     
     HTTPClient http;
-    String settingsUrl = notificationsApiUrl + "/settings?device_id=companion_app";
+    String settingsUrl = getSettingsUrl();
     
     Serial.printf("📡 Fetching settings from: %s\n", settingsUrl.c_str());
     
-    if (http.begin(settingsUrl)) {
+    HttpConnectionPool& pool = HttpConnectionPool::shared();
+    bool reused = false;
+    WiFiClient* client = pool.acquire(settingsUrl, HttpConnectionPool::CONNECT_TIMEOUT, &reused);
+    http.setReuse(true);
+    while (client && http.begin(*client, settingsUrl)) {
         http.addHeader("Content-Type", "application/json");
-        http.setTimeout(10000); // 10 second timeout
+        http.setTimeout(FETCH_TIMEOUT);
         
         int httpCode = http.GET();
-        Serial.printf("Settings API HTTP Response Code: %d\n", httpCode);
+        if (pool.shouldRetryFresh(reused, httpCode)) {
+            http.end();
+            pool.release(client, false);
+            client = pool.acquireFresh(settingsUrl);
+            reused = false;
+            continue;
+        }
+        String response = http.getString();
+        http.end();
+        pool.release(client, httpCode > 0);
+        return applySettingsResponse(httpCode, response);
+    }
+    pool.release(client, false);
+    Serial.println("❌ Failed to begin HTTP connection to settings API");
+    
+    return false;
+}
+
+bool SettingsManager::fetchSettingsAsync(NetworkExecutor& executor, SettingsCallback callback) {
+    if (fetchInFlight) {
+        return true;  // The running request will report back
+    }
+    
+    Serial.printf("📡 Fetching settings in background from: %s\n", getSettingsUrl().c_str());
+    fetchCallback = callback;
+    fetchInFlight = executor.get("settings", getSettingsUrl(), NetPriority::BACKGROUND, FETCH_TIMEOUT, onSettingsResponse, this);
+    return fetchInFlight;
+}
+
+void SettingsManager::onSettingsResponse(const NetResponse& response, void* context) {
+    SettingsManager* manager = static_cast<SettingsManager*>(context);
+    manager->fetchInFlight = false;
+    if (manager->applySettingsResponse(response.statusCode, response.body) && manager->fetchCallback) {
+        manager->fetchCallback(manager->currentSettings);
+    }
+}
+
+bool SettingsManager::applySettingsResponse(int httpCode, const String& response) {
+    Serial.printf("Settings API HTTP Response Code: %d\n", httpCode);
+    
+    if (httpCode == HTTP_CODE_OK) {
+        Serial.println("Settings API Response:");
+        Serial.println(response);
         
-        if (httpCode == HTTP_CODE_OK) {
-            String response = http.getString();
-            Serial.println("Settings API Response:");
-            Serial.println(response);
-            
-            // Parse JSON response
-            JsonDocument doc;
-            DeserializationError error = deserializeJson(doc, response);
+        // Parse JSON response
+        JsonDocument doc;
+        DeserializationError error = deserializeJson(doc, response);
+        
+        if (error) {
+            Serial.printf("❌ Failed to parse settings JSON: %s\n", error.c_str());
+            return false;
+        }
+        
+        // Extract language setting
+        if (doc.containsKey("language")) {
+            currentSettings.language = doc["language"].as<String>();
+            currentSettings.isValid = true;
+            lastFetchTime = millis();
             
-            if (error) {
-                Serial.printf("❌ Failed to parse settings JSON: %s\n", error.c_str());
-                http.end();
-                return false;
-            }
+            Serial.printf("✅ Settings fetched successfully. Language: %s\n", currentSettings.language.c_str());
+            return true;
+        } else {
+            Serial.println("❌ Language setting not found in response");
             
-            // Extract language setting
-            if (doc.containsKey("language")) {
-                currentSettings.language = doc["language"].as<String>();
-                currentSettings.isValid = true;
-                lastFetchTime = millis();
-                
-                Serial.printf("✅ Settings fetched successfully. Language: %s\n", currentSettings.language.c_str());
-                http.end();
-                return true;
-            } else {
-                Serial.println("❌ Language setting not found in response");
-                
-                // Print available keys for debugging
-                Serial.println("Available keys in response:");
-                JsonObject obj = doc.as<JsonObject>();
-                for (JsonPair kv : obj) {
-                    Serial.printf("  - %s\n", kv.key().c_str());
-                }
+            // Print available keys for debugging
+            Serial.println("Available keys in response:");
+            JsonObject obj = doc.as<JsonObject>();
+            for (JsonPair kv : obj) {
+                Serial.printf("  - %s\n", kv.key().c_str());
             }
-        } else {
-            String error_response = http.getString();
-            Serial.printf("❌ HTTP Error Code: %d\n", httpCode);
-            Serial.println("Error Response: " + error_response);
         }
-        
-        http.end();
     } else {
-        Serial.println("❌ Failed to begin HTTP connection to settings API");
+        Serial.printf("❌ HTTP Error Code: %d\n", httpCode);
+        Serial.println("Error Response: " + response);
     }
     
     return false;
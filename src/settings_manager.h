@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include "network_executor.h"
 
 struct UserSettings {
     String language;
@@ -12,19 +13,33 @@ struct UserSettings {
     UserSettings() : language("en-US"), isValid(false) {}
 };
 
+typedef void (*SettingsCallback)(const UserSettings& settings);
+
 class SettingsManager {
 private:
     String notificationsApiUrl;
     UserSettings currentSettings;
     unsigned long lastFetchTime;
     static const unsigned long CACHE_DURATION = 300000; // 5 minutes cache
+    static const unsigned long FETCH_TIMEOUT = 10000; // 10 second timeout
+    
+    // Asynchronous refresh state
+    bool fetchInFlight;
+    SettingsCallback fetchCallback;
+
+    String getSettingsUrl() const;
+    bool applySettingsResponse(int httpCode, const String& response);
+    static void onSettingsResponse(const NetResponse& response, void* context);
 
 public:
     SettingsManager(const String& apiUrl);
 
-    // Fetch settings from the API
+    // Fetch settings from the API (blocks - use fetchSettingsAsync from the main loop)
     bool fetchSettings();
 
+    // Fetch settings on the network executor; the callback runs from its poll() on success
+    bool fetchSettingsAsync(NetworkExecutor& executor, SettingsCallback callback);
+
     // Get current settings (fetches if cache expired)
     UserSettings getSettings();
 
@@ -0,0 +1,137 @@
+#include "speculative_transcriber.h"
+
+SpeculativeTranscriber::SpeculativeTranscriber(const char* api_key)
+    : client(api_key), task(nullptr), jobSignal(nullptr), doneSignal(nullptr), state(JobState::IDLE),
+      jobRecording(0), jobAudio(nullptr), jobSize(0), jobHasStats(false), jobElapsedMs(0) {
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    jobMux = unlocked;
+}
+
+bool SpeculativeTranscriber::begin() {
+    if (task) {
+        return true;
+    }
+
+    if (!client.begin()) {
+        Serial.println("❌ Failed to initialize speculative Deepgram client");
+        return false;
+    }
+
+    jobSignal = xSemaphoreCreateBinary();
+    doneSignal = xSemaphoreCreateBinary();
+    if (!jobSignal || !doneSignal) {
+        Serial.println("❌ Failed to create speculative transcriber semaphores");
+        return false;
+    }
+
+    // Same core and priority as the network workers - the audio task on core 0 keeps recording
+    xTaskCreatePinnedToCore(taskEntry, "SpecSttTask", TASK_STACK_SIZE, this, 1, &task, 1);
+    if (!task) {
+        Serial.println("❌ Failed to create speculative transcriber task");
+        return false;
+    }
+    Serial.println("✅ Speculative transcriber started");
+    return true;
+}
+
+void SpeculativeTranscriber::setDefaultLanguage(const String& language) {
+    client.setDefaultLanguage(language);
+}
+
+bool SpeculativeTranscriber::start(uint32_t recording, const uint8_t* audio, size_t size,
+                                   const AudioWindowStats* stats) {
+    if (!task || !audio || size == 0) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&jobMux);
+    bool idle = state != JobState::RUNNING;
+    if (idle) {
+        state = JobState::RUNNING;
+        jobRecording = recording;
+        jobAudio = audio;
+        jobSize = size;
+        jobHasStats = stats != nullptr;
+        if (stats) {
+            jobStats = *stats;
+        }
+    }
+    portEXIT_CRITICAL(&jobMux);
+    if (!idle) {
+        return false;
+    }
+
+    xSemaphoreTake(doneSignal, 0);  // Drop a completion nobody waited for
+    xSemaphoreGive(jobSignal);
+    Serial.printf("⚡ Speculative transcription of %u bytes started\n", size);
+    return true;
+}
+
+bool SpeculativeTranscriber::isBusy() {
+    portENTER_CRITICAL(&jobMux);
+    bool busy = state == JobState::RUNNING;
+    portEXIT_CRITICAL(&jobMux);
+    return busy;
+}
+
+bool SpeculativeTranscriber::waitUntilIdle(unsigned long timeoutMs) {
+    unsigned long waitStart = millis();
+    while (isBusy()) {
+        if (millis() - waitStart >= timeoutMs) {
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return true;
+}
+
+bool SpeculativeTranscriber::takeResult(uint32_t recording, size_t size, String& result, unsigned long timeoutMs) {
+    portENTER_CRITICAL(&jobMux);
+    bool matches = state != JobState::IDLE && jobRecording == recording && jobSize == size;
+    bool running = state == JobState::RUNNING;
+    portEXIT_CRITICAL(&jobMux);
+    if (!matches) {
+        return false;
+    }
+
+    unsigned long waitStart = millis();
+    if (running && xSemaphoreTake(doneSignal, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+        Serial.printf("⚠️ Speculative transcript not ready after %lu ms\n", timeoutMs);
+        return false;
+    }
+
+    portENTER_CRITICAL(&jobMux);
+    bool done = state == JobState::DONE;
+    if (done) {
+        state = JobState::IDLE;  // The transcript is ours until the next start()
+    }
+    portEXIT_CRITICAL(&jobMux);
+    if (!done || transcript.isEmpty()) {
+        return false;
+    }
+
+    result = transcript;
+    Serial.printf("⚡ Using speculative transcript (upload took %lu ms, waited %lu ms at end of speech)\n",
+                  jobElapsedMs, millis() - waitStart);
+    return true;
+}
+
+void SpeculativeTranscriber::taskEntry(void* parameter) {
+    static_cast<SpeculativeTranscriber*>(parameter)->workerLoop();
+}
+
+void SpeculativeTranscriber::workerLoop() {
+    while (true) {
+        xSemaphoreTake(jobSignal, portMAX_DELAY);
+
+        // The job fields don't change while RUNNING - start() refuses new jobs until DONE
+        unsigned long startTime = millis();
+        transcript = client.transcribe(jobAudio, jobSize, jobHasStats ? &jobStats : nullptr);
+        jobElapsedMs = millis() - startTime;
+
+        portENTER_CRITICAL(&jobMux);
+        state = JobState::DONE;
+        portEXIT_CRITICAL(&jobMux);
+        xSemaphoreGive(doneSignal);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef SPECULATIVE_TRANSCRIBER_H
+#define SPECULATIVE_TRANSCRIBER_H
+
+#include <Arduino.h>
+#include "deepgram_client.h"
+
+// Transcribes the command recorded so far on a background task while recording continues, so
+// the transcript is usually ready by the time the end of the command is detected. A job covers
+// a prefix of the command buffer; the audio task only takes its result if no speech followed.
+class SpeculativeTranscriber {
+private:
+    enum class JobState : uint8_t {
+        IDLE,
+        RUNNING,
+        DONE
+    };
+
+    static const uint32_t TASK_STACK_SIZE = 8192;
+
+    DeepgramClient client;      // Own client - the audio task may be transcribing with the shared one
+    TaskHandle_t task;
+    SemaphoreHandle_t jobSignal;
+    SemaphoreHandle_t doneSignal;
+    portMUX_TYPE jobMux;
+
+    JobState state;
+    uint32_t jobRecording;      // Recording the job belongs to
+    const uint8_t* jobAudio;
+    size_t jobSize;
+    AudioWindowStats jobStats;
+    bool jobHasStats;
+    String transcript;
+    unsigned long jobElapsedMs;
+
+    static void taskEntry(void* parameter);
+    void workerLoop();
+
+public:
+    SpeculativeTranscriber(const char* api_key);
+
+    // Starts the worker task (call once PSRAM and WiFi are up)
+    bool begin();
+
+    void setDefaultLanguage(const String& language);
+
+    // Transcribe audio[0, size) of the given recording in the background. The caller keeps the
+    // buffer unchanged up to size until the result is taken or the recording is abandoned.
+    // stats (optional) describes the same audio and is copied. Returns false while a previous job
+    // is still running.
+    bool start(uint32_t recording, const uint8_t* audio, size_t size, const AudioWindowStats* stats = nullptr);
+
+    bool isBusy();
+
+    // Blocks until no job is running (true) or timeoutMs passes. A job reads its buffer until
+    // the upload ends, so call this before reusing the buffer for a new recording.
+    bool waitUntilIdle(unsigned long timeoutMs);
+
+    // Transcript for exactly audio[0, size) of the recording, waiting up to timeoutMs if that job
+    // is still running. Returns false if there is no such job or it produced no transcript.
+    bool takeResult(uint32_t recording, size_t size, String& result, unsigned long timeoutMs);
+};
+
+#endif
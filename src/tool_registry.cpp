@@ -0,0 +1,195 @@
+#include "tool_registry.h"
+
+ToolRegistry::ToolRegistry() : toolCount(0), nextCallId(1), nextBatch(1) {
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        calls[i].id = 0;
+    }
+}
+
+bool ToolRegistry::registerTool(const char* name, ToolHandler handler) {
+    if (toolCount >= MAX_TOOLS) {
+        Serial.printf("❌ Tool registry full - cannot register %s\n", name);
+        return false;
+    }
+    tools[toolCount].name = name;
+    tools[toolCount].handler = handler;
+    toolCount++;
+    return true;
+}
+
+const ToolRegistry::Tool* ToolRegistry::findTool(const char* name) const {
+    if (!name) {
+        return nullptr;
+    }
+    for (int i = 0; i < toolCount; i++) {
+        if (strcmp(tools[i].name, name) == 0) {
+            return &tools[i];
+        }
+    }
+    return nullptr;
+}
+
+ToolRegistry::PendingCall* ToolRegistry::findCall(ToolCallId id) {
+    if (id == 0) {
+        return nullptr;
+    }
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        if (calls[i].id == id) {
+            return &calls[i];
+        }
+    }
+    return nullptr;
+}
+
+void ToolRegistry::releaseCall(PendingCall& call) {
+    call.id = 0;
+    call.functionId = String();
+    call.name = String();
+    call.result = String();
+}
+
+void ToolRegistry::dispatch(JsonArrayConst functionCalls) {
+    uint32_t batch = nextBatch++;
+    unsigned long now = millis();
+
+    // Reserve a slot for every call first, so a handler that completes immediately
+    // can't finish the batch before the remaining calls are registered
+    ToolCallId batchIds[MAX_PENDING_CALLS];
+    JsonObjectConst batchCalls[MAX_PENDING_CALLS];
+    int batchSize = 0;
+    int nextSlot = 0;
+
+    for (JsonObjectConst funcCall : functionCalls) {
+        const char* toolName = funcCall["name"];
+        const char* functionId = funcCall["id"];
+        Serial.printf("Tool call detected: %s (ID: %s)\n", toolName ? toolName : "?", functionId ? functionId : "N/A");
+
+        while (nextSlot < MAX_PENDING_CALLS && calls[nextSlot].id != 0) {
+            nextSlot++;
+        }
+        if (nextSlot == MAX_PENDING_CALLS) {
+            Serial.printf("❌ Too many pending tool calls - dropping %s\n", toolName ? toolName : "?");
+            continue;
+        }
+
+        PendingCall& call = calls[nextSlot];
+        const Tool* tool = findTool(toolName);
+        call.id = nextCallId++;
+        if (nextCallId == 0) {
+            nextCallId = 1;
+        }
+        call.batch = batch;
+        call.functionId = functionId ? functionId : "";
+        call.name = toolName ? toolName : "";
+        call.isError = false;
+        call.done = false;
+        call.startedAt = now;
+        if (!tool) {
+            Serial.printf("Tool call for unknown tool: %s\n", toolName ? toolName : "?");
+            call.result = "Unknown tool";
+            call.isError = true;
+            call.done = true;
+        }
+
+        batchIds[batchSize] = call.id;
+        batchCalls[batchSize] = funcCall;
+        batchSize++;
+    }
+
+    // Start the handlers; network-bound ones only queue their requests and return
+    for (int i = 0; i < batchSize; i++) {
+        PendingCall* call = findCall(batchIds[i]);
+        if (!call || call->done) {
+            continue;
+        }
+        const Tool* tool = findTool(call->name.c_str());
+        tool->handler(batchCalls[i]["args"], call->id);
+    }
+}
+
+void ToolRegistry::complete(ToolCallId id, const String& result, bool isError) {
+    PendingCall* call = findCall(id);
+    if (!call || call->done) {
+        return;  // Cancelled, expired or dropped with its connection
+    }
+    call->result = result;
+    call->isError = isError;
+    call->done = true;
+    Serial.printf("🔧 %s finished in %lu ms%s\n", call->name.c_str(), millis() - call->startedAt, isError ? " (error)" : "");
+}
+
+void ToolRegistry::expire(unsigned long now) {
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        PendingCall& call = calls[i];
+        if (call.id != 0 && !call.done && now - call.startedAt >= CALL_TIMEOUT) {
+            Serial.printf("⚠️ Tool call %s timed out\n", call.name.c_str());
+            call.result = "Timed out";
+            call.isError = true;
+            call.done = true;
+        }
+    }
+}
+
+void ToolRegistry::cancel(JsonArrayConst functionIds) {
+    for (JsonVariantConst functionId : functionIds) {
+        const char* idText = functionId.as<const char*>();
+        if (!idText) {
+            continue;
+        }
+        for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+            if (calls[i].id != 0 && calls[i].functionId == idText) {
+                Serial.printf("Tool call %s cancelled by server\n", calls[i].name.c_str());
+                releaseCall(calls[i]);
+            }
+        }
+    }
+}
+
+void ToolRegistry::clear() {
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        if (calls[i].id != 0) {
+            releaseCall(calls[i]);
+        }
+    }
+}
+
+bool ToolRegistry::takeResponse(String& message) {
+    // Find a batch with no unfinished calls
+    for (int i = 0; i < MAX_PENDING_CALLS; i++) {
+        if (calls[i].id == 0) {
+            continue;
+        }
+        uint32_t batch = calls[i].batch;
+        bool complete = true;
+        for (int j = 0; j < MAX_PENDING_CALLS && complete; j++) {
+            if (calls[j].id != 0 && calls[j].batch == batch && !calls[j].done) {
+                complete = false;
+            }
+        }
+        if (!complete) {
+            continue;
+        }
+
+        // One toolResponse carries every result of the batch
+        JsonDocument doc;
+        JsonArray responses = doc["toolResponse"]["functionResponses"].to<JsonArray>();
+        for (int j = 0; j < MAX_PENDING_CALLS; j++) {
+            PendingCall& call = calls[j];
+            if (call.id == 0 || call.batch != batch) {
+                continue;
+            }
+            JsonObject response = responses.add<JsonObject>();
+            if (call.functionId.length() > 0) {
+                response["id"] = call.functionId;
+            }
+            response["name"] = call.name;
+            response["response"][call.isError ? "error" : "output"] = call.result;
+            releaseCall(call);
+        }
+
+        message = "";
+        serializeJson(doc, message);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,74 @@
+#ifndef TOOL_REGISTRY_H
+#define TOOL_REGISTRY_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Identifies one pending function call (0 is never used)
+typedef uint32_t ToolCallId;
+
+// Tool handlers start the work for one call and report the result later with complete().
+// args point into the parsed message and are only valid during the handler call.
+typedef void (*ToolHandler)(JsonObjectConst args, ToolCallId callId);
+
+// Maps Gemini function names to handlers and collects their results. Every call of one
+// toolCall message is started before any result is awaited, so handlers that hand their
+// work to the network executor run concurrently. The batch is answered with a single
+// toolResponse once every call has completed (or timed out).
+class ToolRegistry {
+private:
+    struct Tool {
+        const char* name;
+        ToolHandler handler;
+    };
+
+    struct PendingCall {
+        ToolCallId id;          // 0 = free slot
+        uint32_t batch;
+        String functionId;
+        String name;
+        String result;
+        bool isError;
+        bool done;
+        unsigned long startedAt;
+    };
+
+    static const int MAX_TOOLS = 8;
+    static const int MAX_PENDING_CALLS = 8;
+    static const unsigned long CALL_TIMEOUT = 20000; // Answer with an error rather than leave the model waiting
+
+    Tool tools[MAX_TOOLS];
+    int toolCount;
+    PendingCall calls[MAX_PENDING_CALLS];
+    ToolCallId nextCallId;
+    uint32_t nextBatch;
+
+    const Tool* findTool(const char* name) const;
+    PendingCall* findCall(ToolCallId id);
+    void releaseCall(PendingCall& call);
+
+public:
+    ToolRegistry();
+
+    bool registerTool(const char* name, ToolHandler handler);
+
+    // Start every call of a toolCall message
+    void dispatch(JsonArrayConst functionCalls);
+
+    // Report a call's result (unknown or cancelled ids are ignored)
+    void complete(ToolCallId id, const String& result, bool isError = false);
+
+    // Fail calls whose handlers never reported back
+    void expire(unsigned long now);
+
+    // Drop calls the server cancelled (toolCallCancellation ids)
+    void cancel(JsonArrayConst functionIds);
+
+    // Drop everything (the connection the calls came from is gone)
+    void clear();
+
+    // Serialize the next fully completed batch as a toolResponse message
+    bool takeResponse(String& message);
+};
+
+#endif
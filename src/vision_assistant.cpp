@@ -7,22 +7,63 @@
 #include "camera_pins.h"
 #include "camera_setup.h"
 #include "gemini_config.h"
+#include "psram_allocator.h"
 #include "secrets.h"
+#include "setup_message.h"
 
 VisionAssistant *VisionAssistant::instance = nullptr;
 
-VisionAssistant::VisionAssistant() : setupComplete(false), systemPromptSent(false), lastFrameTime(0), lastGPSUpdate(0), responseCallback(nullptr), toolCallback(nullptr), queueHead(0), queueTail(0), queueSize(0) {
+// Each voice command chunk is one realtimeInput message around the base64 PCM
+static const char AUDIO_CHUNK_PREFIX[] = "{\"realtimeInput\":{\"audio\":{\"mimeType\":\"audio/pcm;rate=16000\",\"data\":\"";
+static const char AUDIO_CHUNK_SUFFIX[] = "\"}}}";
+
+VisionAssistant::VisionAssistant() : setupComplete(false), systemPromptSent(false), lastFrameTime(0), lastGPSUpdate(0), responseCallback(nullptr), audioCallback(nullptr), nativeAudioEnabled(GEMINI_NATIVE_AUDIO), audioDecodeBuffer(nullptr), audioCommandsEnabled(GEMINI_AUDIO_COMMANDS), pendingCommandPath(CommandPath::TEXT), pendingCommandStart(0), frameCacheNewest(-1), queueHead(0), queueTail(0), queueSize(0), droppedCommands(0),
+                                     messageAllocator(SIZE_MAX), messageDoc(&messageAllocator),
+                                     resumptionAttempted(false), disconnectedAt(0), connectedAt(0), setupCompletedAt(0), awaitingFirstResponse(false),
+                                     reconnectDelay(0), reconnectWindowStart(0), goAwayReconnect(false), lastLinkReport(0), framesSent(0), trafficWindowStart(0) {
     instance = this;  // Set static instance for callbacks
+    resumptionHandle[0] = '\0';
+    buildMessageFilter();
 }
 
 VisionAssistant::~VisionAssistant() {
     instance = nullptr;
+    if (audioDecodeBuffer) {
+        free(audioDecodeBuffer);
+    }
+    for (int i = 0; i < FRAME_CACHE_SIZE; i++) {
+        if (frameCache[i].data) {
+            free(frameCache[i].data);
+        }
+    }
+    free(audioUpload.message);
+    free(audioUpload.pcm);
 }
 
 bool VisionAssistant::initialize() {
     Serial.begin(115200);
     Serial.println("Initializing Vision Assistant...");
 
+    // Allocate the PCM decode buffer for native audio responses
+    if (nativeAudioEnabled && !audioDecodeBuffer) {
+        audioDecodeBuffer = (uint8_t*)ps_malloc(AUDIO_DECODE_BUFFER_SIZE);
+        if (!audioDecodeBuffer) {
+            Serial.println("Failed to allocate audio decode buffer - falling back to text responses");
+            nativeAudioEnabled = false;
+        }
+    }
+
+    // Allocate the frame cache (JPEG copies, so commands can reuse the latest view)
+    for (int i = 0; i < FRAME_CACHE_SIZE; i++) {
+        if (!frameCache[i].data) {
+            frameCache[i].data = (uint8_t*)ps_malloc(MAX_FRAME_SIZE);
+            if (!frameCache[i].data) {
+                Serial.println("Failed to allocate frame cache");
+                return false;
+            }
+        }
+    }
+
     // Initialize camera
     if (!initializeCamera()) {
         Serial.println("Failed to initialize camera");
@@ -59,13 +100,28 @@ void VisionAssistant::run() {
     // Handle WebSocket communication
     ws.loop();
 
-    // Update GPS data
+    // Probe the link and drop it if the server stopped answering
     unsigned long currentTime = millis();
-    if (currentTime - lastGPSUpdate >= GPS_UPDATE_INTERVAL) {
+    monitorLink(currentTime);
+
+    reportTraffic(currentTime);
+
+    // Answer tool calls whose handlers never reported back
+    toolRegistry.expire(currentTime);
+    sendToolResponses();
+
+    // Update GPS data as soon as a burst arrives (the interval is a fallback)
+    if (gps.takeDataPending() || currentTime - lastGPSUpdate >= GPS_UPDATE_INTERVAL) {
         gps.update();
         lastGPSUpdate = currentTime;
     }
 
+    // Stream the next chunk of a voice command; periodic frames wait until it is sent
+    if (isStreamingAudioCommand()) {
+        continueAudioCommand();
+        return;
+    }
+
     // Check if it's time to process a new frame
     if (currentTime - lastFrameTime >= FRAME_INTERVAL) {
         processFrame();
@@ -73,12 +129,100 @@ void VisionAssistant::run() {
     }
 }
 
+void VisionAssistant::monitorLink(unsigned long now) {
+    if (ws.isConnected()) {
+        const char* stall = linkMonitor.checkStall(now);
+        if (stall) {
+            // A half-open socket keeps accepting writes - only missing replies give it away
+            Serial.printf("⚠️ Gemini link stalled (%s) - reconnecting\n", stall);
+            ws.disconnect();
+            return;
+        }
+        if (linkMonitor.isPingDue(now) && ws.sendPing()) {
+            linkMonitor.onPingSent(now);
+        }
+    } else if (now - reconnectWindowStart >= reconnectDelay) {
+        // Still down after the last interval - the library has retried, so back off further
+        applyReconnectBackoff(now);
+    }
+
+    if (now - lastLinkReport >= LINK_REPORT_INTERVAL) {
+        lastLinkReport = now;
+        LinkQuality quality = linkMonitor.getQuality(now);
+        Serial.printf("📶 Link: %s, RTT p50 %u ms / p90 %u ms / max %u ms (%u samples), last response %lu ms ago, %u reconnects, %u stalls\n",
+                      quality.connected ? "up" : "down", quality.rttP50Ms, quality.rttP90Ms, quality.rttMaxMs, quality.rttSamples,
+                      quality.lastResponseAgeMs, quality.reconnectCount, quality.stallCount);
+    }
+}
+
+void VisionAssistant::applyReconnectBackoff(unsigned long now) {
+    reconnectDelay = linkMonitor.nextReconnectDelay();
+    reconnectWindowStart = now;
+    ws.setReconnectInterval(reconnectDelay);
+}
+
+void VisionAssistant::reconnectSoon(unsigned long now) {
+    // The library retries after GOAWAY_RECONNECT_DELAY; monitorLink only starts backing off
+    // if the link is still down once the backoff the link was already on has passed
+    unsigned long backoff = linkMonitor.getQuality(now).reconnectDelayMs;
+    reconnectDelay = backoff > GOAWAY_RECONNECT_DELAY ? backoff : GOAWAY_RECONNECT_DELAY;
+    reconnectWindowStart = now;
+    ws.setReconnectInterval(GOAWAY_RECONNECT_DELAY);
+}
+
+void VisionAssistant::reportTraffic(unsigned long now) {
+    unsigned long windowMs = now - trafficWindowStart;
+    if (windowMs < TRAFFIC_REPORT_INTERVAL) {
+        return;
+    }
+
+    const MessageStats& sent = ws.getSentStats();
+    Serial.printf("📊 Gemini traffic: %.2f frames/s | sent %u msgs (avg %u B, max %u B) | received %u msgs (avg %u B, max %u B)\n",
+                  framesSent * 1000.0f / windowMs,
+                  sent.messages, sent.messages ? sent.bytes / sent.messages : 0, sent.maxBytes,
+                  receivedStats.messages, receivedStats.messages ? receivedStats.bytes / receivedStats.messages : 0, receivedStats.maxBytes);
+
+    ws.resetSentStats();
+    receivedStats = MessageStats();
+    framesSent = 0;
+    trafficWindowStart = now;
+}
+
+LinkQuality VisionAssistant::getLinkQuality() const {
+    return linkMonitor.getQuality(millis());
+}
+
 void VisionAssistant::setResponseCallback(ResponseCallback callback) {
     responseCallback = callback;
 }
 
-void VisionAssistant::setToolCallback(ToolCallback callback) {
-    toolCallback = callback;
+bool VisionAssistant::registerTool(const char* name, ToolHandler handler) {
+    return toolRegistry.registerTool(name, handler);
+}
+
+void VisionAssistant::completeToolCall(ToolCallId callId, const String& result, bool isError) {
+    toolRegistry.complete(callId, result, isError);
+    sendToolResponses();
+}
+
+void VisionAssistant::setAudioCallback(AudioCallback callback) {
+    audioCallback = callback;
+}
+
+void VisionAssistant::setNativeAudioEnabled(bool enabled) {
+    nativeAudioEnabled = enabled;
+}
+
+bool VisionAssistant::isNativeAudioEnabled() const {
+    return nativeAudioEnabled;
+}
+
+void VisionAssistant::setAudioCommandsEnabled(bool enabled) {
+    audioCommandsEnabled = enabled;
+}
+
+bool VisionAssistant::isAudioCommandsEnabled() const {
+    return audioCommandsEnabled;
 }
 
 void VisionAssistant::processFrame() {
@@ -88,23 +232,25 @@ void VisionAssistant::processFrame() {
         return;
     }
 
-    // Capture frame
-    camera_fb_t *fb = esp_camera_fb_get();
-    if (!fb) {
-        Serial.println("Camera capture failed");
+    // Capture frame into the cache
+    const CachedFrame* frame = captureFrame();
+    if (!frame) {
         return;
     }
 
-    // Check frame size
-    if (fb->len > MAX_FRAME_SIZE) {
-        Serial.printf("Frame too large (%zu bytes), skipping\n", fb->len);
-        esp_camera_fb_return(fb);
-        return;
+    // Check for queued user commands and include them
+    String userCommand = "";
+    if (hasQueuedCommands()) {
+        userCommand = getNextQueuedCommand();
+        Serial.printf("Including queued user command: %s\n", userCommand.c_str());
     }
 
-    // Encode and send frame with GPS data
-    String frameB64 = base64_encode(fb->buf, fb->len);
-    Serial.printf("Frame captured: %zu bytes, Base64 length: %d\n", fb->len, frameB64.length());
+    sendClientTurn(userCommand, *frame);
+}
+
+void VisionAssistant::sendClientTurn(const String& userCommand, const CachedFrame& frame) {
+    // Encode frame
+    String frameB64 = base64_encode(frame.data, frame.length);
 
     // Get GPS data
     GPSData gpsData = gps.getGPSData();
@@ -128,29 +274,231 @@ void VisionAssistant::processFrame() {
         msg += "{\"text\":\"" + gpsText + "\"},";
     }
     
-    // Check for queued user commands and include them
-    if (hasQueuedCommands()) {
-        String userCommand = getNextQueuedCommand();
-        Serial.printf("Including queued user command: %s\n", userCommand.c_str());
+    // Add the user command if there is one
+    if (userCommand.length() > 0) {
         msg += "{\"text\":\"USER VOICE COMMAND: " + userCommand + "\"},";
     }
     
     // Add image data
     msg += "{\"inline_data\":{\"mime_type\":\"image/jpeg\",\"data\":\"" + frameB64 + "\"}}";
     msg += "]}]}}";
+    frameB64 = String();  // Release the encoded copy before sending
 
     bool sent = ws.sendTXT(msg);
     if (!sent) {
         Serial.println("Failed to send frame to Gemini");
+    } else {
+        linkMonitor.onRequestSent(millis());
+        framesSent++;
     }
+}
 
+const VisionAssistant::CachedFrame* VisionAssistant::captureFrame() {
+    // Capture frame
+    camera_fb_t *fb = esp_camera_fb_get();
+    if (!fb) {
+        Serial.println("Camera capture failed");
+        return nullptr;
+    }
+
+    // Check frame size
+    if (fb->len > MAX_FRAME_SIZE) {
+        Serial.printf("Frame too large (%zu bytes), skipping\n", fb->len);
+        esp_camera_fb_return(fb);
+        return nullptr;
+    }
+
+    // Copy into the oldest cache slot so the camera buffer can go straight back to the driver
+    int slot = (frameCacheNewest + 1) % FRAME_CACHE_SIZE;
+    CachedFrame& cached = frameCache[slot];
+    if (!cached.data) {
+        esp_camera_fb_return(fb);
+        Serial.println("Frame cache not allocated");
+        return nullptr;
+    }
+    memcpy(cached.data, fb->buf, fb->len);
+    cached.length = fb->len;
+    cached.timestamp = millis();
+    frameCacheNewest = slot;
     esp_camera_fb_return(fb);
+
+    Serial.printf("Frame captured: %zu bytes\n", cached.length);
+    return &cached;
+}
+
+const VisionAssistant::CachedFrame* VisionAssistant::getLatestFrame() {
+    // Reuse the most recent frame while it is still fresh, otherwise grab a new one
+    if (frameCacheNewest >= 0) {
+        const CachedFrame& latest = frameCache[frameCacheNewest];
+        unsigned long age = millis() - latest.timestamp;
+        if (age <= FRAME_CACHE_MAX_AGE) {
+            Serial.printf("Using cached frame (%lu ms old)\n", age);
+            return &latest;
+        }
+    }
+    return captureFrame();
+}
+
+bool VisionAssistant::sendAudioCommand(uint8_t* pcm, size_t length) {
+    if (audioUpload.pcm) {
+        Serial.println("Audio command already streaming - dropping new clip");
+        free(pcm);
+        return false;
+    }
+    if (!setupComplete) {
+        Serial.println("WebSocket not ready - cannot stream audio command");
+        free(pcm);
+        return false;
+    }
+    if (!pcm || length == 0) {
+        free(pcm);
+        return false;
+    }
+
+    unsigned long startTime = millis();
+
+    // One encode buffer for all chunks, prefixed once
+    const size_t prefixLength = sizeof(AUDIO_CHUNK_PREFIX) - 1;
+    size_t maxEncoded = ((AUDIO_INPUT_CHUNK_BYTES + 2) / 3) * 4;
+    size_t messageCapacity = prefixLength + maxEncoded + sizeof(AUDIO_CHUNK_SUFFIX);
+    char* message = (char*)ps_malloc(messageCapacity);
+    if (!message) {
+        Serial.println("Failed to allocate audio command message buffer");
+        free(pcm);
+        return false;
+    }
+    memcpy(message, AUDIO_CHUNK_PREFIX, prefixLength);
+
+    // Manual activity detection: the whole clip (plus the current view) is one user turn
+    if (!ws.sendTXT("{\"realtimeInput\":{\"activityStart\":{}}}")) {
+        Serial.println("Failed to send activityStart to Gemini");
+        free(message);
+        free(pcm);
+        return false;
+    }
+
+    const CachedFrame* frame = getLatestFrame();
+    if (frame) {
+        String videoMsg = "{\"realtimeInput\":{\"video\":{\"mimeType\":\"image/jpeg\",\"data\":\"" + base64_encode(frame->data, frame->length) + "\"}}}";
+        if (!ws.sendTXT(videoMsg)) {
+            Serial.println("Failed to send frame with audio command");
+        } else {
+            framesSent++;
+        }
+    }
+
+    // The PCM goes out one chunk per run() pass, so the loop keeps serving the button, tool
+    // calls and the socket while a long clip uploads
+    audioUpload.pcm = pcm;
+    audioUpload.length = length;
+    audioUpload.offset = 0;
+    audioUpload.chunks = 0;
+    audioUpload.message = message;
+    audioUpload.messageCapacity = messageCapacity;
+    audioUpload.startTime = startTime;
+    return true;
+}
+
+bool VisionAssistant::isStreamingAudioCommand() const {
+    return audioUpload.pcm != nullptr;
+}
+
+void VisionAssistant::continueAudioCommand() {
+    if (!audioUpload.pcm) {
+        return;
+    }
+    if (!ws.isConnected()) {
+        Serial.println("Gemini link lost - abandoning audio command upload");
+        endAudioCommand();
+        return;
+    }
+
+    bool ok = true;
+    if (audioUpload.offset < audioUpload.length) {
+        const size_t prefixLength = sizeof(AUDIO_CHUNK_PREFIX) - 1;
+        const size_t chunkBytes = AUDIO_INPUT_CHUNK_BYTES;
+        size_t chunkLength = min(chunkBytes, audioUpload.length - audioUpload.offset);
+        char* data = audioUpload.message + prefixLength;
+        size_t encoded = base64_encode_to_buffer(audioUpload.pcm + audioUpload.offset, chunkLength, data,
+                                                 audioUpload.messageCapacity - prefixLength);
+        strcpy(data + encoded, AUDIO_CHUNK_SUFFIX);
+        ok = ws.sendTXT(audioUpload.message, prefixLength + encoded + sizeof(AUDIO_CHUNK_SUFFIX) - 1);
+        audioUpload.offset += chunkLength;
+        audioUpload.chunks++;
+        if (ok && audioUpload.offset < audioUpload.length) {
+            return;  // More chunks on the next pass
+        }
+    }
+
+    if (!ws.sendTXT("{\"realtimeInput\":{\"activityEnd\":{}}}")) {
+        ok = false;
+    }
+    if (ok) {
+        linkMonitor.onRequestSent(millis());
+        Serial.printf("🎙️ Streamed audio command: %u bytes in %u chunks (%lu ms)\n", audioUpload.length,
+                      audioUpload.chunks, millis() - audioUpload.startTime);
+    } else {
+        Serial.println("Failed to stream audio command to Gemini");
+    }
+    endAudioCommand();
+}
+
+void VisionAssistant::endAudioCommand() {
+    free(audioUpload.message);
+    free(audioUpload.pcm);
+    audioUpload = AudioUpload();
+    // The command carried the current view - restart the periodic frame cadence from here
+    lastFrameTime = millis();
+}
+
+void VisionAssistant::beginCommandLatency(CommandPath path, unsigned long startTime) {
+    pendingCommandPath = path;
+    pendingCommandStart = startTime;
+}
+
+void VisionAssistant::recordReconnectResponse() {
+    if (!awaitingFirstResponse) {
+        return;
+    }
+    awaitingFirstResponse = false;
+
+    unsigned long now = millis();
+    Serial.printf("🔁 Reconnect (%s): offline %lu ms, setup %lu ms, first response %lu ms after connect\n",
+                  resumptionAttempted ? "resumed" : "new session",
+                  connectedAt - disconnectedAt, setupCompletedAt - connectedAt, now - connectedAt);
+}
+
+void VisionAssistant::recordCommandResponse() {
+    if (pendingCommandStart == 0) {
+        return;
+    }
+
+    unsigned long latency = millis() - pendingCommandStart;
+    LatencyStats& stats = commandLatency[(int)pendingCommandPath];
+    stats.count++;
+    stats.totalMs += latency;
+    if (latency > stats.maxMs) {
+        stats.maxMs = latency;
+    }
+    pendingCommandStart = 0;
+
+    const LatencyStats& text = commandLatency[(int)CommandPath::TEXT];
+    const LatencyStats& audio = commandLatency[(int)CommandPath::AUDIO];
+    Serial.printf("⏱️ Command latency (%s): %lu ms | text avg %lu ms (n=%u), audio avg %lu ms (n=%u)\n",
+                  pendingCommandPath == CommandPath::AUDIO ? "audio" : "text", latency,
+                  text.count ? text.totalMs / text.count : 0, text.count,
+                  audio.count ? audio.totalMs / audio.count : 0, audio.count);
 }
 
 bool VisionAssistant::isSetupComplete() const {
     return setupComplete;
 }
 
+bool VisionAssistant::isLinkIdle() const {
+    // Connecting and setup stay on the short poll so the handshake isn't stretched out
+    return setupComplete && !isStreamingAudioCommand() && !linkMonitor.isExpectingTraffic(millis());
+}
+
 bool VisionAssistant::connectToWiFi() {
     WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
     Serial.print("Connecting to WiFi");
@@ -180,9 +528,13 @@ bool VisionAssistant::initializeCamera() {
 
 bool VisionAssistant::initializeWebSocket() {
     Serial.println("Initializing WebSocket...");
-    ws.beginSSL(WS_HOST, WS_PORT, WS_PATH.c_str());
+    if (WS_USE_SSL) {
+        ws.beginSSL(WS_HOST, WS_PORT, WS_PATH.c_str());
+    } else {
+        ws.begin(WS_HOST, WS_PORT, WS_PATH.c_str());
+    }
     ws.onEvent(webSocketEvent);
-    ws.setReconnectInterval(5000);
+    applyReconnectBackoff(millis());
     return true;
 }
 
@@ -202,89 +554,159 @@ void VisionAssistant::sendSetupMessage() {
     // NOTE: This should be set to low only when testing.
     // const char* mediaResolution = "MEDIA_RESOLUTION_HIGH";
     const char* mediaResolution = "MEDIA_RESOLUTION_LOW";
-    // String setupMsg = "{\"setup\":{\"model\":\"models/gemini-2.0-flash-live-001\",\"generationConfig\":{\"responseModalities\":[\"TEXT\"], \"mediaResolution\":\"" + String(mediaResolution) + "\"},\"tools\":[" + String(TOOLS_JSON) + "],\"systemInstruction\":{\"parts\":[{\"text\":\"" + String(SYSTEM_PROMPT) + "\"}]}}}";
-    String setupMsg = "{\"setup\":{\"model\":\"models/gemini-2.5-flash-live-preview\",\"generationConfig\":{\"responseModalities\":[\"TEXT\"], \"mediaResolution\":\"" + String(mediaResolution) + "\"},\"tools\":[" + String(TOOLS_JSON) + "],\"systemInstruction\":{\"parts\":[{\"text\":\"" + String(SYSTEM_PROMPT) + "\"}]}}}";
-    ws.sendTXT(setupMsg);
-    Serial.println("Sent setup message");
-}
-
-void VisionAssistant::sendToolResponse(const char *functionId, const char *functionName, const char *result) {
-    // Create tool response according to BidiGenerateContentToolResponse format
-    String toolResponseMsg = "{\"toolResponse\":{\"functionResponses\":[{";
-
-    if (functionId) {
-        toolResponseMsg += "\"id\":\"" + String(functionId) + "\",";
+    // Native audio mode asks for spoken replies; the tools stay declared for alerts and logging
+    const char* responseModality = nativeAudioEnabled ? "AUDIO" : "TEXT";
+    // Voice commands are sent as complete clips, so we mark the turn boundaries ourselves
+    const char* realtimeInputConfig = audioCommandsEnabled ? "\"realtimeInputConfig\":{\"automaticActivityDetection\":{\"disabled\":true}}," : "";
+
+    // Resume the previous session if we have a handle (an empty object just enables handle updates)
+    resumptionAttempted = resumptionHandle[0] != '\0';
+
+    // Only the head depends on runtime settings; tools and prompt are prebuilt in flash. The
+    // resumption handle is streamed on its own so the formatted parts stay a fixed, small size.
+    char head[288];
+    int headLength = snprintf(head, sizeof(head),
+             "{\"setup\":{\"model\":\"models/gemini-2.5-flash-live-preview\",\"generationConfig\":{\"responseModalities\":[\"%s\"],\"mediaResolution\":\"%s\"},%s"
+             "\"sessionResumption\":{",
+             responseModality, mediaResolution, realtimeInputConfig);
+    char tail[128];
+    int tailLength = snprintf(tail, sizeof(tail),
+             "},\"contextWindowCompression\":{\"triggerTokens\":%ld,\"slidingWindow\":{\"targetTokens\":%ld}},",
+             GEMINI_CONTEXT_TRIGGER_TOKENS, GEMINI_CONTEXT_TARGET_TOKENS);
+    if (headLength < 0 || headLength >= (int)sizeof(head) || tailLength < 0 || tailLength >= (int)sizeof(tail)) {
+        Serial.println("❌ Setup message head does not fit its buffer - not sending setup");
+        return;
     }
 
-    toolResponseMsg += "\"name\":\"" + String(functionName) + "\",";
-    toolResponseMsg += "\"response\":{\"output\":\"" + String(result) + "\"}";
-    toolResponseMsg += "}]}}";
-
-    bool sent = ws.sendTXT(toolResponseMsg);
-    if (sent) {
-        Serial.printf("Sent tool response for %s\n", functionName);
+    ws.beginText();
+    ws.writeText(head, headLength);
+    if (resumptionAttempted) {
+        ws.writeText("\"handle\":\"");
+        ws.writeText(resumptionHandle, strlen(resumptionHandle));
+        ws.writeText("\"");
+    }
+    ws.writeText(tail, tailLength);
+    ws.writeText(SETUP_TOOLS_AND_PROMPT, sizeof(SETUP_TOOLS_AND_PROMPT) - 1);
+    if (nativeAudioEnabled) {
+        ws.writeText(SETUP_NATIVE_AUDIO_PART, sizeof(SETUP_NATIVE_AUDIO_PART) - 1);
+    }
+    ws.writeText("]}}}");
+    if (ws.endText()) {
+        Serial.printf("Sent setup message (response modality: %s, %s)\n", responseModality,
+                      resumptionAttempted ? "resuming session" : "new session");
     } else {
-        Serial.printf("Failed to send tool response for %s\n", functionName);
+        Serial.println("Failed to send setup message");
+    }
+}
+
+void VisionAssistant::sendToolResponses() {
+    // Send every toolCall batch whose calls have all finished
+    String toolResponseMsg;
+    while (toolRegistry.takeResponse(toolResponseMsg)) {
+        if (!ws.isConnected()) {
+            continue;  // The calls belonged to a connection that is gone
+        }
+        bool sent = ws.sendTXT(toolResponseMsg);
+        if (sent) {
+            Serial.printf("Sent tool response (%u bytes)\n", toolResponseMsg.length());
+        } else {
+            Serial.println("Failed to send tool response");
+        }
     }
 }
 
 void VisionAssistant::handleWebSocketMessage(const JsonDocument &doc) {
-    // Serial.println("Received WebSocket message:");
-    // serializeJsonPretty(doc, Serial);
-    // Serial.println();
     // Check for setupComplete signal
-    if (doc.containsKey("setupComplete")) {
+    if (!doc["setupComplete"].isNull()) {
         Serial.println("Setup complete - ready to send frames");
         setupComplete = true;
         systemPromptSent = true;
+        setupCompletedAt = millis();
+        linkMonitor.onSessionReady();
+        return;
+    }
+
+    // Keep the newest resumption handle so a reconnect continues this conversation
+    JsonObjectConst resumptionUpdate = doc["sessionResumptionUpdate"];
+    if (!resumptionUpdate.isNull()) {
+        const char *newHandle = resumptionUpdate["newHandle"];
+        if (resumptionUpdate["resumable"].as<bool>() && newHandle && strlen(newHandle) < RESUMPTION_HANDLE_SIZE &&
+            !strpbrk(newHandle, "\"\\")) {
+            strcpy(resumptionHandle, newHandle);
+        }
+        return;
+    }
+
+    // The server is about to close the connection - reconnect now and resume with the handle
+    JsonObjectConst goAway = doc["goAway"];
+    if (!goAway.isNull()) {
+        const char *timeLeft = goAway["timeLeft"];
+        Serial.printf("Server sent goAway (time left: %s) - reconnecting to resume session\n", timeLeft ? timeLeft : "unknown");
+        // A planned close says nothing about the link, so it must not grow the backoff
+        goAwayReconnect = true;
+        ws.disconnect();
         return;
     }
 
-    // serializeJsonPretty(doc, Serial);
-    // Serial.println();
     // Handle toolCall at top level
-    if (doc.containsKey("toolCall")) {
-        JsonObjectConst toolCall = doc["toolCall"];
-        if (toolCall.containsKey("functionCalls")) {
-            Serial.println("Function calls detected");
-            JsonArrayConst functionCalls = toolCall["functionCalls"];
-            for (JsonObjectConst funcCall : functionCalls) {
-                const char *toolName = funcCall["name"];
-                const char *toolId = funcCall["id"];
-                Serial.printf("Tool call detected: %s (ID: %s)\n", toolName, toolId ? toolId : "N/A");
-                if (toolName && strcmp(toolName, "systemAction") == 0) {
-                    // For systemAction, we need to pass the entire args object as a JSON string
-                    JsonObjectConst args = funcCall["args"];
-                    String argsJson;
-                    serializeJson(args, argsJson);
-                    
-                    if (toolCallback) {
-                        Serial.printf("Tool call: %s(%s)\n", toolName, argsJson.c_str());
-                        toolCallback(toolName, argsJson);
-
-                        // Send tool response back to Gemini
-                        sendToolResponse(toolId, toolName, "System action processed successfully");
-                    }
-                }
-            }
-        } else {
+    JsonObjectConst toolCall = doc["toolCall"];
+    if (!toolCall.isNull()) {
+        recordReconnectResponse();
+        recordCommandResponse();
+        JsonArrayConst functionCalls = toolCall["functionCalls"];
+        if (functionCalls.isNull()) {
             Serial.println("No function calls found in toolCall");
+            return;
         }
+
+        // Every call is started before any result is awaited; the batch is answered once all finish
+        Serial.println("Function calls detected");
+        toolRegistry.dispatch(functionCalls);
+        sendToolResponses();
+        return;
+    }
+
+    // The server no longer wants these results (e.g. the user interrupted the turn)
+    JsonArrayConst cancelledIds = doc["toolCallCancellation"]["ids"];
+    if (!cancelledIds.isNull()) {
+        toolRegistry.cancel(cancelledIds);
         return;
     }
 
-    // Handle model text response
-    if (doc.containsKey("serverContent") && doc["serverContent"].containsKey("modelTurn")) {
-        JsonObjectConst modelTurn = doc["serverContent"]["modelTurn"];
-        if (modelTurn["parts"][0].containsKey("text")) {
-            const char *text = modelTurn["parts"][0]["text"];
-            if (text && responseCallback) {
-                String response = String(text);
-                Serial.printf("Gemini: %s\n", text);
-                responseCallback(response);
+    // Handle model text / audio response
+    JsonObjectConst serverContent = doc["serverContent"];
+    if (!serverContent.isNull()) {
+        JsonArrayConst parts = serverContent["modelTurn"]["parts"];
+        if (!parts.isNull()) {
+            recordReconnectResponse();
+            recordCommandResponse();
+            for (JsonObjectConst part : parts) {
+                const char *text = part["text"];
+                JsonObjectConst inlineData = part["inlineData"];
+                if (text) {
+                    if (responseCallback) {
+                        String response = String(text);
+                        Serial.printf("Gemini: %s\n", text);
+                        responseCallback(response);
+                    }
+                } else if (!inlineData.isNull()) {
+                    // Native audio chunk: {"mimeType":"audio/pcm;rate=24000","data":"<base64>"}
+                    const char *mimeType = inlineData["mimeType"];
+                    const char *data = inlineData["data"];
+                    if (mimeType && data && strncmp(mimeType, "audio/pcm", 9) == 0) {
+                        handleAudioChunk(data);
+                    }
+                } else {
+                    Serial.println("No text or audio in modelTurn part");
+                }
+            }
+        }
+
+        // End of the spoken turn (or the server cut it short) - let the player drain and stop
+        if (serverContent["turnComplete"].as<bool>() || serverContent["interrupted"].as<bool>()) {
+            if (nativeAudioEnabled && audioCallback) {
+                audioCallback(nullptr, 0, true);
             }
-        } else {
-            Serial.println("No text in modelTurn response");
         }
     } else {
         // TODO: DETECT TURNS
@@ -294,6 +716,84 @@ void VisionAssistant::handleWebSocketMessage(const JsonDocument &doc) {
     }
 }
 
+void VisionAssistant::buildMessageFilter() {
+    // Only the fields handleWebSocketMessage() reads are kept; everything else is skipped while parsing
+    messageFilter["setupComplete"] = true;
+    messageFilter["sessionResumptionUpdate"]["newHandle"] = true;
+    messageFilter["sessionResumptionUpdate"]["resumable"] = true;
+    messageFilter["goAway"]["timeLeft"] = true;
+
+    JsonObject functionCall = messageFilter["toolCall"]["functionCalls"].add<JsonObject>();
+    functionCall["name"] = true;
+    functionCall["id"] = true;
+    functionCall["args"] = true;
+    messageFilter["toolCallCancellation"]["ids"] = true;
+
+    JsonObject serverContent = messageFilter["serverContent"].to<JsonObject>();
+    JsonObject part = serverContent["modelTurn"]["parts"].add<JsonObject>();
+    part["text"] = true;
+    part["inlineData"]["mimeType"] = true;
+    part["inlineData"]["data"] = true;
+    serverContent["turnComplete"] = true;
+    serverContent["interrupted"] = true;
+}
+
+void VisionAssistant::parseAndHandleMessage(uint8_t *payload, size_t length) {
+    unsigned long startMicros = micros();
+
+    // Reuse the same document (its memory lives in PSRAM via messageAllocator)
+    messageDoc.clear();
+    DeserializationError error = deserializeJson(messageDoc, payload, length, DeserializationOption::Filter(messageFilter));
+
+    unsigned long parseMicros = micros() - startMicros;
+    size_t docBytes = messageAllocator.getUsed();
+
+    parseStats.count++;
+    parseStats.totalMicros += parseMicros;
+    if (parseMicros > parseStats.maxMicros) {
+        parseStats.maxMicros = parseMicros;
+    }
+    if (docBytes > parseStats.maxDocBytes) {
+        parseStats.maxDocBytes = docBytes;
+    }
+    if (parseStats.count % 50 == 0) {
+        Serial.printf("⏱️ WS parse: avg %lu us, max %lu us, max doc %u bytes over %u messages\n",
+                      parseStats.totalMicros / parseStats.count, parseStats.maxMicros,
+                      parseStats.maxDocBytes, parseStats.count);
+    }
+
+    if (error) {
+        Serial.print("deserializeJson() failed: ");
+        Serial.println(error.c_str());
+        // Print the start of the raw payload to see what we received
+        Serial.print("Raw payload: ");
+        Serial.write(payload, min(length, (size_t)256));
+        Serial.println();
+        return;
+    }
+
+    handleWebSocketMessage(messageDoc);
+}
+
+void VisionAssistant::handleAudioChunk(const char *base64Data) {
+    if (!nativeAudioEnabled || !audioCallback || !audioDecodeBuffer) {
+        return;
+    }
+
+    // Decode in slices that are a multiple of 4 base64 characters so each slice fits the buffer
+    size_t encodedLength = strlen(base64Data);
+    const size_t sliceLength = (AUDIO_DECODE_BUFFER_SIZE / 3) * 4;
+    for (size_t offset = 0; offset < encodedLength; offset += sliceLength) {
+        size_t chunkLength = min(sliceLength, encodedLength - offset);
+        size_t decoded = base64_decode_to_buffer(base64Data + offset, chunkLength, audioDecodeBuffer, AUDIO_DECODE_BUFFER_SIZE);
+        if (decoded == 0) {
+            Serial.println("Failed to decode audio chunk");
+            return;
+        }
+        audioCallback(audioDecodeBuffer, decoded, false);
+    }
+}
+
 void VisionAssistant::webSocketEvent(WStype_t type, uint8_t *payload, size_t length) {
     if (!instance)
         return;
@@ -301,12 +801,36 @@ void VisionAssistant::webSocketEvent(WStype_t type, uint8_t *payload, size_t len
     switch (type) {
         case WStype_DISCONNECTED:
             Serial.println("[WSc] Disconnected!");
+            if (instance->resumptionAttempted && !instance->setupComplete) {
+                // The resume was rejected before setup finished - start a fresh session next time
+                Serial.println("Session resumption failed - clearing handle");
+                instance->resumptionHandle[0] = '\0';
+                instance->resumptionAttempted = false;
+            }
+            if (instance->setupComplete) {
+                instance->disconnectedAt = millis();
+            }
+            instance->linkMonitor.onDisconnected();
+            instance->toolRegistry.clear();
+            if (instance->goAwayReconnect) {
+                instance->goAwayReconnect = false;
+                instance->reconnectSoon(millis());
+            } else {
+                instance->applyReconnectBackoff(millis());
+            }
             instance->setupComplete = false;
             instance->systemPromptSent = false;
+            // Make sure a half-played audio turn doesn't keep the speaker waiting
+            if (instance->nativeAudioEnabled && instance->audioCallback) {
+                instance->audioCallback(nullptr, 0, true);
+            }
             break;
 
         case WStype_CONNECTED: {
             Serial.printf("[WSc] Connected to url: %s\n", (char *)payload);
+            instance->connectedAt = millis();
+            instance->linkMonitor.onConnected(instance->connectedAt);
+            instance->awaitingFirstResponse = instance->disconnectedAt != 0;
             instance->setupComplete = false;
             instance->systemPromptSent = false;
             instance->sendSetupMessage();
@@ -314,38 +838,28 @@ void VisionAssistant::webSocketEvent(WStype_t type, uint8_t *payload, size_t len
         }
 
         case WStype_TEXT: {
-            Serial.printf("[WSc] Received text: %s\n", (char*)payload);
-            JsonDocument doc;
-            auto error = deserializeJson(doc, payload, length);
-            if (error) {
-                Serial.print("deserializeJson() failed: ");
-                Serial.println(error.c_str());
-                // Print the raw payload to see what we received
-                Serial.print("Raw payload: ");
-                Serial.write(payload, length);
-                Serial.println();
-                return;
+            instance->linkMonitor.onMessageReceived(millis());
+            instance->receivedStats.record(length);
+            if (instance->nativeAudioEnabled || length > 512) {
+                // Audio turns and large messages would stall the loop on the serial port - log the size only
+                Serial.printf("[WSc] Received text: %zu bytes\n", length);
+            } else {
+                Serial.printf("[WSc] Received text: %s\n", (char*)payload);
             }
-
-            instance->handleWebSocketMessage(doc);
+            instance->parseAndHandleMessage(payload, length);
             break;
         }
 
         case WStype_BIN: {
+            instance->linkMonitor.onMessageReceived(millis());
+            instance->receivedStats.record(length);
             Serial.printf("[WSc] Received binary data: %zu bytes\n", length);
-            JsonDocument doc;
-            auto error = deserializeJson(doc, payload, length);
-            if (error) {
-                Serial.print("deserializeJson() failed: ");
-                Serial.println(error.c_str());
-                // Print the raw payload to see what we received
-                Serial.print("Raw payload: ");
-                Serial.write(payload, length);
-                Serial.println();
-                return;
-            }
+            instance->parseAndHandleMessage(payload, length);
+            break;
+        }
 
-            instance->handleWebSocketMessage(doc);
+        case WStype_PONG: {
+            instance->linkMonitor.onPong(millis());
             break;
         }
 
@@ -381,7 +895,8 @@ void VisionAssistant::onGeminiResponse(const String &response) {
 
 void VisionAssistant::queueUserCommand(const String& command) {
     if (queueSize >= MAX_QUEUED_COMMANDS) {
-        Serial.println("Command queue full - dropping oldest command");
+        droppedCommands++;
+        Serial.printf("Command queue full - dropping oldest command (%u dropped so far)\n", droppedCommands);
         // Remove oldest command (FIFO)
         queueHead = (queueHead + 1) % MAX_QUEUED_COMMANDS;
         queueSize--;
@@ -406,10 +921,12 @@ String VisionAssistant::getNextQueuedCommand() {
     }
     
     String command = commandQueue[queueHead].message;
+    unsigned long waited = millis() - commandQueue[queueHead].timestamp;
     queueHead = (queueHead + 1) % MAX_QUEUED_COMMANDS;
     queueSize--;
+    recordQueueWait(waited);
     
-    Serial.printf("Dequeued command: %s (remaining: %d)\n", command.c_str(), queueSize);
+    Serial.printf("Dequeued command: %s (remaining: %d, waited %lu ms)\n", command.c_str(), queueSize, waited);
     return command;
 }
 
@@ -420,9 +937,34 @@ void VisionAssistant::sendTextMessage(const String& message) {
         return;
     }
 
-    // Queue the user command to be sent with the next frame
-    queueUserCommand(message);
-    Serial.printf("Queued user command for next frame: %s\n", message.c_str());
+    // Send right away with the most recent view instead of waiting for the next frame tick
+    const CachedFrame* frame = getLatestFrame();
+    if (!frame) {
+        Serial.println("No frame available - queueing user command for next frame.");
+        queueUserCommand(message);
+        return;
+    }
+
+    Serial.printf("Sending user command immediately: %s\n", message.c_str());
+    recordQueueWait(0);
+    sendClientTurn(message, *frame);
+
+    // The command carried the current view - restart the periodic frame cadence from here
+    lastFrameTime = millis();
+}
+
+void VisionAssistant::recordQueueWait(unsigned long waitMs) {
+    queueWaitStats.count++;
+    queueWaitStats.totalMs += waitMs;
+    if (waitMs > queueWaitStats.maxMs) {
+        queueWaitStats.maxMs = waitMs;
+    }
+
+    if (queueWaitStats.count % 10 == 0) {
+        Serial.printf("⏱️ Command queue wait: avg %lu ms, max %lu ms over %u commands (%u dropped)\n",
+                      queueWaitStats.totalMs / queueWaitStats.count, queueWaitStats.maxMs,
+                      queueWaitStats.count, droppedCommands);
+    }
 }
 
 float VisionAssistant::calculateDistance(float lat1, float lon1, float lat2, float lon2) {
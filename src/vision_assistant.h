@@ -2,10 +2,13 @@
 #define VISION_ASSISTANT_H
 
 #include <Arduino.h>
-#include <WebSocketsClient.h>
 #include <ArduinoJson.h>
 #include "esp_camera.h"
+#include "gemini_socket.h"
 #include "gps_module.h"
+#include "link_monitor.h"
+#include "psram_allocator.h"
+#include "tool_registry.h"
 #include "TTS.h"
 
 // Forward declarations
@@ -13,20 +16,70 @@ class VisionAssistant;
 
 // Callback function types
 typedef void (*ResponseCallback)(const String& response);
-typedef void (*ToolCallback)(const String& toolName, const String& message);
+typedef void (*AudioCallback)(const uint8_t* pcm, size_t length, bool turnComplete);
+
+// How a voice command reached Gemini (used to compare end-to-end latency)
+enum class CommandPath {
+    TEXT,   // Deepgram STT transcript sent with the next frame
+    AUDIO   // Raw PCM streamed as realtimeInput
+};
 
 class VisionAssistant {
 private:
     static VisionAssistant* instance;
     
-    WebSocketsClient ws;
+    GeminiSocket ws;
     GPSModule gps;
     bool setupComplete;
     bool systemPromptSent;
     unsigned long lastFrameTime;
     unsigned long lastGPSUpdate;
     ResponseCallback responseCallback;
-    ToolCallback toolCallback;
+    AudioCallback audioCallback;
+    
+    // Function calls from Gemini, answered with one toolResponse per toolCall batch
+    ToolRegistry toolRegistry;
+    
+    // Native audio responses (PCM decoded from base64 inlineData parts)
+    bool nativeAudioEnabled;
+    uint8_t* audioDecodeBuffer;
+    static const size_t AUDIO_DECODE_BUFFER_SIZE = 12288;
+    
+    // Voice commands streamed as 16 kHz PCM realtimeInput (skips the Deepgram STT round trip)
+    bool audioCommandsEnabled;
+    static const size_t AUDIO_INPUT_CHUNK_BYTES = 16000; // 0.5 s of 16 kHz 16-bit audio per message
+    // The clip being streamed (owned until the last chunk is sent); pcm is null when idle
+    struct AudioUpload {
+        uint8_t* pcm = nullptr;
+        size_t length = 0;
+        size_t offset = 0;
+        size_t chunks = 0;
+        char* message = nullptr;        // Reused encode buffer, prefix already in place
+        size_t messageCapacity = 0;
+        unsigned long startTime = 0;
+    };
+    AudioUpload audioUpload;
+    
+    // Command-to-response latency per path
+    struct LatencyStats {
+        uint32_t count;
+        unsigned long totalMs;
+        unsigned long maxMs;
+    };
+    LatencyStats commandLatency[2] = {};
+    CommandPath pendingCommandPath;
+    unsigned long pendingCommandStart;
+    
+    // Small timestamped cache of the latest captured JPEG frames
+    struct CachedFrame {
+        uint8_t* data;
+        size_t length;
+        unsigned long timestamp;
+    };
+    static const int FRAME_CACHE_SIZE = 2;
+    static const unsigned long FRAME_CACHE_MAX_AGE = 3000; // Older frames are recaptured for commands
+    CachedFrame frameCache[FRAME_CACHE_SIZE] = {};
+    int frameCacheNewest;
     
     // Queue system for user commands
     struct QueuedCommand {
@@ -38,6 +91,46 @@ private:
     int queueHead;
     int queueTail;
     int queueSize;
+    uint32_t droppedCommands;
+    LatencyStats queueWaitStats = {};
+    
+    // Incoming message parsing: one reusable document plus a filter for the fields we use. The
+    // document has its own allocator so its size is counted exactly, not inferred from the
+    // shared PSRAM heap (no budget - it only keeps the count).
+    BoundedSpiRamAllocator messageAllocator;
+    JsonDocument messageDoc;
+    JsonDocument messageFilter;
+    struct ParseStats {
+        uint32_t count;
+        unsigned long totalMicros;
+        unsigned long maxMicros;
+        size_t maxDocBytes;
+    };
+    ParseStats parseStats = {};
+    
+    // Session resumption: the latest handle from sessionResumptionUpdate is sent on reconnect
+    static const size_t RESUMPTION_HANDLE_SIZE = 256;
+    char resumptionHandle[RESUMPTION_HANDLE_SIZE];
+    bool resumptionAttempted;       // The current connection's setup carried a handle
+    unsigned long disconnectedAt;   // For reconnect-to-first-response timing
+    unsigned long connectedAt;
+    unsigned long setupCompletedAt;
+    bool awaitingFirstResponse;
+    
+    // Connection health: RTT probes, stall detection and reconnect backoff
+    LinkMonitor linkMonitor;
+    unsigned long reconnectDelay;
+    unsigned long reconnectWindowStart;
+    bool goAwayReconnect;           // The server asked us to reconnect - skip the backoff once
+    static const unsigned long GOAWAY_RECONNECT_DELAY = 250;
+    unsigned long lastLinkReport;
+    static const unsigned long LINK_REPORT_INTERVAL = 60000;
+    
+    // Traffic metrics (frames/s and message sizes per reporting window)
+    MessageStats receivedStats = {};
+    uint32_t framesSent;
+    unsigned long trafficWindowStart;
+    static const unsigned long TRAFFIC_REPORT_INTERVAL = 30000;
     
     // Frame processing constants
     static const unsigned long FRAME_INTERVAL = 2000; // 2 seconds between frames (faster for user commands)
@@ -54,7 +147,19 @@ public:
     
     // Callback management
     void setResponseCallback(ResponseCallback callback);
-    void setToolCallback(ToolCallback callback);
+    
+    // Tools: handlers receive the call's args and report back with completeToolCall()
+    bool registerTool(const char* name, ToolHandler handler);
+    void completeToolCall(ToolCallId callId, const String& result, bool isError = false);
+    void setAudioCallback(AudioCallback callback);
+    
+    // Native audio mode (must be chosen before initialize() - it is part of the setup message)
+    void setNativeAudioEnabled(bool enabled);
+    bool isNativeAudioEnabled() const;
+    
+    // Audio command mode (must be chosen before initialize() - it is part of the setup message)
+    void setAudioCommandsEnabled(bool enabled);
+    bool isAudioCommandsEnabled() const;
     
     // Frame processing
     void processFrame();
@@ -63,9 +168,24 @@ public:
     // GPS access
     GPSData getCurrentGPSData() const;
     String getGPSString() const;
+    void notifyOnGpsData(EventGroupHandle_t group, EventBits_t bits) { gps.notifyOnData(group, bits); }
 
-    // Send a text message to Gemini (queues it to be sent with next frame)
+    // Send a text message to Gemini immediately with the latest frame (queued until setup completes)
     void sendTextMessage(const String& message);
+    
+    // Stream a recorded voice command (16 kHz 16-bit PCM) together with the current frame.
+    // Takes ownership of pcm (freed once sent or on failure); the chunks go out from run().
+    bool sendAudioCommand(uint8_t* pcm, size_t length);
+    bool isStreamingAudioCommand() const;
+
+    // Session up with nothing in flight: the WebSocket can be polled less often
+    bool isLinkIdle() const;
+    
+    // Link health (RTT percentiles, reconnects, time since the server was last heard from)
+    LinkQuality getLinkQuality() const;
+    
+    // Start timing a voice command; the next model response closes the measurement
+    void beginCommandLatency(CommandPath path, unsigned long startTime);
 
     // GPS distance calculation
     float calculateDistance(float lat1, float lon1, float lat2, float lon2);
@@ -88,8 +208,23 @@ private:
     bool initializeGPS();
     bool initializeWebSocket();
     void sendSetupMessage();
-    void sendToolResponse(const char* functionId, const char* functionName, const char* result);
+    void sendToolResponses();
+    void buildMessageFilter();
+    void parseAndHandleMessage(uint8_t* payload, size_t length);
     void handleWebSocketMessage(const JsonDocument& doc);
+    void handleAudioChunk(const char* base64Data);
+    const CachedFrame* captureFrame();
+    const CachedFrame* getLatestFrame();
+    void sendClientTurn(const String& userCommand, const CachedFrame& frame);
+    void continueAudioCommand();
+    void endAudioCommand();
+    void recordQueueWait(unsigned long waitMs);
+    void recordCommandResponse();
+    void recordReconnectResponse();
+    void monitorLink(unsigned long now);
+    void applyReconnectBackoff(unsigned long now);
+    void reconnectSoon(unsigned long now);
+    void reportTraffic(unsigned long now);
 };
 
 #endif
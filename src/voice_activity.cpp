@@ -0,0 +1,62 @@
+#include "voice_activity.h"
+
+VoiceActivityDetector::VoiceActivityDetector() {
+    reset();
+}
+
+void VoiceActivityDetector::reset() {
+    frameEnergy = 0;
+    frameFill = 0;
+    sampleCount = 0;
+    noiseFloor = 0;
+    lastEnergy = 0;
+    loudFrames = 0;
+    quietFrames = 0;
+    speech = false;
+    speechStart = 0;
+    speechEnd = 0;
+    segmentCount = 0;
+}
+
+void VoiceActivityDetector::endFrame() {
+    uint32_t energy = (uint32_t)(frameEnergy / FRAME_SAMPLES);
+    frameEnergy = 0;
+    frameFill = 0;
+    lastEnergy = energy;
+
+    if (noiseFloor == 0) {
+        noiseFloor = energy ? energy : 1;
+    }
+
+    uint64_t threshold = (uint64_t)noiseFloor * ON_RATIO;
+    bool loud = energy > threshold && energy > MIN_SPEECH_ENERGY;
+
+    if (loud) {
+        loudFrames++;
+        quietFrames = 0;
+        if (!speech && loudFrames >= ONSET_FRAMES) {
+            speech = true;
+            speechStart = sampleCount - ONSET_FRAMES * FRAME_SAMPLES;
+            segmentCount++;
+        } else if (speech && sampleCount - speechStart > MAX_SPEECH_SAMPLES) {
+            // The background got louder (fan, traffic) - adopt it as the new floor
+            speech = false;
+            speechEnd = sampleCount;
+            loudFrames = 0;
+            noiseFloor = energy;
+        }
+    } else {
+        loudFrames = 0;
+        if (speech && ++quietFrames >= HANGOVER_FRAMES) {
+            speech = false;
+            speechEnd = sampleCount - HANGOVER_FRAMES * FRAME_SAMPLES;
+        }
+    }
+
+    // Track the background: follow drops quickly, rises slowly (~10 s), and freeze during speech
+    if (energy < noiseFloor) {
+        noiseFloor -= (noiseFloor - energy) >> 3;
+    } else if (!speech && !loud) {
+        noiseFloor += ((energy - noiseFloor) >> 9) + 1;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef VOICE_ACTIVITY_H
+#define VOICE_ACTIVITY_H
+
+#include <Arduino.h>
+
+// Frame-energy voice activity detector with an adaptive noise floor. Fed every microphone
+// sample; positions are absolute sample counts since boot so callers can map speech segments
+// onto ring buffers.
+class VoiceActivityDetector {
+public:
+    static const int FRAME_SAMPLES = 320;              // 20 ms at 16 kHz
+
+private:
+    static const int ONSET_FRAMES = 3;                 // 60 ms above threshold starts speech
+    static const int HANGOVER_FRAMES = 15;             // 300 ms below threshold ends it
+    static const uint32_t ON_RATIO = 6;                // Frame energy vs noise floor (~8 dB)
+    static const uint32_t MIN_SPEECH_ENERGY = 22500;   // Mean square (RMS 150) - ignore a silent room's hiss
+    static const uint32_t MAX_SPEECH_SAMPLES = 160000; // 10 s of "speech" is a louder background, not talk
+
+    uint64_t frameEnergy;
+    int frameFill;
+    uint32_t sampleCount;
+
+    uint32_t noiseFloor;        // Mean square of background frames
+    uint32_t lastEnergy;
+    int loudFrames;             // Consecutive frames above threshold
+    int quietFrames;            // Consecutive frames below threshold while in speech
+    bool speech;
+    uint32_t speechStart;       // First sample of the current/last speech segment
+    uint32_t speechEnd;         // Sample after the last voiced frame
+    uint32_t segmentCount;      // Speech onsets so far
+
+    void endFrame();
+
+public:
+    VoiceActivityDetector();
+
+    void reset();
+
+    inline void addSample(int16_t sample) {
+        frameEnergy += (int32_t)sample * sample;
+        sampleCount++;
+        if (++frameFill == FRAME_SAMPLES) {
+            endFrame();
+        }
+    }
+
+    bool isSpeech() const { return speech; }
+    uint32_t getSampleCount() const { return sampleCount; }
+    uint32_t getSpeechStart() const { return speechStart; }
+    uint32_t getSpeechEnd() const { return speech ? sampleCount : speechEnd; }
+    uint32_t getSegmentCount() const { return segmentCount; }
+    uint32_t getNoiseFloor() const { return noiseFloor; }
+    uint32_t getLastEnergy() const { return lastEnergy; }
+};
+
+#endif
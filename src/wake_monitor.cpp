@@ -0,0 +1,84 @@
+#include "wake_monitor.h"
+
+WakeMonitor::WakeMonitor(const char* name) : name(name), started(false), isAwake(false), wokeAt(0), lastReportAt(0) {
+    resetWindow(0);
+}
+
+void WakeMonitor::resetWindow(uint32_t nowUs) {
+    windowStart = nowUs;
+    wakes = 0;
+    timeouts = 0;
+    busyUs = 0;
+    intervals = 0;
+    intervalSum = 0;
+    intervalSquares = 0;
+    intervalMax = 0;
+    latencies = 0;
+    latencySum = 0;
+    latencyMax = 0;
+}
+
+void WakeMonitor::awake(bool byEvent) {
+    uint32_t now = micros();
+    if (started) {
+        uint32_t interval = now - wokeAt;
+        intervals++;
+        intervalSum += interval;
+        intervalSquares += (uint64_t)interval * interval;
+        if (interval > intervalMax) {
+            intervalMax = interval;
+        }
+    }
+    wakes++;
+    if (!byEvent) {
+        timeouts++;
+    }
+    wokeAt = now;
+    started = true;
+    isAwake = true;
+}
+
+void WakeMonitor::asleep() {
+    if (isAwake) {
+        busyUs += micros() - wokeAt;
+    }
+    isAwake = false;
+}
+
+void WakeMonitor::recordLatency(uint32_t us) {
+    latencies++;
+    latencySum += us;
+    if (us > latencyMax) {
+        latencyMax = us;
+    }
+}
+
+void WakeMonitor::report(unsigned long now) {
+    if (lastReportAt == 0) {
+        lastReportAt = now ? now : 1;
+        resetWindow(micros());
+        return;
+    }
+    if (now - lastReportAt < REPORT_INTERVAL) {
+        return;
+    }
+    lastReportAt = now;
+
+    uint32_t nowUs = micros();
+    float windowUs = (float)(nowUs - windowStart);
+    float meanMs = intervals ? intervalSum / 1000.0f / intervals : 0.0f;
+    float spreadMs = 0.0f;
+    if (intervals > 1) {
+        float meanUs = (float)intervalSum / intervals;
+        float variance = (float)intervalSquares / intervals - meanUs * meanUs;
+        spreadMs = variance > 0 ? sqrtf(variance) / 1000.0f : 0.0f;
+    }
+    Serial.printf("📊 %s wakes: %u (%u timeouts), busy %.1f%%, interval %.1f ms ± %.1f ms (max %.1f ms)",
+                  name, wakes, timeouts, windowUs > 0 ? 100.0f * busyUs / windowUs : 0.0f,
+                  meanMs, spreadMs, intervalMax / 1000.0f);
+    if (latencies > 0) {
+        Serial.printf(", event latency avg %.1f ms max %.1f ms", latencySum / 1000.0f / latencies, latencyMax / 1000.0f);
+    }
+    Serial.println();
+    resetWindow(nowUs);
+}
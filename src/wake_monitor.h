@@ -0,0 +1,49 @@
+#ifndef WAKE_MONITOR_H
+#define WAKE_MONITOR_H
+
+#include <Arduino.h>
+
+// Measures a task that sleeps until it has work: how often it wakes (and how many wakes were
+// timeouts rather than events), the share of time it is busy, how regular the wake-ups are,
+// and how long events wait before they are handled. Used by one task only.
+class WakeMonitor {
+private:
+    static const unsigned long REPORT_INTERVAL = 300000;
+
+    const char* name;
+    bool started;
+    bool isAwake;
+    uint32_t wokeAt;            // micros()
+    uint32_t windowStart;
+
+    // Per report window
+    uint32_t wakes;
+    uint32_t timeouts;
+    uint64_t busyUs;
+    uint32_t intervals;
+    uint64_t intervalSum;       // Wake-to-wake, us
+    uint64_t intervalSquares;
+    uint32_t intervalMax;
+    uint32_t latencies;
+    uint64_t latencySum;
+    uint32_t latencyMax;
+    unsigned long lastReportAt;
+
+    void resetWindow(uint32_t nowUs);
+
+public:
+    explicit WakeMonitor(const char* name);
+
+    // Call right after the wait returns; byEvent is false when it timed out
+    void awake(bool byEvent);
+    // Call right before the task waits again
+    void asleep();
+
+    // Time from an event (e.g. a button edge) to the task acting on it
+    void recordLatency(uint32_t us);
+
+    // Logs wakes, busy share, wake interval spread and event latency, then starts a new window
+    void report(unsigned long now);
+};
+
+#endif
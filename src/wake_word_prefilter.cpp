@@ -0,0 +1,185 @@
+#include "wake_word_prefilter.h"
+#include <math.h>
+
+WakeWordPrefilter::WakeWordPrefilter(int threshold)
+    : energySum(0), diffSum(0), crossings(0), lastSample(0), fill(0), sampleCount(0), historyNext(0),
+      historyCount(0), threshold(threshold), windows(0), passed(0), detections(0), missed(0), scoreCycles(0),
+      lastReportAt(0) {
+}
+
+void WakeWordPrefilter::endFrame() {
+    Frame& frame = history[historyNext];
+    frame.end = sampleCount;
+    frame.energy = (uint32_t)(energySum / FRAME_SAMPLES);
+    frame.diffEnergy = (uint32_t)(diffSum / FRAME_SAMPLES);
+    frame.zeroCrossings = crossings;
+    historyNext = (historyNext + 1) % HISTORY_FRAMES;
+    if (historyCount < HISTORY_FRAMES) {
+        historyCount++;
+    }
+    energySum = 0;
+    diffSum = 0;
+    crossings = 0;
+    fill = 0;
+}
+
+int WakeWordPrefilter::score(uint32_t start, uint32_t end) {
+    uint32_t startCycles = ESP.getCycleCount();
+
+    // Frames ending inside the window, oldest first
+    int count = 0;
+    int oldest = (historyNext - historyCount + HISTORY_FRAMES) % HISTORY_FRAMES;
+    for (int i = 0; i < historyCount; i++) {
+        const Frame& frame = history[(oldest + i) % HISTORY_FRAMES];
+        if ((int32_t)(frame.end - start) > 0 && (int32_t)(frame.end - end) <= 0) {
+            frames[count++] = &frame;
+        }
+    }
+    if (count < MIN_SPACING_FRAMES) {
+        scoreCycles += ESP.getCycleCount() - startCycles;
+        return 0;
+    }
+
+    // Smoothed log energy envelope and the window's background level
+    float background = 1e9f;
+    for (int i = 0; i < count; i++) {
+        float sum = 0;
+        int n = 0;
+        for (int j = i - SMOOTH_FRAMES / 2; j <= i + SMOOTH_FRAMES / 2; j++) {
+            if (j >= 0 && j < count) {
+                sum += frames[j]->energy;
+                n++;
+            }
+        }
+        level[i] = 10.0f * log10f(sum / n + 1.0f);
+        if (level[i] < background) {
+            background = level[i];
+        }
+    }
+
+    // Syllable nuclei: envelope peaks separated by dips of at least DIP_DB (hysteresis picker)
+    const int MAX_NUCLEI = 16;
+    int nuclei[MAX_NUCLEI];
+    int nucleusCount = 0;
+    bool rising = true;
+    int extreme = 0;
+    for (int i = 1; i < count && nucleusCount < MAX_NUCLEI; i++) {
+        if (rising) {
+            if (level[i] > level[extreme]) {
+                extreme = i;
+            } else if (level[extreme] - level[i] >= DIP_DB) {
+                if (level[extreme] - background >= MIN_PEAK_DB) {
+                    nuclei[nucleusCount++] = extreme;
+                }
+                rising = false;
+                extreme = i;
+            }
+        } else if (level[i] < level[extreme]) {
+            extreme = i;
+        } else if (level[i] - level[extreme] >= DIP_DB) {
+            rising = true;
+            extreme = i;
+        }
+    }
+    if (rising && nucleusCount < MAX_NUCLEI && level[extreme] - background >= MIN_PEAK_DB) {
+        nuclei[nucleusCount++] = extreme;  // Word cut off by the end of the window
+    }
+
+    // Best consecutive pair of nuclei
+    int best = 0;
+    for (int k = 0; k + 1 < nucleusCount; k++) {
+        int first = nuclei[k];
+        int second = nuclei[k + 1];
+        int spacing = second - first;
+        if (spacing < MIN_SPACING_FRAMES || spacing > MAX_SPACING_FRAMES) {
+            continue;
+        }
+        int points = TIMING_POINTS;
+
+        // Voiced syllables: few zero crossings, energy concentrated at low frequencies
+        for (int peak : {first, second}) {
+            const Frame& frame = *frames[peak];
+            float zcr = (float)frame.zeroCrossings / FRAME_SAMPLES;
+            float diffRatio = frame.energy ? (float)frame.diffEnergy / frame.energy : 4.0f;
+            if (zcr < VOICED_MAX_ZCR && diffRatio < VOICED_MAX_DIFF) {
+                points += VOICED_POINTS;
+            }
+        }
+
+        // One word: the gap between the syllables doesn't fall back to a pause
+        float valley = level[first];
+        for (int i = first; i <= second; i++) {
+            valley = min(valley, level[i]);
+        }
+        float lower = min(level[first], level[second]);
+        if (lower - valley <= MAX_INNER_DIP_DB && valley - background > QUIET_DB) {
+            points += INNER_DIP_POINTS;
+        }
+
+        // Stress on the first syllable
+        if (level[second] - level[first] <= STRESS_DB) {
+            points += STRESS_POINTS;
+        }
+
+        // A pause (or the edge of the speech) right before or after the word
+        bool paused = false;
+        for (int edge = 0; edge < 2 && !paused; edge++) {
+            int quiet = 0;
+            for (int step = 1; step <= PAUSE_SEARCH_FRAMES + PAUSE_FRAMES; step++) {
+                int i = edge ? second + step : first - step;
+                if (i < 0 || i >= count) {
+                    paused = step <= PAUSE_SEARCH_FRAMES;  // Window edge - the VAD saw silence there
+                    break;
+                }
+                quiet = level[i] - background <= QUIET_DB ? quiet + 1 : 0;
+                if (quiet >= PAUSE_FRAMES) {
+                    paused = true;
+                    break;
+                }
+            }
+        }
+        if (paused) {
+            points += PAUSE_POINTS;
+        }
+
+        best = max(best, points);
+    }
+
+    scoreCycles += ESP.getCycleCount() - startCycles;
+    return best;
+}
+
+void WakeWordPrefilter::recordOutcome(int score, bool searched, bool detected) {
+    windows++;
+    if (passes(score)) {
+        passed++;
+    }
+    if (searched && detected) {
+        detections++;
+        if (!passes(score)) {
+            missed++;
+            Serial.printf("⚠️ Wake word pre-filter would have missed this wake (score %d < %d)\n", score, threshold);
+        }
+    }
+}
+
+void WakeWordPrefilter::report(unsigned long now) {
+    if (lastReportAt == 0) {
+        lastReportAt = now;
+        return;
+    }
+    if (now - lastReportAt < REPORT_INTERVAL || windows == 0) {
+        return;
+    }
+    lastReportAt = now;
+
+    Serial.printf("📊 Wake word pre-filter: %u windows, %u passed (%.0f%% of searches avoided), %u wakes, %u missed, "
+                  "%lu cycles/window\n",
+                  windows, passed, (windows - passed) * 100.0f / windows, detections, missed,
+                  (unsigned long)(scoreCycles / windows));
+    windows = 0;
+    passed = 0;
+    detections = 0;
+    missed = 0;
+    scoreCycles = 0;
+}
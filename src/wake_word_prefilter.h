@@ -0,0 +1,99 @@
+#ifndef WAKE_WORD_PREFILTER_H
+#define WAKE_WORD_PREFILTER_H
+
+#include <Arduino.h>
+
+// Cheap first stage of the cloud wake word search: scores a window of speech for a "halo"-like
+// word - two voiced syllables a syllable apart, the first stressed, with a pause on one side -
+// from 10 ms frame features (energy, zero crossings, first-difference energy) that are computed
+// as samples are captured. Windows scoring under the threshold are never uploaded.
+// Fed and queried by the audio task only.
+class WakeWordPrefilter {
+public:
+    static const int FRAME_SAMPLES = 160;           // 10 ms at 16 kHz
+
+private:
+    static const int HISTORY_FRAMES = 320;          // Covers the wake word ring
+    static const int SMOOTH_FRAMES = 3;
+    static constexpr float DIP_DB = 4.0f;           // Envelope drop that separates syllables
+    static constexpr float MIN_PEAK_DB = 10.0f;     // Syllable peak above the window's background
+    static constexpr float QUIET_DB = 6.0f;         // Within this of the background is a pause
+    static constexpr float MAX_INNER_DIP_DB = 25.0f;// Deeper gaps are a pause, not a word
+    static constexpr float STRESS_DB = 3.0f;        // Second syllable may exceed the first by this
+    static constexpr float VOICED_MAX_ZCR = 0.25f;  // Zero crossings per sample
+    static constexpr float VOICED_MAX_DIFF = 0.6f;  // Difference / signal energy (~2 kHz centroid)
+    static const int MIN_SPACING_FRAMES = 12;       // Syllable peaks 120-500 ms apart
+    static const int MAX_SPACING_FRAMES = 50;
+    static const int PAUSE_FRAMES = 10;             // 100 ms of quiet
+    static const int PAUSE_SEARCH_FRAMES = 35;      // ...starting within 350 ms of the word
+    static const unsigned long REPORT_INTERVAL = 300000;
+
+    // Score weights (sum 100)
+    static const int TIMING_POINTS = 30;
+    static const int VOICED_POINTS = 20;            // Per syllable
+    static const int INNER_DIP_POINTS = 10;
+    static const int STRESS_POINTS = 5;
+    static const int PAUSE_POINTS = 15;
+
+    struct Frame {
+        uint32_t end;           // Sample position the frame ended at
+        uint32_t energy;        // Mean square
+        uint32_t diffEnergy;    // Mean square of the first difference
+        uint16_t zeroCrossings;
+    };
+
+    // Frame being accumulated
+    uint64_t energySum;
+    uint64_t diffSum;
+    uint16_t crossings;
+    int16_t lastSample;
+    int fill;
+    uint32_t sampleCount;
+
+    Frame history[HISTORY_FRAMES];
+    int historyNext;
+    int historyCount;
+
+    // Scratch for score(): the window's frames, oldest first
+    float level[HISTORY_FRAMES];        // Smoothed dB
+    const Frame* frames[HISTORY_FRAMES];
+
+    int threshold;
+
+    // Metrics
+    uint32_t windows;
+    uint32_t passed;
+    uint32_t detections;
+    uint32_t missed;            // Shadow searches that found a wake word the filter rejected
+    uint64_t scoreCycles;
+    unsigned long lastReportAt;
+
+    void endFrame();
+
+public:
+    explicit WakeWordPrefilter(int threshold);
+
+    inline void addSample(int16_t sample) {
+        int32_t diff = (int32_t)sample - lastSample;
+        energySum += (int32_t)sample * sample;
+        diffSum += (uint32_t)diff * (uint32_t)diff;
+        crossings += (sample ^ lastSample) < 0;
+        lastSample = sample;
+        sampleCount++;
+        if (++fill == FRAME_SAMPLES) {
+            endFrame();
+        }
+    }
+
+    // 0-100 for the audio in [start, end) (absolute sample positions, as used by the VAD)
+    int score(uint32_t start, uint32_t end);
+    bool passes(int score) const { return score >= threshold; }
+
+    // Outcome of a scored window, for the report: searched is false when the filter skipped it
+    void recordOutcome(int score, bool searched, bool detected);
+
+    // Logs windows scored, uploads avoided and wakes the filter would have missed
+    void report(unsigned long now);
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "wake_word_scheduler.h"
+
+WakeWordScheduler::WakeWordScheduler(uint32_t ringSamples)
+    : ringSamples(ringSamples), searchedUpTo(0), seenSegments(0), pending(false), pendingStart(0),
+      lastSearchAt(0), previousSearchAt(0), interval(MIN_INTERVAL), startedAt(0), lastReportAt(0), searches(0),
+      skipped(0), detections(0), latencyCount(0), latencyNext(0) {
+}
+
+bool WakeWordScheduler::nextWindow(const VoiceActivityDetector& vad, unsigned long now, WakeWindow& window) {
+    uint32_t sampleNow = vad.getSampleCount();
+    if (startedAt == 0) {
+        startedAt = now ? now : 1;
+        lastReportAt = startedAt;
+    }
+
+    if (vad.getSegmentCount() != seenSegments) {
+        seenSegments = vad.getSegmentCount();
+        if (!pending) {
+            pending = true;
+            pendingStart = vad.getSpeechStart();
+        }
+    }
+
+    if (!vad.isSpeech() && sampleNow - vad.getSpeechEnd() > LONG_SILENCE * SAMPLES_PER_MS) {
+        interval = MIN_INTERVAL;
+    }
+    if (!pending) {
+        return false;
+    }
+
+    uint32_t speechEnd = vad.getSpeechEnd();
+    bool ended = !vad.isSpeech();
+    if (ended && (speechEnd <= pendingStart || speechEnd - pendingStart < MIN_SPEECH_SAMPLES)) {
+        pending = false;  // Too short to hold a wake word
+        return false;
+    }
+    if (!ended && sampleNow - pendingStart < MAX_SEGMENT_SAMPLES) {
+        return false;     // Wait for the pause after the phrase
+    }
+    if (now - lastSearchAt < interval) {
+        return false;
+    }
+
+    // Window: the speech plus pre-roll, overlapping the previous window a little, within the ring
+    window.end = speechEnd;
+    uint32_t start = pendingStart > PRE_ROLL_SAMPLES ? pendingStart - PRE_ROLL_SAMPLES : 0;
+    uint32_t overlapStart = searchedUpTo > OVERLAP_SAMPLES ? searchedUpTo - OVERLAP_SAMPLES : 0;
+    if (start < overlapStart) {
+        start = overlapStart;
+    }
+    if (window.end - start < MIN_WINDOW_SAMPLES) {
+        start = window.end > MIN_WINDOW_SAMPLES ? window.end - MIN_WINDOW_SAMPLES : 0;
+    }
+    uint32_t oldest = sampleNow > ringSamples ? sampleNow - ringSamples : 0;
+    if (start < oldest) {
+        start = oldest;
+    }
+    window.start = start;
+    window.endedAt = now - (sampleNow - window.end) / SAMPLES_PER_MS;
+
+    searchedUpTo = window.end;
+    previousSearchAt = lastSearchAt;
+    lastSearchAt = now;
+    if (ended) {
+        pending = false;
+    } else {
+        pendingStart = window.end;  // Still talking - the rest goes in the next window
+    }
+    return window.end > window.start;
+}
+
+void WakeWordScheduler::onSearchComplete(const WakeWindow& window, bool detected, unsigned long now) {
+    searches++;
+
+    if (detected) {
+        detections++;
+        latencies[latencyNext] = now - window.endedAt;
+        latencyNext = (latencyNext + 1) % LATENCY_WINDOW;
+        if (latencyCount < LATENCY_WINDOW) {
+            latencyCount++;
+        }
+        interval = MIN_INTERVAL;
+    } else {
+        // Repeated misses mean noise or conversation - poll less often
+        interval = interval * 2 > MAX_INTERVAL ? MAX_INTERVAL : interval * 2;
+    }
+}
+
+void WakeWordScheduler::onSearchSkipped() {
+    skipped++;
+    lastSearchAt = previousSearchAt;
+}
+
+void WakeWordScheduler::skipTo(uint32_t sample) {
+    searchedUpTo = sample;
+    pending = false;
+}
+
+uint32_t WakeWordScheduler::medianLatency() const {
+    if (latencyCount == 0) {
+        return 0;
+    }
+    uint32_t sorted[LATENCY_WINDOW];
+    memcpy(sorted, latencies, latencyCount * sizeof(uint32_t));
+    for (int i = 1; i < latencyCount; i++) {
+        uint32_t value = sorted[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > value) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = value;
+    }
+    return sorted[latencyCount / 2];
+}
+
+void WakeWordScheduler::report(unsigned long now) {
+    if (startedAt == 0 || now - lastReportAt < REPORT_INTERVAL) {
+        return;
+    }
+    lastReportAt = now;
+
+    float hours = (now - startedAt) / 3600000.0f;
+    Serial.printf("📊 Wake word polling: %u searches (%.0f/h), %u skipped locally, %u detections, median wake latency %u ms, backoff %lu ms\n",
+                  searches, hours > 0 ? searches / hours : 0.0f, skipped, detections, medianLatency(), interval);
+}
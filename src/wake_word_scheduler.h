@@ -0,0 +1,71 @@
+#ifndef WAKE_WORD_SCHEDULER_H
+#define WAKE_WORD_SCHEDULER_H
+
+#include <Arduino.h>
+#include "voice_activity.h"
+
+// Range of ring-buffer audio to search, in absolute sample positions [start, end)
+struct WakeWindow {
+    uint32_t start;
+    uint32_t end;
+    unsigned long endedAt;      // millis() when the last sample of the window was captured
+};
+
+// Decides when the cloud wake word search runs: only after the VAD saw speech, sized to the
+// speech segment (plus a little context), never re-sending audio that was already searched,
+// and backing off while noise keeps producing misses.
+class WakeWordScheduler {
+private:
+    static const uint32_t SAMPLES_PER_MS = 16;
+    static const uint32_t PRE_ROLL_SAMPLES = 300 * SAMPLES_PER_MS;    // Context before the onset
+    static const uint32_t OVERLAP_SAMPLES = 500 * SAMPLES_PER_MS;     // Re-send so a word split across windows is seen whole
+    static const uint32_t MIN_SPEECH_SAMPLES = 250 * SAMPLES_PER_MS;  // Shorter bursts are clicks and bumps
+    static const uint32_t MIN_WINDOW_SAMPLES = 1000 * SAMPLES_PER_MS;
+    static const uint32_t MAX_SEGMENT_SAMPLES = 2500 * SAMPLES_PER_MS; // Search long talk without waiting for a pause
+    static const unsigned long MIN_INTERVAL = 1000;
+    static const unsigned long MAX_INTERVAL = 8000;
+    static const unsigned long LONG_SILENCE = 10000;                  // Resets the backoff
+    static const unsigned long REPORT_INTERVAL = 300000;
+    static const int LATENCY_WINDOW = 16;
+
+    uint32_t ringSamples;
+    uint32_t searchedUpTo;      // Audio before this sample has been searched (or skipped)
+    uint32_t seenSegments;
+    bool pending;               // Unsearched speech since pendingStart
+    uint32_t pendingStart;
+    unsigned long lastSearchAt;
+    unsigned long previousSearchAt;   // Restored when a window is skipped without a search
+    unsigned long interval;     // Current minimum gap between searches
+
+    // Metrics
+    unsigned long startedAt;
+    unsigned long lastReportAt;
+    uint32_t searches;
+    uint32_t skipped;
+    uint32_t detections;
+    uint32_t latencies[LATENCY_WINDOW];
+    int latencyCount;
+    int latencyNext;
+
+    uint32_t medianLatency() const;
+
+public:
+    explicit WakeWordScheduler(uint32_t ringSamples);
+
+    // True if a search should run now; window gets the audio range to submit
+    bool nextWindow(const VoiceActivityDetector& vad, unsigned long now, WakeWindow& window);
+
+    // Feed back the outcome so misses back off and hits are timed
+    void onSearchComplete(const WakeWindow& window, bool detected, unsigned long now);
+
+    // The window was rejected locally and never uploaded - it doesn't count towards the interval
+    void onSearchSkipped();
+
+    // Treat everything up to this sample as searched (e.g. audio recorded as a command)
+    void skipTo(uint32_t sample);
+
+    // Log requests per hour and median wake latency periodically
+    void report(unsigned long now);
+};
+
+#endif
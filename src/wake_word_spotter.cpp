@@ -0,0 +1,335 @@
+#include "wake_word_spotter.h"
+#include <Preferences.h>
+
+static const char* const NVS_NAMESPACE = "wakeword";
+static const char* const NVS_KEY = "templates";
+
+WakeWordSpotter::WakeWordSpotter()
+    : store(nullptr), enrolled(false), frameIndex(0), quietUntil(0), detected(false), historyNext(0),
+      historyCount(0), enrolling(false), captured(0), listenFrom(0), enrollDeadline(0), matchCycles(0),
+      matchFrames(0), detections(0), lastReportAt(0) {
+}
+
+bool WakeWordSpotter::begin() {
+    if (!store) {
+        store = (Store*)(psramFound() ? ps_malloc(sizeof(Store)) : malloc(sizeof(Store)));
+        if (!store) {
+            Serial.println("❌ Failed to allocate wake word templates");
+            return false;
+        }
+    }
+
+    enrolled = load();
+    if (enrolled) {
+        Serial.printf("✅ Personal wake word loaded (%u templates, threshold %u)\n", store->count, store->threshold);
+    }
+    resetMatcher();
+    return true;
+}
+
+bool WakeWordSpotter::load() {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) {
+        return false;  // Never enrolled
+    }
+    size_t size = prefs.getBytes(NVS_KEY, store, sizeof(Store));
+    prefs.end();
+
+    if (size != sizeof(Store) || store->version != STORE_VERSION || store->count == 0 ||
+        store->count > ENROLL_UTTERANCES) {
+        return false;
+    }
+    for (int t = 0; t < store->count; t++) {
+        if (store->templates[t].length < MIN_TEMPLATE_FRAMES || store->templates[t].length > MAX_TEMPLATE_FRAMES) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WakeWordSpotter::save() {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        return false;
+    }
+    size_t written = prefs.putBytes(NVS_KEY, store, sizeof(Store));
+    prefs.end();
+    return written == sizeof(Store);
+}
+
+void WakeWordSpotter::clear() {
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, false)) {
+        prefs.clear();
+        prefs.end();
+    }
+    enrolled = false;
+    enrolling = false;
+    detected = false;
+    Serial.println("🗑️ Personal wake word cleared");
+}
+
+void WakeWordSpotter::resetMatcher() {
+    for (int t = 0; t < ENROLL_UTTERANCES; t++) {
+        for (int j = 0; j < MAX_TEMPLATE_FRAMES; j++) {
+            cells[t][j].cost = INFINITE_COST;
+            cells[t][j].steps = 1;
+            cells[t][j].start = 0;
+        }
+    }
+}
+
+uint16_t WakeWordSpotter::frameDistance(const int8_t* a, const int8_t* b) {
+    uint16_t distance = 0;
+    for (int c = 0; c < COEFFS; c++) {
+        int d = a[c] - b[c];
+        distance += d < 0 ? -d : d;
+    }
+    return distance;
+}
+
+// Compare alignments by mean cost per step, so long and short paths compete fairly
+bool WakeWordSpotter::cheaper(const Cell& a, const Cell& b) {
+    return (uint64_t)a.cost * b.steps < (uint64_t)b.cost * a.steps;
+}
+
+void WakeWordSpotter::addFrame(const int8_t* features, uint32_t endSample) {
+    memcpy(history[historyNext], features, COEFFS);
+    historyEnd[historyNext] = endSample;
+    historyNext = (historyNext + 1) % HISTORY_FRAMES;
+    if (historyCount < HISTORY_FRAMES) {
+        historyCount++;
+    }
+
+    frameIndex++;
+    if (enrolled && !enrolling) {
+        match(features);
+    }
+}
+
+void WakeWordSpotter::match(const int8_t* features) {
+    uint32_t startCycles = ESP.getCycleCount();
+    bool listening = (int32_t)(frameIndex - quietUntil) >= 0;
+
+    for (int t = 0; t < store->count; t++) {
+        const Template& tpl = store->templates[t];
+        Cell* column = cells[t];
+        Cell diagonal = column[0];
+
+        // Subsequence DTW: an alignment may start at any input frame (column[0] restarts every
+        // frame); each cell extends the cheapest of its three predecessors
+        for (int j = 0; j < tpl.length; j++) {
+            uint16_t distance = frameDistance(features, tpl.features[j]);
+            Cell previous = column[j];      // Same template frame, previous input frame
+            Cell best;
+            if (j == 0) {
+                best.cost = 0;
+                best.steps = 0;
+                best.start = frameIndex;
+            } else {
+                best = diagonal;
+                if (cheaper(previous, best)) {
+                    best = previous;
+                }
+                if (cheaper(column[j - 1], best)) {
+                    best = column[j - 1];   // Previous template frame, this input frame
+                }
+            }
+            diagonal = previous;
+
+            Cell& cell = column[j];
+            cell.cost = best.cost >= INFINITE_COST - distance ? INFINITE_COST : best.cost + distance;
+            cell.steps = best.steps + 1;
+            cell.start = best.start;
+        }
+
+        // A whole-template alignment of plausible duration below the threshold is a detection
+        const Cell& end = column[tpl.length - 1];
+        uint32_t duration = frameIndex - end.start + 1;
+        if (listening && end.cost < INFINITE_COST && duration >= (uint32_t)tpl.length / 2 &&
+            duration <= (uint32_t)tpl.length * 2 && end.cost < (uint32_t)store->threshold * end.steps) {
+            Serial.printf("🎙️ Personal wake word matched template %d (distance %u, threshold %u)\n",
+                          t, end.cost / end.steps, store->threshold);
+            detected = true;
+            detections++;
+            quietUntil = frameIndex + REFRACTORY_FRAMES;
+            resetMatcher();
+            break;
+        }
+    }
+
+    matchCycles += ESP.getCycleCount() - startCycles;
+    matchFrames++;
+}
+
+bool WakeWordSpotter::takeDetection() {
+    bool result = detected;
+    detected = false;
+    return result;
+}
+
+void WakeWordSpotter::startEnrollment(uint32_t fromSample, unsigned long now) {
+    if (!store) {
+        return;
+    }
+    enrolling = true;
+    detected = false;
+    captured = 0;
+    listenFrom = fromSample;
+    enrollDeadline = now + ENROLL_TIMEOUT;
+    Serial.println("🎙️ Wake word enrollment started");
+}
+
+WakeWordSpotter::EnrollResult WakeWordSpotter::pollEnrollment(const VoiceActivityDetector& vad, unsigned long now) {
+    if (!enrolling) {
+        return EnrollResult::NONE;
+    }
+    if ((long)(now - enrollDeadline) > 0) {
+        Serial.println("⏰ Wake word enrollment timed out");
+        enrolling = false;
+        enrolled = load();
+        resetMatcher();
+        return EnrollResult::TIMED_OUT;
+    }
+
+    // Wait for a finished speech segment that started after the prompt
+    uint32_t start = vad.getSpeechStart();
+    uint32_t end = vad.getSpeechEnd();
+    if (vad.isSpeech() || (int32_t)(start - listenFrom) < 0) {
+        return EnrollResult::NONE;
+    }
+    listenFrom = end;
+    enrollDeadline = now + ENROLL_TIMEOUT;
+
+    if (!captureUtterance(start, end, store->templates[captured])) {
+        return EnrollResult::REJECTED;
+    }
+    Serial.printf("🎙️ Wake word utterance %d/%d captured (%u frames)\n", captured + 1, ENROLL_UTTERANCES,
+                  store->templates[captured].length);
+    if (++captured < ENROLL_UTTERANCES) {
+        return EnrollResult::CAPTURED;
+    }
+
+    enrolling = false;
+    store->version = STORE_VERSION;
+    store->count = captured;
+    store->threshold = computeThreshold();
+    if (!save()) {
+        Serial.println("❌ Failed to save wake word templates");
+        enrolled = load();
+        resetMatcher();  // computeThreshold() used the cells as scratch rows
+        return EnrollResult::FAILED;
+    }
+    enrolled = true;
+    resetMatcher();
+    Serial.printf("✅ Personal wake word saved (threshold %u)\n", store->threshold);
+    return EnrollResult::COMPLETE;
+}
+
+bool WakeWordSpotter::captureUtterance(uint32_t start, uint32_t end, Template& out) {
+    // Frames are selected by their centre sample, oldest first
+    uint32_t from = start - MARGIN_SAMPLES;
+    uint32_t to = end + MARGIN_SAMPLES;
+    int oldest = (historyNext - historyCount + HISTORY_FRAMES) % HISTORY_FRAMES;
+    if (historyCount == 0 || (int32_t)(historyEnd[oldest] - MfccExtractor::FRAME_SAMPLES / 2 - start) > 0) {
+        Serial.println("⚠️ Wake word utterance not fully in the feature history");
+        return false;
+    }
+
+    int length = 0;
+    for (int i = 0; i < historyCount; i++) {
+        int index = (oldest + i) % HISTORY_FRAMES;
+        uint32_t centre = historyEnd[index] - MfccExtractor::FRAME_SAMPLES / 2;
+        if ((int32_t)(centre - from) < 0 || (int32_t)(centre - to) > 0) {
+            continue;
+        }
+        if (length == MAX_TEMPLATE_FRAMES) {
+            Serial.println("⚠️ Wake word utterance too long");
+            return false;
+        }
+        memcpy(out.features[length++], history[index], COEFFS);
+    }
+
+    if (length < MIN_TEMPLATE_FRAMES) {
+        Serial.printf("⚠️ Wake word utterance too short (%d frames)\n", length);
+        return false;
+    }
+    out.length = length;
+    return true;
+}
+
+// Mean cost per step of the best full alignment of two templates (both ends anchored).
+// Uses the matcher's cells as row buffers - only called while enrolling.
+uint32_t WakeWordSpotter::alignmentCost(const Template& a, const Template& b) {
+    for (int i = 0; i < a.length; i++) {
+        Cell* row = cells[i & 1];
+        const Cell* above = cells[(i + 1) & 1];
+        for (int j = 0; j < b.length; j++) {
+            Cell best;
+            if (i == 0 && j == 0) {
+                best.cost = 0;
+                best.steps = 0;
+            } else {
+                best.cost = INFINITE_COST;
+                best.steps = 1;
+                if (i > 0 && cheaper(above[j], best)) {
+                    best = above[j];
+                }
+                if (j > 0 && cheaper(row[j - 1], best)) {
+                    best = row[j - 1];
+                }
+                if (i > 0 && j > 0 && cheaper(above[j - 1], best)) {
+                    best = above[j - 1];
+                }
+            }
+            row[j].cost = best.cost + frameDistance(a.features[i], b.features[j]);
+            row[j].steps = best.steps + 1;
+            row[j].start = 0;
+        }
+    }
+    const Cell& end = cells[(a.length - 1) & 1][b.length - 1];
+    return end.cost / end.steps;
+}
+
+uint16_t WakeWordSpotter::computeThreshold() {
+    uint32_t total = 0;
+    int pairs = 0;
+    for (int a = 0; a < store->count; a++) {
+        for (int b = a + 1; b < store->count; b++) {
+            total += alignmentCost(store->templates[a], store->templates[b]);
+            pairs++;
+        }
+    }
+    uint32_t threshold = pairs ? total / pairs * THRESHOLD_PERCENT / 100 : MAX_THRESHOLD;
+    if (threshold < MIN_THRESHOLD) {
+        threshold = MIN_THRESHOLD;
+    } else if (threshold > MAX_THRESHOLD) {
+        threshold = MAX_THRESHOLD;
+    }
+    return threshold;
+}
+
+int WakeWordSpotter::getTemplateFrames() const {
+    int frames = 0;
+    for (int t = 0; enrolled && t < store->count; t++) {
+        frames += store->templates[t].length;
+    }
+    return frames;
+}
+
+void WakeWordSpotter::report(unsigned long now) {
+    if (!enrolled || now - lastReportAt < REPORT_INTERVAL) {
+        return;
+    }
+    lastReportAt = now;
+    if (matchFrames == 0) {
+        return;
+    }
+
+    // One feature frame every 10 ms
+    uint32_t cyclesPerFrame = (uint32_t)(matchCycles / matchFrames);
+    Serial.printf("📊 Personal wake word: %u detections, DTW %u cycles/frame over %d template frames (%.2f%% CPU)\n",
+                  detections, cyclesPerFrame, getTemplateFrames(), cyclesPerFrame * 100.0f / (ESP.getCpuFreqMHz() * 10000.0f));
+    matchCycles = 0;
+    matchFrames = 0;
+}
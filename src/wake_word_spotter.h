@@ -0,0 +1,125 @@
+#ifndef WAKE_WORD_SPOTTER_H
+#define WAKE_WORD_SPOTTER_H
+
+#include <Arduino.h>
+#include "mfcc_extractor.h"
+#include "voice_activity.h"
+
+// Personal wake word: a few enrolled utterances are kept as MFCC templates in NVS and matched
+// against the live feature stream with subsequence DTW, so detection needs no network at all.
+// Fed and polled by the audio task only.
+class WakeWordSpotter {
+public:
+    enum class EnrollResult : uint8_t {
+        NONE,
+        CAPTURED,       // Utterance stored - prompt for the next one
+        REJECTED,       // Too short or too long - prompt again
+        COMPLETE,       // All utterances stored and saved
+        FAILED,         // Couldn't save - the previous wake word stays
+        TIMED_OUT       // Nobody spoke - the previous wake word stays
+    };
+
+    static const int ENROLL_UTTERANCES = 3;
+
+private:
+    static const int COEFFS = MfccExtractor::COEFFS;
+    static const int MIN_TEMPLATE_FRAMES = 25;          // 250 ms
+    static const int MAX_TEMPLATE_FRAMES = 120;         // 1.2 s
+    static const int HISTORY_FRAMES = 160;              // Features kept for enrollment
+    static const uint32_t MARGIN_SAMPLES = 800;         // 50 ms around the VAD segment
+    static const unsigned long ENROLL_TIMEOUT = 8000;   // Per utterance
+    static const uint32_t REFRACTORY_FRAMES = 100;      // 1 s after a detection
+    static const uint32_t THRESHOLD_PERCENT = 130;      // Of the enrolled utterances' distance to each other
+    static const uint16_t MIN_THRESHOLD = 20;           // Mean L1 distance per path step
+    static const uint16_t MAX_THRESHOLD = 250;
+    static const uint32_t INFINITE_COST = 0x3FFFFFFF;
+    static const uint32_t STORE_VERSION = 1;
+    static const unsigned long REPORT_INTERVAL = 300000;
+
+    struct Template {
+        uint8_t length;
+        int8_t features[MAX_TEMPLATE_FRAMES][COEFFS];
+    };
+
+    // NVS blob
+    struct Store {
+        uint32_t version;
+        uint8_t count;
+        uint16_t threshold;
+        Template templates[ENROLL_UTTERANCES];
+    };
+
+    // Best alignment ending at one template frame
+    struct Cell {
+        uint32_t cost;
+        uint16_t steps;
+        uint32_t start;         // Frame the alignment started at
+    };
+
+    Store* store;               // PSRAM when available
+    bool enrolled;
+    Cell cells[ENROLL_UTTERANCES][MAX_TEMPLATE_FRAMES];
+    uint32_t frameIndex;
+    uint32_t quietUntil;
+    bool detected;
+
+    // Recent features with the sample position each frame ended at
+    int8_t history[HISTORY_FRAMES][COEFFS];
+    uint32_t historyEnd[HISTORY_FRAMES];
+    int historyNext;
+    int historyCount;
+
+    bool enrolling;
+    int captured;
+    uint32_t listenFrom;        // Only speech starting after this sample counts
+    unsigned long enrollDeadline;
+
+    // Metrics
+    uint64_t matchCycles;
+    uint32_t matchFrames;
+    uint32_t detections;
+    unsigned long lastReportAt;
+
+    bool load();
+    bool save();
+    void resetMatcher();
+    void match(const int8_t* features);
+    bool captureUtterance(uint32_t start, uint32_t end, Template& out);
+    uint16_t computeThreshold();
+    uint32_t alignmentCost(const Template& a, const Template& b);
+
+    static uint16_t frameDistance(const int8_t* a, const int8_t* b);
+    static bool cheaper(const Cell& a, const Cell& b);
+
+public:
+    WakeWordSpotter();
+
+    // Allocates the template store and loads an enrolled wake word from NVS
+    bool begin();
+
+    bool isEnrolled() const { return enrolled && !enrolling; }
+    bool isEnrolling() const { return enrolling; }
+
+    // Whether the capture path needs to compute features at all
+    bool isActive() const { return enrolled || enrolling; }
+
+    // One MFCC frame; endSample is the capture position (VAD sample count) the frame ended at
+    void addFrame(const int8_t* features, uint32_t endSample);
+
+    // True once per detection
+    bool takeDetection();
+
+    // Enrollment: listen for ENROLL_UTTERANCES speech segments starting after fromSample
+    void startEnrollment(uint32_t fromSample, unsigned long now);
+    EnrollResult pollEnrollment(const VoiceActivityDetector& vad, unsigned long now);
+
+    // Forget the enrolled wake word (back to the cloud search)
+    void clear();
+
+    // Template frames the matcher steps through for every input frame
+    int getTemplateFrames() const;
+
+    void report(unsigned long now);
+};
+
+#endif
@@ -0,0 +1,142 @@
+// Size, encode cost and fidelity of the IMA-ADPCM upload encoder. The WAV that AdpcmWavStream
+// produces is read back in 1 KB chunks (as HTTPClient pulls it), parsed and decoded with a
+// straightforward IMA decoder, and compared with the PCM it came from.
+//
+//   tools/bench/run.sh adpcm_codec_bench [speech.wav]
+//
+// This measures the codec, not transcription: Deepgram's accuracy on ADPCM uploads has to be
+// checked against the real service.
+
+#include "bench_audio.h"
+#include "../../src/adpcm_wav_stream.h"
+
+static const int STEPS[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+static const int INDEX_STEPS[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+static uint32_t le32(const uint8_t* p) { return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24; }
+static uint16_t le16(const uint8_t* p) { return p[0] | p[1] << 8; }
+
+// Decodes a mono IMA-ADPCM WAV; empty on a malformed file
+static std::vector<int16_t> decode(const std::vector<uint8_t>& wav) {
+    std::vector<int16_t> out;
+    if (wav.size() < 12 || memcmp(wav.data(), "RIFF", 4) != 0 || le32(&wav[4]) != wav.size() - 8) {
+        return out;
+    }
+    int blockAlign = 0, samplesPerBlock = 0;
+    uint32_t samples = 0;
+    for (size_t pos = 12; pos + 8 <= wav.size();) {
+        uint32_t size = le32(&wav[pos + 4]);
+        const uint8_t* body = &wav[pos + 8];
+        if (memcmp(&wav[pos], "fmt ", 4) == 0) {
+            if (le16(body) != 0x0011 || le16(body + 2) != 1 || le16(body + 14) != 4) {
+                return out;
+            }
+            blockAlign = le16(body + 12);
+            samplesPerBlock = le16(body + 18);
+        } else if (memcmp(&wav[pos], "fact", 4) == 0) {
+            samples = le32(body);
+        } else if (memcmp(&wav[pos], "data", 4) == 0 && blockAlign > 0) {
+            for (size_t b = 0; b + blockAlign <= size; b += blockAlign) {
+                const uint8_t* block = body + b;
+                int predictor = (int16_t)le16(block);
+                int index = block[2];
+                out.push_back(predictor);
+                for (int i = 1; i < samplesPerBlock; i++) {
+                    int code = (block[4 + (i - 1) / 2] >> (((i - 1) & 1) * 4)) & 0xF;
+                    int step = STEPS[index];
+                    int delta = step >> 3;
+                    if (code & 4) delta += step;
+                    if (code & 2) delta += step >> 1;
+                    if (code & 1) delta += step >> 2;
+                    predictor += (code & 8) ? -delta : delta;
+                    predictor = predictor > 32767 ? 32767 : (predictor < -32768 ? -32768 : predictor);
+                    index += INDEX_STEPS[code & 7];
+                    index = index < 0 ? 0 : (index > 88 ? 88 : index);
+                    out.push_back(predictor);
+                }
+            }
+            out.resize(min((size_t)samples, out.size()));
+            return out;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    return out;
+}
+
+static void runCase(const char* label, const std::vector<int16_t>& pcm, uint32_t sampleRate) {
+    PcmSegment segment = {(const uint8_t*)pcm.data(), pcm.size() * 2};
+    std::vector<uint8_t> wav;
+    double ns = timeBest([&] {
+        AdpcmWavStream stream(&segment, 1, sampleRate);
+        wav.resize(stream.size());
+        size_t got = 0;
+        while (got < wav.size()) {
+            got += stream.readBytes((char*)&wav[got], min((size_t)1024, wav.size() - got));
+        }
+    });
+
+    std::vector<int16_t> decoded = decode(wav);
+    if (decoded.size() != pcm.size()) {
+        printf("  %-22s decode failed (%zu of %zu samples)\n", label, decoded.size(), pcm.size());
+        return;
+    }
+    double signal = 0, error = 0;
+    for (size_t i = 0; i < pcm.size(); i++) {
+        signal += (double)pcm[i] * pcm[i];
+        error += ((double)decoded[i] - pcm[i]) * ((double)decoded[i] - pcm[i]);
+    }
+    double seconds = (double)pcm.size() / sampleRate;
+    size_t pcmWav = 44 + pcm.size() * 2;
+    printf("  %-22s %7zu -> %6zu bytes (%.1f%%), SNR %5.1f dB, encode %.2f ms per s of audio\n", label, pcmWav,
+           wav.size(), wav.size() * 100.0 / pcmWav, 10.0 * log10(signal / (error + 1e-9)), ns / 1e6 / seconds);
+}
+
+static std::vector<int16_t> toPcm(const std::vector<float>& audio) {
+    std::vector<int16_t> pcm(audio.size());
+    for (size_t i = 0; i < audio.size(); i++) {
+        pcm[i] = clip16(audio[i]);
+    }
+    return pcm;
+}
+
+int main(int argc, char** argv) {
+    printf("IMA-ADPCM upload encoder (256-byte blocks)\n");
+    if (argc > 1) {
+        uint32_t rate = 0;
+        std::vector<float> audio = loadWav(argv[1], &rate);
+        if (audio.empty()) {
+            fprintf(stderr, "Can't read %s (16-bit PCM WAV expected)\n", argv[1]);
+            return 1;
+        }
+        runCase(argv[1], toPcm(audio), rate);
+        return 0;
+    }
+
+    std::vector<float> speech = makeSpeech(15.0f, 12000.0f);
+    std::vector<float> noise = makeStreetNoise(15.0f, 1000.0f);
+    std::vector<float> noisy(speech);
+    for (size_t i = 0; i < noisy.size(); i++) {
+        noisy[i] += noise[i];
+    }
+    std::vector<float> quiet(speech);
+    for (float& value : quiet) {
+        value *= 0.1f;
+    }
+    // 3 s wake word window (the ring is 8 kHz) and a 15 s command at 16 kHz
+    std::vector<float> wakeWindow;
+    for (size_t i = 0; i < 3 * (size_t)BENCH_SAMPLE_RATE; i += 2) {
+        wakeWindow.push_back(speech[i]);
+    }
+    runCase("command, clean", toPcm(speech), BENCH_SAMPLE_RATE);
+    runCase("command, street noise", toPcm(noisy), BENCH_SAMPLE_RATE);
+    runCase("command, quiet talker", toPcm(quiet), BENCH_SAMPLE_RATE);
+    runCase("wake window, 8 kHz", toPcm(wakeWindow), BENCH_SAMPLE_RATE / 2);
+    return 0;
+}
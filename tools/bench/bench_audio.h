@@ -0,0 +1,159 @@
+#ifndef BENCH_AUDIO_H
+#define BENCH_AUDIO_H
+
+// Shared helpers for the host benches: deterministic test signals at 16 kHz in 16-bit units,
+// a 16-bit mono WAV loader for recorded samples, and timing.
+
+#include <Arduino.h>
+#include <vector>
+
+static const int BENCH_SAMPLE_RATE = 16000;
+
+// xorshift32 - the same signal on every run and platform
+class BenchRandom {
+private:
+    uint32_t state;
+
+public:
+    explicit BenchRandom(uint32_t seed) : state(seed ? seed : 1) {}
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    float uniform() { return (next() >> 8) / 16777216.0f * 2.0f - 1.0f; }
+};
+
+// Voiced "speech": syllables of a glottal harmonic series shaped by two moving formants, with
+// pauses between words. Amplitude is the peak of the loudest syllable.
+inline std::vector<float> makeSpeech(float seconds, float amplitude, uint32_t seed = 1) {
+    std::vector<float> out((size_t)(seconds * BENCH_SAMPLE_RATE), 0.0f);
+    BenchRandom random(seed);
+    size_t pos = BENCH_SAMPLE_RATE / 4;
+    while (pos < out.size()) {
+        int syllables = 1 + random.next() % 3;
+        for (int s = 0; s < syllables && pos < out.size(); s++) {
+            size_t length = (size_t)((0.15f + 0.1f * (random.uniform() + 1.0f)) * BENCH_SAMPLE_RATE);
+            float f0 = 120.0f + 40.0f * random.uniform();
+            float formant1 = 600.0f + 250.0f * random.uniform();
+            float formant2 = 1700.0f + 500.0f * random.uniform();
+            float level = amplitude * (0.6f + 0.2f * (random.uniform() + 1.0f));
+            double phase = 0;
+            for (size_t i = 0; i < length && pos + i < out.size(); i++) {
+                float t = (float)i / length;
+                float envelope = sinf((float)M_PI * t);
+                float pitch = f0 * (1.0f + 0.1f * sinf(2.0f * (float)M_PI * t));
+                phase += 2.0 * M_PI * pitch / BENCH_SAMPLE_RATE;
+                float value = 0;
+                for (int k = 1; k * pitch < 3800.0f; k++) {
+                    float f = k * pitch;
+                    float gain = 1.0f / (1.0f + powf((f - formant1) / 150.0f, 2)) +
+                                 0.5f / (1.0f + powf((f - formant2) / 250.0f, 2)) + 0.02f;
+                    value += gain * sinf((float)(k * phase)) / k;
+                }
+                out[pos + i] = level * envelope * value * 0.6f;
+            }
+            pos += length + BENCH_SAMPLE_RATE / 50;
+        }
+        pos += (size_t)((0.3f + 0.2f * (random.uniform() + 1.0f)) * BENCH_SAMPLE_RATE);
+    }
+    return out;
+}
+
+// Street-like background: brown-ish road rumble, an engine hum with slow level changes and the
+// odd horn, scaled to the given RMS
+inline std::vector<float> makeStreetNoise(float seconds, float rms, uint32_t seed = 2) {
+    std::vector<float> out((size_t)(seconds * BENCH_SAMPLE_RATE));
+    BenchRandom random(seed);
+    float brown = 0;
+    float pink = 0;
+    double sumSquares = 0;
+    for (size_t i = 0; i < out.size(); i++) {
+        float t = (float)i / BENCH_SAMPLE_RATE;
+        float white = random.uniform();
+        brown = 0.995f * brown + 0.05f * white;
+        pink = 0.9f * pink + 0.1f * white;
+        float engine = 0.3f * (1.0f + 0.5f * sinf(0.7f * t)) * (sinf(2.0f * (float)M_PI * 85.0f * t) +
+                       0.5f * sinf(2.0f * (float)M_PI * 170.0f * t));
+        float horn = fmodf(t, 7.0f) > 5.5f && fmodf(t, 7.0f) < 6.0f ?
+                     0.3f * (sinf(2.0f * (float)M_PI * 420.0f * t) + sinf(2.0f * (float)M_PI * 525.0f * t)) : 0.0f;
+        out[i] = brown + 0.6f * pink + 0.2f * white + engine + horn;
+        sumSquares += out[i] * out[i];
+    }
+    float scale = rms / sqrtf((float)(sumSquares / out.size()));
+    for (float& value : out) {
+        value *= scale;
+    }
+    return out;
+}
+
+// 16-bit PCM WAV (first channel only); empty if the file can't be read or isn't PCM
+inline std::vector<float> loadWav(const char* path, uint32_t* sampleRate = nullptr) {
+    std::vector<float> out;
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return out;
+    }
+    uint8_t riff[12];
+    uint16_t channels = 0, bits = 0;
+    uint32_t rate = 0;
+    if (fread(riff, 1, 12, file) == 12 && memcmp(riff, "RIFF", 4) == 0 && memcmp(riff + 8, "WAVE", 4) == 0) {
+        uint8_t chunk[8];
+        while (fread(chunk, 1, 8, file) == 8) {
+            uint32_t size = chunk[4] | chunk[5] << 8 | chunk[6] << 16 | (uint32_t)chunk[7] << 24;
+            if (memcmp(chunk, "fmt ", 4) == 0) {
+                uint8_t fmt[16];
+                if (size < 16 || fread(fmt, 1, 16, file) != 16 || (fmt[0] | fmt[1] << 8) != 1) {
+                    break;
+                }
+                channels = fmt[2] | fmt[3] << 8;
+                rate = fmt[4] | fmt[5] << 8 | fmt[6] << 16 | (uint32_t)fmt[7] << 24;
+                bits = fmt[14] | fmt[15] << 8;
+                fseek(file, size - 16 + (size & 1), SEEK_CUR);
+            } else if (memcmp(chunk, "data", 4) == 0 && bits == 16 && channels > 0) {
+                std::vector<int16_t> pcm(size / 2);
+                size_t got = fread(pcm.data(), 2, pcm.size(), file);
+                for (size_t i = 0; i < got; i += channels) {
+                    out.push_back(pcm[i]);
+                }
+                break;
+            } else {
+                fseek(file, size + (size & 1), SEEK_CUR);
+            }
+        }
+    }
+    fclose(file);
+    if (sampleRate) {
+        *sampleRate = rate;
+    }
+    return out;
+}
+
+inline double rmsOf(const float* samples, size_t count) {
+    double sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)samples[i] * samples[i];
+    }
+    return count ? sqrt(sum / count) : 0;
+}
+
+inline int16_t clip16(float value) {
+    long rounded = lroundf(value);
+    return rounded > 32767 ? 32767 : (rounded < -32768 ? -32768 : (int16_t)rounded);
+}
+
+// Best of a few runs of fn(), in nanoseconds
+template <typename Fn>
+inline double timeBest(Fn fn, int runs = 5) {
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        uint64_t start = hostNanos();
+        fn();
+        double elapsed = (double)(hostNanos() - start);
+        best = elapsed < best ? elapsed : best;
+    }
+    return best;
+}
+
+#endif
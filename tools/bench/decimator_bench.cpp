@@ -0,0 +1,90 @@
+// Quality and cost of the 16 -> 8 kHz decimator that feeds the wake word ring, at a few filter
+// lengths, next to plain sample dropping. Tones give the passband response and how far tones
+// above the new Nyquist are pushed down when they fold back; cost is per 16 kHz input sample in
+// 256-sample capture blocks.
+//
+//   tools/bench/run.sh decimator_bench
+
+#include "bench_audio.h"
+#include "../../src/audio_config.h"
+#include "../../src/audio_dsp.h"
+
+static const int BLOCK_SIZE = 256;
+static const int FACTOR = AUDIO_WAKE_SEARCH_DECIMATION;
+
+// Output level (dB) of a full-scale/3 tone after decimation; taps = 0 drops samples unfiltered
+static double toneGainDb(int taps, double hz) {
+    size_t length = BENCH_SAMPLE_RATE / BLOCK_SIZE * BLOCK_SIZE;
+    std::vector<int32_t> input(length);
+    for (size_t i = 0; i < length; i++) {
+        input[i] = (int32_t)lround(10000.0 * sin(2.0 * M_PI * hz * i / BENCH_SAMPLE_RATE));
+    }
+    std::vector<int16_t> output(length / FACTOR + BLOCK_SIZE);
+    size_t produced = 0;
+    if (taps > 0) {
+        PolyphaseDecimator decimator(BENCH_SAMPLE_RATE, FACTOR, taps);
+        for (size_t pos = 0; pos < length; pos += BLOCK_SIZE) {
+            produced += decimator.process(&input[pos], BLOCK_SIZE, &output[produced]);
+        }
+    } else {
+        for (size_t i = 0; i < length; i += FACTOR) {
+            output[produced++] = (int16_t)input[i];
+        }
+    }
+    // Skip the filter's start-up
+    double sum = 0;
+    size_t from = produced / 4;
+    for (size_t i = from; i < produced; i++) {
+        sum += (double)output[i] * output[i];
+    }
+    double rms = sqrt(sum / (produced - from));
+    return 20.0 * log10(rms / (10000.0 / M_SQRT2) + 1e-9);
+}
+
+static void runCase(int taps) {
+    double ripple = 0;
+    for (double hz = 100; hz <= AUDIO_WAKE_SEARCH_PASSBAND_HZ; hz += 100) {
+        ripple = max(ripple, fabs(toneGainDb(taps, hz)));
+    }
+    // Tones that fold back into the passband
+    double alias = -200;
+    uint32_t outputRate = BENCH_SAMPLE_RATE / FACTOR;
+    for (double hz = outputRate - AUDIO_WAKE_SEARCH_PASSBAND_HZ; hz < BENCH_SAMPLE_RATE / 2; hz += 100) {
+        alias = max(alias, toneGainDb(taps, hz));
+    }
+
+    std::vector<float> speech = makeSpeech(10.0f, 8000.0f);
+    std::vector<float> noise = makeStreetNoise(10.0f, 800.0f);
+    std::vector<int32_t> input(speech.size() / BLOCK_SIZE * BLOCK_SIZE);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = lroundf(speech[i] + noise[i]);
+    }
+    std::vector<int16_t> output(input.size() / FACTOR + BLOCK_SIZE);
+    double ns = timeBest([&] {
+        if (taps > 0) {
+            PolyphaseDecimator decimator(BENCH_SAMPLE_RATE, FACTOR, taps);
+            size_t produced = 0;
+            for (size_t pos = 0; pos < input.size(); pos += BLOCK_SIZE) {
+                produced += decimator.process(&input[pos], BLOCK_SIZE, &output[produced]);
+            }
+        } else {
+            for (size_t i = 0; i < input.size(); i += FACTOR) {
+                output[i / FACTOR] = (int16_t)input[i];
+            }
+        }
+    });
+
+    char label[16];
+    snprintf(label, sizeof(label), taps > 0 ? "%d taps" : "no filter", taps);
+    printf("  %-9s passband +/-%.2f dB to %u Hz, folded tones %6.1f dB, %5.2f ns/input sample\n", label, ripple,
+           AUDIO_WAKE_SEARCH_PASSBAND_HZ, alias, ns / input.size());
+}
+
+int main() {
+    printf("Wake word decimator %d -> %d Hz, %d-sample blocks (firmware uses %d taps)\n", BENCH_SAMPLE_RATE,
+           BENCH_SAMPLE_RATE / FACTOR, BLOCK_SIZE, AUDIO_WAKE_SEARCH_FILTER_TAPS);
+    for (int taps : {0, 32, 48, 64}) {
+        runCase(taps);
+    }
+    return 0;
+}
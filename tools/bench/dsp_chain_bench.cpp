@@ -0,0 +1,133 @@
+// Capture path cost and output: the old per-sample loop (>> 14, fixed 2x gain, clip) against the
+// DSP chain process_audio() runs now (>> 14, DC blocker, 80 Hz high-pass, AGC, clip), on a quiet
+// talker with the INMP441's DC offset and handling rumble. Block sizes cover what the I2S reads
+// return (a 256-sample DMA buffer, or two when the task was late).
+//
+//   tools/bench/run.sh dsp_chain_bench [speech.wav]
+
+#include "bench_audio.h"
+#include "../../src/audio_config.h"
+#include "../../src/audio_dsp.h"
+
+static const int32_t MIC_DC_OFFSET = 600;     // 16-bit units, typical for the INMP441 here
+
+// Raw 32-bit I2S words as the microphone delivers them
+static std::vector<int32_t> makeRaw(const std::vector<float>& speech) {
+    std::vector<int32_t> raw(speech.size());
+    for (size_t i = 0; i < speech.size(); i++) {
+        float t = (float)i / BENCH_SAMPLE_RATE;
+        float rumble = 400.0f * sinf(2.0f * (float)M_PI * 12.0f * t) + 200.0f * sinf(2.0f * (float)M_PI * 35.0f * t);
+        raw[i] = (int32_t)(speech[i] + rumble + MIC_DC_OFFSET) << 14;
+    }
+    return raw;
+}
+
+static void oldLoop(const int32_t* raw, int count, int16_t* out) {
+    for (int i = 0; i < count; i++) {
+        int32_t sample = raw[i] >> 14;
+        sample *= 2;
+        out[i] = sample > 32767 ? 32767 : (sample < -32768 ? -32768 : sample);
+    }
+}
+
+struct Chain {
+    DcBlocker dcBlocker;
+    HighPassBiquad highPass;
+    AutomaticGainControl agc;
+    AudioDspChain dsp;
+
+    Chain()
+        : highPass(AUDIO_HIGHPASS_HZ, BENCH_SAMPLE_RATE),
+          agc(AUDIO_AGC_TARGET_PEAK, AUDIO_AGC_MIN_GAIN, AUDIO_AGC_MAX_GAIN, AUDIO_AGC_INITIAL_GAIN),
+          dsp(BENCH_SAMPLE_RATE) {
+        dsp.addStage(&dcBlocker);
+        dsp.addStage(&highPass);
+        dsp.addStage(&agc);
+    }
+
+    void process(const int32_t* raw, int count, int16_t* out) {
+        int32_t block[512];
+        for (int i = 0; i < count; i++) {
+            block[i] = raw[i] >> 14;
+        }
+        dsp.process(block, count);
+        for (int i = 0; i < count; i++) {
+            int32_t sample = block[i];
+            out[i] = sample > 32767 ? 32767 : (sample < -32768 ? -32768 : sample);
+        }
+    }
+};
+
+// Amplitude of one frequency over a stretch of samples (Goertzel)
+static double toneLevel(const int16_t* samples, size_t count, double hz) {
+    double coeff = 2.0 * cos(2.0 * M_PI * hz / BENCH_SAMPLE_RATE);
+    double s1 = 0, s2 = 0;
+    for (size_t i = 0; i < count; i++) {
+        double s0 = samples[i] + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return 2.0 * sqrt(s1 * s1 + s2 * s2 - coeff * s1 * s2) / count;
+}
+
+// Mean, rumble relative to the speech level, and peak, over the second half (settled)
+static void describe(const char* label, const std::vector<int16_t>& out) {
+    size_t from = out.size() / 2;
+    size_t n = out.size() - from;
+    double sum = 0, total = 0;
+    int peak = 0;
+    for (size_t i = from; i < out.size(); i++) {
+        sum += out[i];
+        total += (double)out[i] * out[i];
+        peak = max(peak, abs((int)out[i]));
+    }
+    double mean = sum / n;
+    double rms = sqrt(total / n - mean * mean);
+    double rumble = hypot(toneLevel(&out[from], n, 12.0), toneLevel(&out[from], n, 35.0)) / M_SQRT2;
+    printf("  %-10s DC %7.1f, 12+35 Hz rumble %6.1f dB below the AC level, peak %6.1f dBFS\n", label, mean,
+           20.0 * log10(rms / (rumble + 1e-9)), 20.0 * log10(peak / 32768.0 + 1e-9));
+}
+
+int main(int argc, char** argv) {
+    std::vector<float> speech = argc > 1 ? loadWav(argv[1]) : makeSpeech(20.0f, 1500.0f);
+    if (speech.empty()) {
+        fprintf(stderr, "Can't read %s (16-bit PCM WAV expected)\n", argv[1]);
+        return 1;
+    }
+    std::vector<int32_t> raw = makeRaw(speech);
+    std::vector<int16_t> out(raw.size());
+    double seconds = (double)raw.size() / BENCH_SAMPLE_RATE;
+
+    printf("Capture path, %.1f s of audio (%s)\n", seconds, argc > 1 ? argv[1] : "synthetic quiet talker");
+    for (int blockSize : {128, 256, 512}) {
+        size_t blocks = raw.size() / blockSize;
+        double oldNs = timeBest([&] {
+            for (size_t b = 0; b < blocks; b++) {
+                oldLoop(&raw[b * blockSize], blockSize, &out[b * blockSize]);
+            }
+        });
+        double chainNs = timeBest([&] {
+            Chain chain;
+            for (size_t b = 0; b < blocks; b++) {
+                chain.process(&raw[b * blockSize], blockSize, &out[b * blockSize]);
+            }
+        });
+        printf("  %3d-sample blocks: old loop %6.2f ns/sample, chain %6.2f ns/sample (%.1fx)\n", blockSize,
+               oldNs / (blocks * blockSize), chainNs / (blocks * blockSize), chainNs / oldNs);
+    }
+
+    printf("Output (second half)\n");
+    size_t blocks = raw.size() / 256;
+    out.resize(blocks * 256);
+    for (size_t b = 0; b < blocks; b++) {
+        oldLoop(&raw[b * 256], 256, &out[b * 256]);
+    }
+    describe("old loop", out);
+    Chain chain;
+    for (size_t b = 0; b < blocks; b++) {
+        chain.process(&raw[b * 256], 256, &out[b * 256]);
+    }
+    describe("chain", out);
+    printf("  AGC gain %.2f\n", chain.agc.getGain());
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Just enough of the ESP32 Arduino core to build the audio sources in src/ on a desktop for the
+// benches in tools/bench. ESP.getCycleCount() counts host nanoseconds and getCpuFreqMHz()
+// reports 1000, so the sources' own cycle statistics come out in nanoseconds here.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+
+using std::min;
+using std::max;
+
+inline uint64_t hostNanos() {
+    static const auto origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+inline unsigned long millis() { return (unsigned long)(hostNanos() / 1000000); }
+inline unsigned long micros() { return (unsigned long)(hostNanos() / 1000); }
+
+struct HostEsp {
+    uint32_t getCycleCount() { return (uint32_t)hostNanos(); }
+    uint32_t getCpuFreqMHz() { return 1000; }
+};
+inline HostEsp ESP;
+
+// Log output from the sources goes to stderr, so bench results on stdout stay clean
+struct HostSerial {
+    template <typename... Args>
+    void printf(const char* format, Args... args) { fprintf(stderr, format, args...); }
+    void print(const char* text) { fputs(text, stderr); }
+    void println(const char* text = "") { fprintf(stderr, "%s\n", text); }
+};
+inline HostSerial Serial;
+
+inline bool psramFound() { return false; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+
+class Stream {
+public:
+    virtual ~Stream() {}
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual size_t readBytes(char* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length && available() > 0) {
+            buffer[count++] = (char)read();
+        }
+        return count;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+    virtual size_t write(uint8_t) = 0;
+    virtual void flush() {}
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// In-memory stand-in for NVS: blobs live for the life of the bench process
+class Preferences {
+private:
+    static std::map<std::string, std::vector<uint8_t>>& store() {
+        static std::map<std::string, std::vector<uint8_t>> blobs;
+        return blobs;
+    }
+    std::string space;
+
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        space = name;
+        return true;
+    }
+    void end() {}
+
+    size_t getBytes(const char* key, void* buffer, size_t length) {
+        auto it = store().find(space + "/" + key);
+        if (it == store().end() || it->second.size() > length) {
+            return 0;
+        }
+        memcpy(buffer, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+
+    size_t putBytes(const char* key, const void* data, size_t length) {
+        store()[space + "/" + key].assign((const uint8_t*)data, (const uint8_t*)data + length);
+        return length;
+    }
+
+    bool clear() {
+        std::string prefix = space + "/";
+        for (auto it = store().begin(); it != store().end();) {
+            it = it->first.compare(0, prefix.size(), prefix) == 0 ? store().erase(it) : std::next(it);
+        }
+        return true;
+    }
+};
+
+#endif
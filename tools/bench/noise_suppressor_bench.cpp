@@ -0,0 +1,123 @@
+// Noise suppressor CPU and SNR gain. The suppressor learns the background from capture-sized
+// blocks of noise (as process_audio() feeds it while the VAD hears no speech), then cleans a
+// command of speech + the same kind of noise while it is "recorded" block by block. SNR is
+// measured against the clean speech, so speech distortion counts against the result.
+//
+//   tools/bench/run.sh noise_suppressor_bench [street.wav [speech.wav]]
+//
+// Without arguments, synthetic street noise and speech are used. Recordings must be 16 kHz
+// 16-bit PCM; a street recording needs a few seconds of noise beyond the command length.
+
+#include "bench_audio.h"
+#include "../../src/noise_suppressor.h"
+
+static const int BLOCK_SIZE = 256;
+static const float LEARN_SECONDS = 2.0f;
+
+static double snrDb(const std::vector<float>& clean, const int16_t* test, size_t count) {
+    double signal = 0, error = 0;
+    for (size_t i = 0; i < count; i++) {
+        signal += (double)clean[i] * clean[i];
+        error += ((double)test[i] - clean[i]) * ((double)test[i] - clean[i]);
+    }
+    return 10.0 * log10(signal / (error + 1e-9));
+}
+
+// Level of test in the pauses of clean (where the speech is silent), in dB re full scale
+static double pauseLevelDb(const std::vector<float>& clean, const int16_t* test, size_t count) {
+    double sum = 0;
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (fabsf(clean[i]) < 1.0f) {
+            sum += (double)test[i] * test[i];
+            n++;
+        }
+    }
+    return 10.0 * log10((n ? sum / n : 0) / (32768.0 * 32768.0) + 1e-12);
+}
+
+static void runCase(const char* label, const std::vector<float>& speech, const std::vector<float>& noise) {
+    size_t learn = (size_t)(LEARN_SECONDS * BENCH_SAMPLE_RATE);
+    size_t length = min(speech.size(), noise.size() - learn);
+    std::vector<int16_t> noisy(length), pcm(length);
+    for (size_t i = 0; i < length; i++) {
+        noisy[i] = clip16(speech[i] + noise[learn + i]);
+    }
+
+    NoiseSuppressor suppressor;
+    int32_t block[BLOCK_SIZE];
+    for (size_t pos = 0; pos + BLOCK_SIZE <= learn; pos += BLOCK_SIZE) {
+        for (int i = 0; i < BLOCK_SIZE; i++) {
+            block[i] = lroundf(noise[pos + i]);
+        }
+        suppressor.observeBackground(block, BLOCK_SIZE);
+    }
+    if (!suppressor.isReady()) {
+        printf("  %-16s noise estimate not ready after %.1f s\n", label, LEARN_SECONDS);
+        return;
+    }
+
+    double ns = timeBest([&] {
+        pcm = noisy;
+        suppressor.start(pcm.data());
+        for (size_t recorded = BLOCK_SIZE; recorded <= length; recorded += BLOCK_SIZE) {
+            suppressor.process(recorded);
+        }
+        suppressor.finish(length);
+    }, 3);
+
+    double seconds = (double)length / BENCH_SAMPLE_RATE;
+    double snrIn = snrDb(speech, noisy.data(), length);
+    double snrOut = snrDb(speech, pcm.data(), length);
+    printf("  %-16s SNR %5.1f -> %5.1f dB (%+5.1f), pauses %6.1f -> %6.1f dBFS, %.2f ms CPU per s of audio\n",
+           label, snrIn, snrOut, snrOut - snrIn, pauseLevelDb(speech, noisy.data(), length),
+           pauseLevelDb(speech, pcm.data(), length), ns / 1e6 / seconds);
+}
+
+int main(int argc, char** argv) {
+    std::vector<float> street;
+    std::vector<float> speech;
+    if (argc > 1) {
+        uint32_t rate = 0;
+        street = loadWav(argv[1], &rate);
+        if (street.empty() || rate != BENCH_SAMPLE_RATE) {
+            fprintf(stderr, "Can't use %s (16 kHz 16-bit PCM WAV expected)\n", argv[1]);
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        uint32_t rate = 0;
+        speech = loadWav(argv[2], &rate);
+        if (speech.empty() || rate != BENCH_SAMPLE_RATE) {
+            fprintf(stderr, "Can't use %s (16 kHz 16-bit PCM WAV expected)\n", argv[2]);
+            return 1;
+        }
+    } else {
+        speech = makeSpeech(10.0f, 6000.0f);
+    }
+
+    double speechRms = rmsOf(speech.data(), speech.size());
+    printf("Noise suppressor, %.1f s command, %d-sample capture blocks (%s)\n",
+           (double)speech.size() / BENCH_SAMPLE_RATE, BLOCK_SIZE, argc > 1 ? argv[1] : "synthetic street noise");
+    for (float targetSnr : {0.0f, 5.0f, 10.0f, 20.0f}) {
+        std::vector<float> noise;
+        float noiseRms = (float)(speechRms / pow(10.0, targetSnr / 20.0));
+        if (street.empty()) {
+            noise = makeStreetNoise(LEARN_SECONDS + speech.size() / (float)BENCH_SAMPLE_RATE + 1.0f, noiseRms);
+        } else {
+            noise = street;
+            float scale = noiseRms / (float)rmsOf(noise.data(), noise.size());
+            for (float& value : noise) {
+                value *= scale;
+            }
+        }
+        if (noise.size() <= LEARN_SECONDS * BENCH_SAMPLE_RATE) {
+            fprintf(stderr, "Street recording too short\n");
+            return 1;
+        }
+        char label[32];
+        snprintf(label, sizeof(label), "noise at %2.0f dB", targetSnr);
+        runCase(label, speech, noise);
+    }
+    return 0;
+}
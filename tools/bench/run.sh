@@ -0,0 +1,48 @@
+#!/bin/sh
+# Builds and runs a host bench from tools/bench against the firmware sources in src/.
+#
+#   tools/bench/run.sh <bench> [args...]     e.g. tools/bench/run.sh noise_suppressor_bench street.wav
+#   tools/bench/run.sh all                   every bench with its built-in signals
+#
+# Needs a C++17 compiler (CXX, default c++). Timings are host nanoseconds: use them to compare
+# variants, not as ESP32 cycle counts - the firmware's own reports give those.
+set -e
+
+BENCH_DIR=$(cd "$(dirname "$0")" && pwd)
+SRC_DIR="$BENCH_DIR/../../src"
+BUILD_DIR="${BUILD_DIR:-$BENCH_DIR/build}"
+CXX="${CXX:-c++}"
+
+# Firmware sources each bench links against
+sources_for() {
+    case "$1" in
+        dsp_chain_bench) echo "audio_dsp.cpp" ;;
+        decimator_bench) echo "audio_dsp.cpp" ;;
+        adpcm_codec_bench) echo "adpcm_wav_stream.cpp" ;;
+        noise_suppressor_bench) echo "noise_suppressor.cpp real_fft.cpp" ;;
+        wake_word_dtw_bench) echo "wake_word_spotter.cpp mfcc_extractor.cpp voice_activity.cpp real_fft.cpp" ;;
+        *) echo "Unknown bench: $1" >&2; exit 1 ;;
+    esac
+}
+
+run_bench() {
+    name="$1"
+    shift
+    files="$BENCH_DIR/$name.cpp"
+    for source in $(sources_for "$name"); do
+        files="$files $SRC_DIR/$source"
+    done
+    mkdir -p "$BUILD_DIR"
+    # shellcheck disable=SC2086
+    "$CXX" -std=c++17 -O2 -Wall -I"$BENCH_DIR/host" -I"$SRC_DIR" -o "$BUILD_DIR/$name" $files -lm
+    "$BUILD_DIR/$name" "$@"
+}
+
+if [ "$1" = "all" ]; then
+    for name in dsp_chain_bench noise_suppressor_bench wake_word_dtw_bench decimator_bench adpcm_codec_bench; do
+        run_bench "$name"
+        echo
+    done
+else
+    run_bench "$@"
+fi
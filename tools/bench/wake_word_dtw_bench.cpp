@@ -0,0 +1,145 @@
+// Per-frame cost of the personal wake word matcher. A synthetic word is enrolled through the
+// same path the firmware uses (VAD, MFCC, pollEnrollment), then a minute of speech over
+// quiet-room or street noise - with the word dropped in a few times - is fed to addFrame().
+// Only the DTW is timed; the features are computed beforehand and their cost shown separately.
+//
+//   tools/bench/run.sh wake_word_dtw_bench
+
+#include "bench_audio.h"
+#include "../../src/mfcc_extractor.h"
+#include "../../src/voice_activity.h"
+#include "../../src/wake_word_spotter.h"
+
+static const int BLOCK_SIZE = 256;
+static const int INSERTED_WORDS = 5;
+
+// A word of voiced syllables with fixed formants; seed varies pitch and timing slightly, like
+// one speaker repeating it
+static std::vector<float> makeWord(int syllables, float syllableSeconds, uint32_t seed) {
+    static const float FORMANTS[][2] = {{700, 1200}, {400, 2100}, {550, 900}, {300, 2300}};
+    BenchRandom random(seed);
+    std::vector<float> out;
+    for (int s = 0; s < syllables; s++) {
+        size_t length = (size_t)(syllableSeconds * (1.0f + 0.05f * random.uniform()) * BENCH_SAMPLE_RATE);
+        float f0 = 130.0f * (1.0f + 0.03f * random.uniform());
+        double phase = 0;
+        for (size_t i = 0; i < length; i++) {
+            float t = (float)i / length;
+            phase += 2.0 * M_PI * f0 * (1.0f - 0.15f * t) / BENCH_SAMPLE_RATE;
+            float value = 0;
+            for (int k = 1; k * f0 < 3800.0f; k++) {
+                float f = k * f0;
+                value += (1.0f / (1.0f + powf((f - FORMANTS[s % 4][0]) / 120.0f, 2)) +
+                          0.5f / (1.0f + powf((f - FORMANTS[s % 4][1]) / 200.0f, 2))) * sinf((float)(k * phase));
+            }
+            out.push_back(6000.0f * sinf((float)M_PI * t) * value * 0.5f);
+        }
+        out.insert(out.end(), BENCH_SAMPLE_RATE / 25, 0.0f);
+    }
+    return out;
+}
+
+static void add(std::vector<float>& into, size_t at, const std::vector<float>& what) {
+    for (size_t i = 0; i < what.size() && at + i < into.size(); i++) {
+        into[at + i] += what[i];
+    }
+}
+
+// Runs audio through the capture-side feature path; enrollment is polled between blocks the way
+// the audio task does. Returns the features when keep is set.
+struct FeaturePath {
+    VoiceActivityDetector vad;
+    MfccExtractor mfcc;
+    std::vector<int8_t> features;
+    std::vector<uint32_t> ends;
+
+    void feed(const std::vector<float>& audio, WakeWordSpotter* spotter, WakeWordSpotter::EnrollResult* result) {
+        for (size_t pos = 0; pos < audio.size(); pos++) {
+            int16_t sample = clip16(audio[pos]);
+            vad.addSample(sample);
+            if (mfcc.addSample(sample)) {
+                if (spotter) {
+                    spotter->addFrame(mfcc.getFeatures(), vad.getSampleCount());
+                } else {
+                    features.insert(features.end(), mfcc.getFeatures(), mfcc.getFeatures() + MfccExtractor::COEFFS);
+                    ends.push_back(vad.getSampleCount());
+                }
+            }
+            if (spotter && pos % BLOCK_SIZE == BLOCK_SIZE - 1) {
+                WakeWordSpotter::EnrollResult polled = spotter->pollEnrollment(vad, vad.getSampleCount() / 16);
+                if (polled != WakeWordSpotter::EnrollResult::NONE) {
+                    *result = polled;
+                }
+            }
+        }
+    }
+};
+
+static void runCase(int syllables, float syllableSeconds, float noiseRms) {
+    std::vector<float> word = makeWord(syllables, syllableSeconds, 1);
+    float wordSeconds = (float)word.size() / BENCH_SAMPLE_RATE;
+
+    // Enrollment: three repetitions in a quiet room
+    std::vector<float> enrollment = makeStreetNoise(1.0f + WakeWordSpotter::ENROLL_UTTERANCES * (wordSeconds + 1.5f), 30.0f, 7);
+    for (int u = 0; u < WakeWordSpotter::ENROLL_UTTERANCES; u++) {
+        add(enrollment, (size_t)((1.0f + u * (wordSeconds + 1.5f)) * BENCH_SAMPLE_RATE), makeWord(syllables, syllableSeconds, 10 + u));
+    }
+    WakeWordSpotter spotter;
+    spotter.clear();
+    if (!spotter.begin()) {
+        return;
+    }
+    FeaturePath enrollPath;
+    WakeWordSpotter::EnrollResult result = WakeWordSpotter::EnrollResult::NONE;
+    size_t prompt = BENCH_SAMPLE_RATE / 2;
+    enrollPath.feed(std::vector<float>(enrollment.begin(), enrollment.begin() + prompt), &spotter, &result);
+    spotter.startEnrollment(enrollPath.vad.getSampleCount(), enrollPath.vad.getSampleCount() / 16);
+    enrollPath.feed(std::vector<float>(enrollment.begin() + prompt, enrollment.end()), &spotter, &result);
+    if (!spotter.isEnrolled()) {
+        printf("  %.2f s word: enrollment failed (result %d)\n", wordSeconds, (int)result);
+        return;
+    }
+
+    // A minute of talk over background noise with the word dropped in
+    std::vector<float> stream = makeSpeech(60.0f, 5000.0f, 3);
+    std::vector<float> noise = makeStreetNoise(60.0f, noiseRms, 4);
+    add(stream, 0, noise);
+    for (int w = 0; w < INSERTED_WORDS; w++) {
+        size_t at = (size_t)((5.0f + w * 11.0f) * BENCH_SAMPLE_RATE);
+        std::fill(stream.begin() + at - BENCH_SAMPLE_RATE / 2, stream.begin() + at + word.size() + BENCH_SAMPLE_RATE / 2, 0.0f);
+        add(stream, at - BENCH_SAMPLE_RATE / 2, std::vector<float>(noise.begin(), noise.begin() + word.size() + BENCH_SAMPLE_RATE));
+        add(stream, at, makeWord(syllables, syllableSeconds, 20 + w));
+    }
+
+    FeaturePath streamPath;
+    double mfccNs = timeBest([&] {
+        streamPath = FeaturePath();
+        streamPath.feed(stream, nullptr, nullptr);
+    }, 3);
+    size_t frames = streamPath.ends.size();
+
+    int detections = 0;
+    uint64_t start = hostNanos();
+    for (size_t f = 0; f < frames; f++) {
+        spotter.addFrame(&streamPath.features[f * MfccExtractor::COEFFS], streamPath.ends[f]);
+        if (spotter.takeDetection()) {
+            detections++;
+        }
+    }
+    double dtwNs = (double)(hostNanos() - start);
+
+    printf("  %.2f s word, %3d template frames, noise RMS %3.0f: DTW %6.0f ns/frame (%.3f%% of a 10 ms frame), "
+           "MFCC %6.0f ns/frame; %d of %d inserted words detected\n",
+           wordSeconds, spotter.getTemplateFrames(), noiseRms, dtwNs / frames, dtwNs / frames / 1e5,
+           mfccNs / frames, detections, INSERTED_WORDS);
+}
+
+int main() {
+    printf("Personal wake word matcher, 60 s stream, one frame per 10 ms\n");
+    for (float noiseRms : {30.0f, 300.0f}) {
+        runCase(2, 0.18f, noiseRms);
+        runCase(2, 0.3f, noiseRms);
+        runCase(3, 0.3f, noiseRms);
+    }
+    return 0;
+}
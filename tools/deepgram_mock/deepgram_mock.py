@@ -0,0 +1,254 @@
+"""Local stand-in for the Deepgram /v1/listen and /v1/speak HTTP endpoints.
+
+Serves the wake word search, command transcription and TTS paths of the
+firmware (or any HTTP client) on a PC, with the network misbehaving on purpose:
+
+  --latency-ms N        wait N ms before the response head (server "think" time)
+  --throttle-kbps N     read request bodies and write responses at N kbit/s
+  --chunked             send responses with Transfer-Encoding: chunked, like
+                        Deepgram's streamed TTS (--chunk-bytes per chunk)
+  --error-rate F        answer a fraction F of requests with --error-status
+  --drop-rate F         close the connection without answering a fraction F
+  --idle-timeout-s N    close kept-alive connections idle for N s, so the
+                        client's next request finds a stale socket
+  --seed N              error/drop choices and search confidences repeat per seed
+
+/v1/listen takes WAV (16-bit PCM or IMA-ADPCM) and answers in Deepgram's
+response shape: a fixed --transcript, and for each search= query one hit with
+--search-confidence (queries listed in --miss never hit). /v1/speak answers
+with 16 kHz linear16 audio, --speak-ms-per-char long, in a WAV container unless
+the URL asks for container=none.
+
+To point the firmware at it, set in src/deepgram_config.h:
+    DEEPGRAM_BASE_URL = "http://<this machine's IP>:8080"
+
+    python tools/deepgram_mock/deepgram_mock.py [--port 8080] [--latency-ms 300] [--throttle-kbps 500]
+
+Each request logs its size and how long the upload, the wait and the download took.
+"""
+
+import argparse
+import json
+import math
+import random
+import struct
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+SPEAK_SAMPLE_RATE = 16000
+
+
+def wav_seconds(body):
+    """Audio length from the WAV header (fmt byte rate, data size); 0 if it isn't a WAV."""
+    if len(body) < 12 or body[:4] != b"RIFF" or body[8:12] != b"WAVE":
+        return 0.0
+    offset = 12
+    byte_rate = 0
+    while offset + 8 <= len(body):
+        chunk_id, size = body[offset:offset + 4], struct.unpack("<I", body[offset + 4:offset + 8])[0]
+        if chunk_id == b"fmt ":
+            byte_rate = struct.unpack("<I", body[offset + 16:offset + 20])[0]
+        elif chunk_id == b"data":
+            return min(size, len(body) - offset - 8) / byte_rate if byte_rate else 0.0
+        offset += 8 + size + (size & 1)
+    return 0.0
+
+
+def wav_header(data_size):
+    return struct.pack("<4sI4s4sIHHIIHH4sI", b"RIFF", 36 + data_size, b"WAVE", b"fmt ", 16, 1, 1,
+                       SPEAK_SAMPLE_RATE, SPEAK_SAMPLE_RATE * 2, 2, 16, b"data", data_size)
+
+
+def speech_like_pcm(seconds):
+    """A quiet 220 Hz tone with a syllable-rate envelope - audible, but nothing like a real voice."""
+    samples = int(seconds * SPEAK_SAMPLE_RATE)
+    out = bytearray(samples * 2)
+    for i in range(samples):
+        t = i / SPEAK_SAMPLE_RATE
+        envelope = 0.5 - 0.5 * math.cos(2 * math.pi * 4 * t)
+        struct.pack_into("<h", out, i * 2, int(6000 * envelope * math.sin(2 * math.pi * 220 * t)))
+    return bytes(out)
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.requests = 0
+        self.connections = 0
+
+
+class MockHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"       # Keep-alive, like api.deepgram.com
+    options = None
+    rng = None
+    stats = None
+
+    def setup(self):
+        super().setup()
+        with self.stats.lock:
+            self.stats.connections += 1
+            self.connection_number = self.stats.connections
+        self.served = 0
+
+    def log_message(self, format, *args):
+        pass  # One summary line per request instead
+
+    def log(self, text):
+        print("[%s conn %d #%d] %s" % (time.strftime("%H:%M:%S"), self.connection_number, self.served, text), flush=True)
+
+    def throttled_read(self, length):
+        kbps = self.options.throttle_kbps
+        data = bytearray()
+        started = time.monotonic()
+        while len(data) < length:
+            piece = self.rfile.read(min(4096, length - len(data)))
+            if not piece:
+                break
+            data += piece
+            if kbps:
+                ahead = len(data) * 8 / (kbps * 1000.0) - (time.monotonic() - started)
+                if ahead > 0:
+                    time.sleep(ahead)
+        return bytes(data)
+
+    def throttled_write(self, data, started):
+        kbps = self.options.throttle_kbps
+        self.wfile.write(data)
+        if kbps:
+            self.sent_bytes += len(data)
+            ahead = self.sent_bytes * 8 / (kbps * 1000.0) - (time.monotonic() - started)
+            if ahead > 0:
+                time.sleep(ahead)
+
+    def choose(self):
+        """None to answer normally, else 'drop' or 'error' (decided under the lock so seeds repeat)."""
+        with self.stats.lock:
+            self.stats.requests += 1
+            roll = self.rng.random()
+        if roll < self.options.drop_rate:
+            return "drop"
+        if roll < self.options.drop_rate + self.options.error_rate:
+            return "error"
+        return None
+
+    def do_POST(self):
+        self.served += 1
+        started = time.monotonic()
+        url = urlparse(self.path)
+        query = parse_qs(url.query)
+        body = self.throttled_read(int(self.headers.get("Content-Length", 0)))
+        uploaded = time.monotonic()
+
+        if url.path == "/v1/listen":
+            content_type, payload = self.listen_response(body, query)
+        elif url.path == "/v1/speak":
+            content_type, payload = self.speak_response(body, query)
+        else:
+            self.send_error(404, "Unknown endpoint")
+            return
+
+        outcome = self.choose()
+        time.sleep(self.options.latency_ms / 1000.0)
+        if outcome == "drop":
+            self.log("%s: %d bytes in, dropped the connection" % (url.path, len(body)))
+            self.close_connection = True
+            return
+        if outcome == "error":
+            content_type = "application/json"
+            payload = json.dumps({"err_code": "MOCK_ERROR", "err_msg": "Injected by deepgram_mock"}).encode()
+            status = self.options.error_status
+        else:
+            status = 200
+
+        self.send_response(status)
+        self.send_header("Content-Type", content_type)
+        chunked = self.options.chunked and status == 200
+        if chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+        else:
+            self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        responded = time.monotonic()
+
+        self.sent_bytes = 0
+        if chunked:
+            size = self.options.chunk_bytes
+            for offset in range(0, len(payload), size):
+                piece = payload[offset:offset + size]
+                self.throttled_write(b"%x\r\n" % len(piece) + piece + b"\r\n", responded)
+            self.wfile.write(b"0\r\n\r\n")
+        else:
+            self.throttled_write(payload, responded)
+        self.wfile.flush()
+        finished = time.monotonic()
+        self.log("%s: HTTP %d, %d bytes in (upload %.0f ms), %d bytes out (first byte after %.0f ms, body %.0f ms)" % (
+            url.path, status, len(body), (uploaded - started) * 1000, len(payload),
+            (responded - uploaded) * 1000, (finished - responded) * 1000))
+
+    def listen_response(self, body, query):
+        seconds = wav_seconds(body)
+        searches = []
+        for term in query.get("search", []):
+            with self.stats.lock:
+                jitter = self.rng.uniform(-0.02, 0.02)
+            hits = []
+            if term.lower() not in self.options.miss:
+                hits.append({"confidence": round(min(1.0, self.options.search_confidence + jitter), 3),
+                             "start": round(seconds * 0.2, 2), "end": round(seconds * 0.6, 2), "snippet": term})
+            searches.append({"query": term, "hits": hits})
+        channel = {"alternatives": [{"transcript": self.options.transcript, "confidence": 0.98, "words": []}]}
+        if searches:
+            channel["search"] = searches
+        response = {"metadata": {"request_id": "mock", "duration": round(seconds, 3), "channels": 1},
+                    "results": {"channels": [channel]}}
+        return "application/json", json.dumps(response).encode()
+
+    def speak_response(self, body, query):
+        try:
+            text = json.loads(body or b"{}").get("text", "")
+        except ValueError:
+            text = ""
+        seconds = max(0.2, len(text) * self.options.speak_ms_per_char / 1000.0)
+        pcm = speech_like_pcm(seconds)
+        if query.get("container", ["wav"])[0] == "none":
+            return "audio/l16", pcm
+        return "audio/wav", wav_header(len(pcm)) + pcm
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--latency-ms", type=float, default=0.0)
+    parser.add_argument("--throttle-kbps", type=float, default=0.0, help="0: unthrottled")
+    parser.add_argument("--chunked", action="store_true")
+    parser.add_argument("--chunk-bytes", type=int, default=4096)
+    parser.add_argument("--error-rate", type=float, default=0.0)
+    parser.add_argument("--error-status", type=int, default=503)
+    parser.add_argument("--drop-rate", type=float, default=0.0)
+    parser.add_argument("--idle-timeout-s", type=float, default=0.0, help="0: keep connections open")
+    parser.add_argument("--transcript", default="what is in front of me")
+    parser.add_argument("--search-confidence", type=float, default=0.9)
+    parser.add_argument("--miss", action="append", default=[], help="search term that never hits (repeatable)")
+    parser.add_argument("--speak-ms-per-char", type=float, default=60.0)
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+    args.miss = [term.lower() for term in args.miss]
+
+    MockHandler.options = args
+    MockHandler.rng = random.Random(args.seed)
+    MockHandler.stats = Stats()
+    if args.idle_timeout_s:
+        MockHandler.timeout = args.idle_timeout_s
+    server = ThreadingHTTPServer((args.host, args.port), MockHandler)
+    print("Deepgram mock listening on %s:%d" % (args.host, args.port), flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,270 @@
+"""Local stand-in for the Gemini Live BidiGenerateContent WebSocket.
+
+Lets the firmware (or replay.py) run the vision and tool-call path without
+generativelanguage.googleapis.com. It accepts the setup message, client_content
+turns and realtimeInput (frames, activityStart/End, audio chunks) and answers
+with the scripted toolCall / serverContent messages of a scenario file after
+fixed delays, so every run sees the same server behaviour.
+
+Per connection it reports what the device sent and how fast it acted:
+  - frames/s and message sizes in both directions
+  - command -> toolResponse: a voice command (text or audio) to the device's
+    answer for the toolCall it triggered, i.e. the scripted delay plus the
+    device's own handling
+  - toolCall -> toolResponse: the device's handling alone
+
+To point the firmware at it, set in src/gemini_config.h:
+    WS_HOST = "<this machine's IP>", WS_PORT = 8765, WS_USE_SSL = false
+
+    python tools/gemini_standin/gemini_standin.py [--port 8765]
+        [--scenario tools/gemini_standin/scenarios/default.json]
+        [--record session.jsonl] [--report-s 30]
+
+--record appends every message (both directions, with timestamps) to a JSONL
+file that replay.py can play back against this server or the real API.
+"""
+
+import argparse
+import asyncio
+import copy
+import json
+import os
+import time
+
+import wsproto
+from stats import Latencies, MessageSizes
+
+DEFAULT_SCENARIO = os.path.join(os.path.dirname(os.path.abspath(__file__)), "scenarios", "default.json")
+COMMAND_PREFIX = "USER VOICE COMMAND: "
+
+
+def fill(template, values):
+    """Copy of a reply template with {placeholders} in its strings filled in."""
+    if isinstance(template, dict):
+        return {key: fill(value, values) for key, value in template.items()}
+    if isinstance(template, list):
+        return [fill(value, values) for value in template]
+    if isinstance(template, str):
+        for key, value in values.items():
+            template = template.replace("{%s}" % key, str(value))
+    return template
+
+
+class Session:
+    def __init__(self, server, ws, number):
+        self.server = server
+        self.ws = ws
+        self.number = number
+        self.started = time.monotonic()
+        self.send_lock = asyncio.Lock()
+        self.received = MessageSizes()
+        self.sent = MessageSizes()
+        self.frames = 0
+        self.frame_events = 0
+        self.next_call_id = 0
+        self.calls = {}                 # Call id -> (sent at, command received at or None)
+        self.handling = Latencies()     # toolCall -> toolResponse
+        self.command_to_action = Latencies()
+        self.setup_at = None
+        self.in_activity = False
+        self.activity_audio_bytes = 0
+        self.activity_started = None
+
+    def elapsed_ms(self):
+        return (time.monotonic() - self.started) * 1000.0
+
+    def log(self, text):
+        print("[conn %d %7.1f s] %s" % (self.number, self.elapsed_ms() / 1000.0, text), flush=True)
+
+    async def send(self, message, command_at=None):
+        calls = message.get("toolCall", {}).get("functionCalls", [])
+        for call in calls:
+            if "id" not in call:
+                self.next_call_id += 1
+                call["id"] = "standin-%d-%d" % (self.number, self.next_call_id)
+        text = json.dumps(message)
+        async with self.send_lock:
+            await self.ws.send(text)
+        now = time.monotonic()
+        for call in calls:
+            self.calls[call["id"]] = (now, command_at)
+        self.sent.record(len(text))
+        self.server.record(self, "out", text)
+
+    async def reply_later(self, delay_ms, messages, values, command_at):
+        await asyncio.sleep(delay_ms / 1000.0)
+        for message in messages:
+            try:
+                await self.send(fill(copy.deepcopy(message), values), command_at)
+            except wsproto.ConnectionClosed:
+                return
+
+    def trigger(self, event, values, command_at=None):
+        if event == "frame":
+            self.frame_events += 1
+        for rule in self.server.scenario.get("rules", []):
+            if rule.get("on") != event:
+                continue
+            every = rule.get("every", 1)
+            if event == "frame" and self.frame_events % every != 0:
+                continue
+            asyncio.ensure_future(self.reply_later(rule.get("delay_ms", 0), rule.get("reply", []), values, command_at))
+
+    async def handle_setup(self, setup):
+        handle = setup.get("sessionResumption", {}).get("handle")
+        self.log("setup: model %s, %s" % (setup.get("model"), "resuming %s" % handle if handle else "new session"))
+        scenario = self.server.scenario
+        await asyncio.sleep(scenario.get("setup_delay_ms", 0) / 1000.0)
+        await self.send({"setupComplete": {}})
+        self.setup_at = time.monotonic()
+        if scenario.get("resumable", True):
+            await self.send({"sessionResumptionUpdate": {"newHandle": "standin-%d" % self.number, "resumable": True}})
+        go_away = scenario.get("go_away_after_s", 0)
+        if go_away:
+            asyncio.ensure_future(self.go_away_later(go_away))
+
+    async def go_away_later(self, seconds):
+        await asyncio.sleep(seconds)
+        if self.ws.closed:
+            return
+        self.log("sending goAway")
+        await self.send({"goAway": {"timeLeft": "5s"}})
+        await asyncio.sleep(5)
+        await self.ws.close(1001, "goAway")
+
+    def handle_client_content(self, content):
+        parts = [part for turn in content.get("turns", []) for part in turn.get("parts", [])]
+        command = None
+        for part in parts:
+            text = part.get("text", "")
+            if text.startswith(COMMAND_PREFIX):
+                command = text[len(COMMAND_PREFIX):]
+        if any("inline_data" in part or "inlineData" in part for part in parts):
+            self.frames += 1
+        if command is not None:
+            self.log("command: %s" % command)
+            self.trigger("command", {"command": command}, time.monotonic())
+        else:
+            self.trigger("frame", {})
+
+    def handle_realtime_input(self, realtime):
+        if "activityStart" in realtime:
+            self.in_activity = True
+            self.activity_audio_bytes = 0
+            self.activity_started = time.monotonic()
+        if "video" in realtime:
+            self.frames += 1
+            if not self.in_activity:
+                self.trigger("frame", {})
+        if "audio" in realtime:
+            self.activity_audio_bytes += len(realtime["audio"].get("data", "")) * 3 // 4
+        if "activityEnd" in realtime and self.in_activity:
+            self.in_activity = False
+            seconds = self.activity_audio_bytes / 32000.0
+            upload_ms = (time.monotonic() - self.activity_started) * 1000.0
+            self.log("audio command: %.1f s of audio uploaded in %.0f ms" % (seconds, upload_ms))
+            self.trigger("audio_command", {"audio_seconds": "%.1f" % seconds}, time.monotonic())
+
+    def handle_tool_response(self, response):
+        now = time.monotonic()
+        for answer in response.get("functionResponses", []):
+            call = self.calls.pop(answer.get("id"), None)
+            if not call:
+                self.log("toolResponse for unknown call %s" % answer.get("id"))
+                continue
+            sent_at, command_at = call
+            self.handling.record((now - sent_at) * 1000.0)
+            if command_at is not None:
+                self.command_to_action.record((now - command_at) * 1000.0)
+
+    async def handle(self, text):
+        self.received.record(len(text))
+        self.server.record(self, "in", text)
+        try:
+            message = json.loads(text)
+        except ValueError:
+            self.log("unparseable message (%d bytes)" % len(text))
+            return
+        if "setup" in message:
+            asyncio.ensure_future(self.handle_setup(message["setup"]))
+        for key in ("client_content", "clientContent"):
+            if key in message:
+                self.handle_client_content(message[key])
+        if "realtimeInput" in message:
+            self.handle_realtime_input(message["realtimeInput"])
+        if "toolResponse" in message:
+            self.handle_tool_response(message["toolResponse"])
+
+    def report(self):
+        seconds = max(self.elapsed_ms() / 1000.0, 0.001)
+        self.log("frames %.2f/s (%d) | in: %s | out: %s | command->toolResponse %s | toolCall->toolResponse %s | "
+                 "%d calls unanswered" % (self.frames / seconds, self.frames, self.received.describe(),
+                                          self.sent.describe(), self.command_to_action.describe(),
+                                          self.handling.describe(), len(self.calls)))
+
+
+class StandinServer:
+    def __init__(self, scenario, record_path, report_s):
+        self.scenario = scenario
+        self.record_file = open(record_path, "a", encoding="utf-8") if record_path else None
+        self.report_s = report_s
+        self.connections = 0
+
+    def record(self, session, direction, text):
+        if self.record_file:
+            entry = {"conn": session.number, "t_ms": round(session.elapsed_ms(), 1), "dir": direction, "msg": text}
+            self.record_file.write(json.dumps(entry) + "\n")
+            self.record_file.flush()
+
+    async def periodic_report(self, session):
+        while not session.ws.closed:
+            await asyncio.sleep(self.report_s)
+            if not session.ws.closed:
+                session.report()
+
+    async def serve(self, reader, writer):
+        accepted = await wsproto.server_handshake(reader, writer)
+        if not accepted:
+            return
+        ws, path = accepted
+        self.connections += 1
+        session = Session(self, ws, self.connections)
+        session.log("connected from %s, path %s" % (writer.get_extra_info("peername"), path.split("?")[0]))
+        reporter = asyncio.ensure_future(self.periodic_report(session))
+        try:
+            while True:
+                opcode, payload = await ws.receive()
+                if opcode == wsproto.OP_TEXT:
+                    await session.handle(payload.decode("utf-8", "replace"))
+        except wsproto.ConnectionClosed:
+            pass
+        finally:
+            reporter.cancel()
+            session.log("disconnected")
+            session.report()
+            writer.close()
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--scenario", default=DEFAULT_SCENARIO)
+    parser.add_argument("--record", help="append every message to this JSONL file")
+    parser.add_argument("--report-s", type=float, default=30.0, help="seconds between per-connection reports")
+    args = parser.parse_args()
+
+    with open(args.scenario, encoding="utf-8") as f:
+        scenario = json.load(f)
+    standin = StandinServer(scenario, args.record, args.report_s)
+    server = await asyncio.start_server(standin.serve, args.host, args.port)
+    print("Gemini stand-in listening on %s:%d (scenario %s)" % (args.host, args.port, args.scenario), flush=True)
+    async with server:
+        await server.serve_forever()
+
+
+if __name__ == "__main__":
+    try:
+        asyncio.run(main())
+    except KeyboardInterrupt:
+        pass
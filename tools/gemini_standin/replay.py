@@ -0,0 +1,263 @@
+"""Replay harness for the Gemini Live path: drives a session the way the firmware does.
+
+Plays the device side of a session against gemini_standin.py (or any Live API
+endpoint) and measures it deterministically on a PC:
+  - setup -> setupComplete time
+  - frames/s actually sent and message sizes in both directions
+  - command -> toolCall latency for text and audio voice commands
+Tool calls are answered with a toolResponse after --action-ms, standing in for
+the device's handling.
+
+Two sources of traffic:
+  synthetic (default)  setup built from prompts/, a JPEG-sized frame every
+                       --frame-interval s, a voice command every --command-every s
+                       (as text, or as 16 kHz PCM chunks with --audio-commands)
+  --recording FILE     the device messages of a session recorded with
+                       gemini_standin.py --record, sent at their recorded times
+                       (recorded toolResponses are skipped - live calls are answered)
+
+    python tools/gemini_standin/replay.py [--url ws://127.0.0.1:8765/] [--duration 60]
+    python tools/gemini_standin/replay.py --recording session.jsonl --conn 1
+
+A toolCall counts as the answer to the oldest open command unless it is a
+systemAction with a frame-driven intent (obstacle_alert, contextual_assistance, log).
+"""
+
+import argparse
+import asyncio
+import base64
+import json
+import os
+import random
+import time
+from urllib.parse import urlparse
+
+import wsproto
+from stats import Latencies, MessageSizes
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+FRAME_INTENTS = ("obstacle_alert", "contextual_assistance", "log")
+AUDIO_CHUNK_BYTES = 16000       # VisionAssistant::AUDIO_INPUT_CHUNK_BYTES
+
+
+def synthetic_setup():
+    with open(os.path.join(PROJECT_DIR, "prompts", "tools.json"), encoding="utf-8") as f:
+        tools = json.load(f)
+    with open(os.path.join(PROJECT_DIR, "prompts", "system_prompt.txt"), encoding="utf-8") as f:
+        prompt = f.read()
+    return {"setup": {
+        "model": "models/gemini-2.5-flash-live-preview",
+        "generationConfig": {"responseModalities": ["TEXT"], "mediaResolution": "MEDIA_RESOLUTION_LOW"},
+        "realtimeInputConfig": {"automaticActivityDetection": {"disabled": True}},
+        "sessionResumption": {},
+        "tools": [tools],
+        "systemInstruction": {"parts": [{"text": prompt}]}}}
+
+
+class Replay:
+    def __init__(self, ws, action_ms):
+        self.ws = ws
+        self.action_ms = action_ms
+        self.started = time.monotonic()
+        self.sent = MessageSizes()
+        self.received = MessageSizes()
+        self.frames = 0
+        self.open_commands = []         # Send times of commands not yet answered
+        self.command_latency = Latencies()
+        self.setup_sent_at = None
+        self.setup_ms = None
+        self.tool_calls = 0
+        self.ready = asyncio.Event()
+
+    def log(self, text):
+        print("[%7.1f s] %s" % (time.monotonic() - self.started, text), flush=True)
+
+    async def send(self, message):
+        text = message if isinstance(message, str) else json.dumps(message)
+        await self.ws.send(text)
+        self.sent.record(len(text))
+
+    async def send_setup(self, message):
+        self.setup_sent_at = time.monotonic()
+        await self.send(message)
+
+    async def send_frame(self, jpeg):
+        data = base64.b64encode(jpeg).decode()
+        await self.send({"client_content": {"turn_complete": True, "turns": [{"role": "user", "parts": [
+            {"text": "GPS location not available. "},
+            {"inline_data": {"mime_type": "image/jpeg", "data": data}}]}]}})
+        self.frames += 1
+
+    async def send_command(self, command, jpeg):
+        data = base64.b64encode(jpeg).decode()
+        self.open_commands.append(time.monotonic())
+        await self.send({"client_content": {"turn_complete": True, "turns": [{"role": "user", "parts": [
+            {"text": "GPS location not available. "},
+            {"text": "USER VOICE COMMAND: " + command},
+            {"inline_data": {"mime_type": "image/jpeg", "data": data}}]}]}})
+        self.frames += 1
+
+    async def send_audio_command(self, pcm, jpeg):
+        # Same message sequence as VisionAssistant::sendAudioCommand
+        await self.send({"realtimeInput": {"activityStart": {}}})
+        await self.send({"realtimeInput": {"video": {"mimeType": "image/jpeg", "data": base64.b64encode(jpeg).decode()}}})
+        self.frames += 1
+        for offset in range(0, len(pcm), AUDIO_CHUNK_BYTES):
+            chunk = base64.b64encode(pcm[offset:offset + AUDIO_CHUNK_BYTES]).decode()
+            await self.send({"realtimeInput": {"audio": {"mimeType": "audio/pcm;rate=16000", "data": chunk}}})
+        self.open_commands.append(time.monotonic())
+        await self.send({"realtimeInput": {"activityEnd": {}}})
+
+    async def answer(self, calls):
+        await asyncio.sleep(self.action_ms / 1000.0)
+        responses = [{"id": call.get("id"), "name": call.get("name"), "response": {"result": "ok"}} for call in calls]
+        try:
+            await self.send({"toolResponse": {"functionResponses": responses}})
+        except wsproto.ConnectionClosed:
+            pass
+
+    async def receive_loop(self):
+        try:
+            await self.receive_messages()
+        except wsproto.ConnectionClosed:
+            self.log("server closed the connection")
+
+    async def receive_messages(self):
+        while True:
+            opcode, payload = await self.ws.receive()
+            self.received.record(len(payload))
+            if opcode != wsproto.OP_TEXT:
+                continue
+            message = json.loads(payload)
+            if "setupComplete" in message:
+                self.setup_ms = (time.monotonic() - self.setup_sent_at) * 1000.0
+                self.log("setupComplete after %.0f ms" % self.setup_ms)
+                self.ready.set()
+            if "goAway" in message:
+                self.log("goAway (time left %s)" % message["goAway"].get("timeLeft"))
+            calls = message.get("toolCall", {}).get("functionCalls", [])
+            if calls:
+                self.tool_calls += len(calls)
+                intents = [call.get("args", {}).get("intent") for call in calls]
+                if self.open_commands and not all(intent in FRAME_INTENTS for intent in intents):
+                    self.command_latency.record((time.monotonic() - self.open_commands.pop(0)) * 1000.0)
+                asyncio.ensure_future(self.answer(calls))
+
+    def report(self):
+        seconds = max(time.monotonic() - self.started, 0.001)
+        print("Replay: %.1f s, setup %s, frames %.2f/s (%d)" % (
+            seconds, "%.0f ms" % self.setup_ms if self.setup_ms is not None else "never completed",
+            self.frames / seconds, self.frames))
+        print("  sent:     %s" % self.sent.describe())
+        print("  received: %s, %d tool calls" % (self.received.describe(), self.tool_calls))
+        print("  command -> toolCall: %s, %d unanswered" % (self.command_latency.describe(), len(self.open_commands)))
+
+
+async def run_synthetic(replay, args):
+    rng = random.Random(args.seed)
+    jpeg = bytes(rng.getrandbits(8) for _ in range(args.frame_bytes))
+    pcm = bytes(int(args.audio_seconds * 32000))
+    await replay.send_setup(synthetic_setup())
+    await asyncio.wait_for(replay.ready.wait(), 10)
+
+    start = time.monotonic()
+    next_frame = start
+    next_command = start + args.command_every if args.command_every > 0 else None
+    commands = 0
+    while time.monotonic() - start < args.duration:
+        now = time.monotonic()
+        if next_command is not None and now >= next_command:
+            commands += 1
+            if args.audio_commands:
+                await replay.send_audio_command(pcm, jpeg)
+            else:
+                await replay.send_command("%s %d" % (args.command, commands), jpeg)
+            next_command += args.command_every
+            next_frame = time.monotonic() + args.frame_interval  # A command restarts the frame cadence
+        elif now >= next_frame:
+            await replay.send_frame(jpeg)
+            next_frame += args.frame_interval
+        wake = min(next_frame, next_command) if next_command is not None else next_frame
+        await asyncio.sleep(max(0.0, min(wake - time.monotonic(), 0.05)))
+
+
+async def run_recording(replay, args):
+    entries = []
+    with open(args.recording, encoding="utf-8") as f:
+        for line in f:
+            entry = json.loads(line)
+            if entry["dir"] == "in" and (args.conn is None or entry["conn"] == args.conn):
+                entries.append(entry)
+    if not entries:
+        raise SystemExit("No device messages in %s" % args.recording)
+
+    start = time.monotonic()
+    first_ms = entries[0]["t_ms"]
+    for entry in entries:
+        delay = (entry["t_ms"] - first_ms) / 1000.0 - (time.monotonic() - start)
+        if delay > 0:
+            await asyncio.sleep(delay)
+        text = entry["msg"]
+        message = json.loads(text)
+        if "toolResponse" in message:
+            continue
+        if "setup" in message:
+            await replay.send_setup(text)
+            await asyncio.wait_for(replay.ready.wait(), 10)
+            continue
+        content = message.get("client_content") or message.get("clientContent") or {}
+        parts = [part for turn in content.get("turns", []) for part in turn.get("parts", [])]
+        if any(part.get("text", "").startswith("USER VOICE COMMAND: ") for part in parts):
+            replay.open_commands.append(time.monotonic())
+        if any("inline_data" in part or "inlineData" in part for part in parts):
+            replay.frames += 1
+        realtime = message.get("realtimeInput", {})
+        if "video" in realtime:
+            replay.frames += 1
+        if "activityEnd" in realtime:
+            replay.open_commands.append(time.monotonic())
+        await replay.send(text)
+    await asyncio.sleep(args.settle)
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--url", default="ws://127.0.0.1:8765/", help="ws:// or wss:// endpoint, path included")
+    parser.add_argument("--recording", help="JSONL session from gemini_standin.py --record")
+    parser.add_argument("--conn", type=int, help="connection number to replay from the recording")
+    parser.add_argument("--duration", type=float, default=60.0)
+    parser.add_argument("--frame-interval", type=float, default=2.0, help="VisionAssistant::FRAME_INTERVAL in s")
+    parser.add_argument("--frame-bytes", type=int, default=12000, help="JPEG size (low resolution QVGA is ~8-15 KB)")
+    parser.add_argument("--command-every", type=float, default=10.0, help="seconds between voice commands (0: none)")
+    parser.add_argument("--command", default="what is in front of me")
+    parser.add_argument("--audio-commands", action="store_true", help="send commands as PCM realtimeInput")
+    parser.add_argument("--audio-seconds", type=float, default=3.0)
+    parser.add_argument("--action-ms", type=float, default=20.0, help="simulated device handling before a toolResponse")
+    parser.add_argument("--settle", type=float, default=3.0, help="seconds to wait for replies after a recording")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    url = urlparse(args.url)
+    secure = url.scheme == "wss"
+    path = url.path or "/"
+    if url.query:
+        path += "?" + url.query
+    ws = await wsproto.connect(url.hostname, url.port or (443 if secure else 80), path, secure)
+    replay = Replay(ws, args.action_ms)
+    receiver = asyncio.ensure_future(replay.receive_loop())
+    try:
+        if args.recording:
+            await run_recording(replay, args)
+        else:
+            await run_synthetic(replay, args)
+            await asyncio.sleep(args.settle)
+    except wsproto.ConnectionClosed:
+        replay.log("stopped: the connection closed (the replay doesn't reconnect)")
+    finally:
+        receiver.cancel()
+        await ws.close()
+        replay.report()
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -0,0 +1,36 @@
+"""Counters shared by the Gemini stand-in server and the replay harness."""
+
+
+class MessageSizes:
+    def __init__(self):
+        self.count = 0
+        self.total = 0
+        self.max = 0
+
+    def record(self, size):
+        self.count += 1
+        self.total += size
+        self.max = max(self.max, size)
+
+    def describe(self):
+        if not self.count:
+            return "none"
+        return "%d msgs, avg %d B, max %d B" % (self.count, self.total // self.count, self.max)
+
+
+class Latencies:
+    def __init__(self):
+        self.samples = []
+
+    def record(self, ms):
+        self.samples.append(ms)
+
+    def percentile(self, fraction):
+        ordered = sorted(self.samples)
+        return ordered[min(len(ordered) - 1, int(fraction * len(ordered)))]
+
+    def describe(self):
+        if not self.samples:
+            return "no samples"
+        return "p50 %.0f ms / p90 %.0f ms / max %.0f ms (%d)" % (
+            self.percentile(0.5), self.percentile(0.9), max(self.samples), len(self.samples))
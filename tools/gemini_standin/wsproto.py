@@ -0,0 +1,175 @@
+"""Minimal RFC 6455 WebSocket framing for the Gemini stand-in and replay tools.
+
+Only what the firmware's WebSocketsClient uses: text, binary, fragmented messages
+(the setup message arrives in 1 KB fragments), ping/pong and close. Standard library
+only, so the tools run on any Python 3.8+ without installing packages.
+"""
+
+import asyncio
+import base64
+import hashlib
+import os
+import ssl
+import struct
+
+GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+OP_CONTINUATION = 0x0
+OP_TEXT = 0x1
+OP_BINARY = 0x2
+OP_CLOSE = 0x8
+OP_PING = 0x9
+OP_PONG = 0xA
+
+
+class ConnectionClosed(Exception):
+    pass
+
+
+def accept_key(key):
+    return base64.b64encode(hashlib.sha1((key + GUID).encode()).digest()).decode()
+
+
+async def read_http_head(reader):
+    """Request or status line plus headers (lower-cased names)."""
+    head = await reader.readuntil(b"\r\n\r\n")
+    lines = head.decode("latin-1").split("\r\n")
+    headers = {}
+    for line in lines[1:]:
+        if ":" in line:
+            name, value = line.split(":", 1)
+            headers[name.strip().lower()] = value.strip()
+    return lines[0], headers
+
+
+class WebSocket:
+    """One open connection. Server sockets send unmasked frames, clients masked ones."""
+
+    def __init__(self, reader, writer, is_client):
+        self.reader = reader
+        self.writer = writer
+        self.is_client = is_client
+        self.closed = False
+
+    async def send(self, payload, opcode=None):
+        if isinstance(payload, str):
+            payload = payload.encode()
+            opcode = OP_TEXT if opcode is None else opcode
+        elif opcode is None:
+            opcode = OP_BINARY
+        await self._send_frame(opcode, payload)
+
+    async def _send_frame(self, opcode, payload):
+        if self.closed:
+            raise ConnectionClosed()
+        header = bytearray([0x80 | opcode])
+        mask_bit = 0x80 if self.is_client else 0
+        length = len(payload)
+        if length < 126:
+            header.append(mask_bit | length)
+        elif length < 65536:
+            header.append(mask_bit | 126)
+            header += struct.pack(">H", length)
+        else:
+            header.append(mask_bit | 127)
+            header += struct.pack(">Q", length)
+        if self.is_client:
+            mask = os.urandom(4)
+            header += mask
+            payload = _apply_mask(payload, mask)
+        self.writer.write(bytes(header) + payload)
+        await self.writer.drain()
+
+    async def _read_frame(self):
+        try:
+            first, second = await self.reader.readexactly(2)
+            length = second & 0x7F
+            if length == 126:
+                length = struct.unpack(">H", await self.reader.readexactly(2))[0]
+            elif length == 127:
+                length = struct.unpack(">Q", await self.reader.readexactly(8))[0]
+            mask = await self.reader.readexactly(4) if second & 0x80 else None
+            payload = await self.reader.readexactly(length)
+        except (asyncio.IncompleteReadError, ConnectionError):
+            self.closed = True
+            raise ConnectionClosed()
+        if mask:
+            payload = _apply_mask(payload, mask)
+        return bool(first & 0x80), first & 0x0F, payload
+
+    async def receive(self):
+        """Next complete message as (opcode, payload); answers pings on the way."""
+        message = bytearray()
+        message_opcode = None
+        while True:
+            fin, opcode, payload = await self._read_frame()
+            if opcode == OP_PING:
+                await self._send_frame(OP_PONG, payload)
+                continue
+            if opcode == OP_PONG:
+                continue
+            if opcode == OP_CLOSE:
+                if not self.closed:
+                    try:
+                        await self._send_frame(OP_CLOSE, payload[:2])
+                    except ConnectionError:
+                        pass
+                self.closed = True
+                raise ConnectionClosed()
+            if opcode != OP_CONTINUATION:
+                message_opcode = opcode
+                message = bytearray()
+            message += payload
+            if fin:
+                return message_opcode, bytes(message)
+
+    async def close(self, code=1000, reason=""):
+        if not self.closed:
+            try:
+                await self._send_frame(OP_CLOSE, struct.pack(">H", code) + reason.encode())
+            except ConnectionError:
+                pass
+            self.closed = True
+        self.writer.close()
+
+
+def _apply_mask(payload, mask):
+    # Whole-buffer XOR through int conversion: fast enough for 100 KB frames
+    repeated = (mask * (len(payload) // 4 + 1))[:len(payload)]
+    return (int.from_bytes(payload, "big") ^ int.from_bytes(repeated, "big")).to_bytes(len(payload), "big")
+
+
+async def server_handshake(reader, writer):
+    """Completes the upgrade; returns (WebSocket, request path) or None for a non-WebSocket request."""
+    request_line, headers = await read_http_head(reader)
+    key = headers.get("sec-websocket-key")
+    if not key or headers.get("upgrade", "").lower() != "websocket":
+        writer.write(b"HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n")
+        await writer.drain()
+        writer.close()
+        return None
+    writer.write(("HTTP/1.1 101 Switching Protocols\r\n"
+                  "Upgrade: websocket\r\n"
+                  "Connection: Upgrade\r\n"
+                  "Sec-WebSocket-Accept: %s\r\n\r\n" % accept_key(key)).encode())
+    await writer.drain()
+    path = request_line.split(" ")[1] if " " in request_line else "/"
+    return WebSocket(reader, writer, is_client=False), path
+
+
+async def connect(host, port, path, use_ssl=False):
+    reader, writer = await asyncio.open_connection(host, port, ssl=ssl.create_default_context() if use_ssl else None,
+                                                   server_hostname=host if use_ssl else None)
+    key = base64.b64encode(os.urandom(16)).decode()
+    writer.write(("GET %s HTTP/1.1\r\n"
+                  "Host: %s:%d\r\n"
+                  "Upgrade: websocket\r\n"
+                  "Connection: Upgrade\r\n"
+                  "Sec-WebSocket-Key: %s\r\n"
+                  "Sec-WebSocket-Version: 13\r\n\r\n" % (path, host, port, key)).encode())
+    await writer.drain()
+    status_line, headers = await read_http_head(reader)
+    if " 101 " not in status_line + " " or headers.get("sec-websocket-accept") != accept_key(key):
+        writer.close()
+        raise ConnectionError("WebSocket upgrade refused: %s" % status_line)
+    return WebSocket(reader, writer, is_client=True)